@@ -0,0 +1,77 @@
+// Outfit Converter Pro - C API example
+// Converts one outfit file and prints the result, using nothing but
+// outfit_converter.h. Built with the core library (-DOUTFIT_CORE_LIBRARY=ON):
+//
+//   convert_outfit <file> <cherax|yimmenu|lexis|stand>
+#include "outfit_converter.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static outfit_format formatFromName(const char* name) {
+    if (strcmp(name, "cherax") == 0) return OUTFIT_FORMAT_CHERAX;
+    if (strcmp(name, "yimmenu") == 0) return OUTFIT_FORMAT_YIMMENU;
+    if (strcmp(name, "lexis") == 0) return OUTFIT_FORMAT_LEXIS;
+    if (strcmp(name, "stand") == 0) return OUTFIT_FORMAT_STAND;
+    return OUTFIT_FORMAT_UNKNOWN;
+}
+
+// Reads the whole file into a malloc'd buffer; NULL on failure.
+static char* readFile(const char* path, size_t* size) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+    
+    char* data = NULL;
+    long length = -1;
+    if (fseek(file, 0, SEEK_END) == 0) length = ftell(file);
+    if (length >= 0 && fseek(file, 0, SEEK_SET) == 0) {
+        data = malloc(length > 0 ? (size_t)length : 1);
+        if (data && fread(data, 1, (size_t)length, file) != (size_t)length) {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(file);
+    *size = (size_t)length;
+    return data;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3 || formatFromName(argv[2]) == OUTFIT_FORMAT_UNKNOWN) {
+        fprintf(stderr, "usage: %s <file> <cherax|yimmenu|lexis|stand>\n", argv[0]);
+        return 2;
+    }
+    if (outfit_api_version() != OUTFIT_API_VERSION) {
+        fprintf(stderr, "error: library API %d, built against %d\n", outfit_api_version(), OUTFIT_API_VERSION);
+        return 1;
+    }
+    
+    size_t inputSize = 0;
+    char* input = readFile(argv[1], &inputSize);
+    if (!input) {
+        fprintf(stderr, "error: could not read %s\n", argv[1]);
+        return 1;
+    }
+    outfit_format to = formatFromName(argv[2]);
+    
+    // Ask for the size first, then convert into a buffer of that size.
+    size_t outputSize = 0;
+    outfit_status status = outfit_convert(input, inputSize, OUTFIT_FORMAT_UNKNOWN, to, NULL, 0, &outputSize);
+    char* output = NULL;
+    if (status == OUTFIT_ERROR_BUFFER_TOO_SMALL) {
+        output = malloc(outputSize);
+        status = output ? outfit_convert(input, inputSize, OUTFIT_FORMAT_UNKNOWN, to, output, outputSize, &outputSize)
+                        : OUTFIT_ERROR_ARGUMENT;
+    }
+    free(input);
+    
+    if (status != OUTFIT_OK) {
+        fprintf(stderr, "error: conversion failed with status %d\n", (int)status);
+        free(output);
+        return 1;
+    }
+    fwrite(output, 1, outputSize, stdout);
+    free(output);
+    return 0;
+}
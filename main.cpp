@@ -1,3 +1,29 @@
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QFile>
+#include <QStandardPaths>
+#include <QDir>
+#include <QTextStream>
+#include <QRegularExpression>
+#include <QTime>
+#include <QDirIterator>
+#include <QDataStream>
+#include <QHash>
+#include <QSet>
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <QPointer>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <QSocketNotifier>
+#include <QSettings>
+#include <QProcess>
+#include <QSysInfo>
+// The widgets are left out of the conversion core library.
+#ifndef OUTFIT_CORE_LIBRARY
 #include <QApplication>
 #include <QMainWindow>
 #include <QWidget>
@@ -8,10 +34,6 @@
 #include <QTextEdit>
 #include <QFileDialog>
 #include <QMessageBox>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonArray>
-#include <QFile>
 #include <QDropEvent>
 #include <QMimeData>
 #include <QDragEnterEvent>
@@ -22,20 +44,79 @@
 #include <QGroupBox>
 #include <QRadioButton>
 #include <QButtonGroup>
-#include <QStandardPaths>
-#include <QDir>
-#include <QProgressDialog>
-#include <QTextStream>
-#include <QRegularExpression>
+#include <QProgressBar>
 #include <QTabWidget>
 #include <QListWidget>
 #include <QSpinBox>
 #include <QLineEdit>
 #include <QFormLayout>
+#include <QGridLayout>
 #include <QScrollArea>
 #include <QSplitter>
 #include <QComboBox>
-#include <QTime>
+#include <QCheckBox>
+#include <QTableView>
+#include <QHeaderView>
+#include <QScrollBar>
+#include <QStyledItemDelegate>
+#include <QColor>
+#include <QShowEvent>
+#include <QShortcut>
+#endif
+#ifdef OUTFIT_CONVERSION_SERVER
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QtEndian>
+#endif
+#ifdef OUTFIT_SQL_LIBRARY
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#endif
+#include <memory>
+#include <functional>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <string_view>
+
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThread>
+#include <QRandomGenerator>
+#include <QQueue>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+#include <cmath>
+#include <charconv>
+
+#ifdef Q_OS_LINUX
+#include <sys/inotify.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OUTFIT_READER_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 // Format enumeration
 enum class OutfitFormat {
@@ -46,6 +127,7 @@ enum class OutfitFormat {
     Stand
 };
 
+#ifndef OUTFIT_CORE_LIBRARY
 // ManualFormatSelector class definition (integrated from format_selector.h)
 class ManualFormatSelector : public QWidget {
     Q_OBJECT
@@ -76,43 +158,6 @@ private:
         mainLayout->setContentsMargins(0, 0, 0, 0);
         
         QGroupBox* modeBox = new QGroupBox("Conversion Selection", this);
-        modeBox->setStyleSheet(
-            "QGroupBox { "
-            "  background: #2a2a2a; "
-            "  border: 2px solid #444; "
-            "  border-radius: 12px; "
-            "  margin-top: 10px; "
-            "  padding-top: 20px; "
-            "  color: #fff; "
-            "  font-size: 14px; "
-            "  font-weight: bold; "
-            "}"
-            "QGroupBox::title { "
-            "  subcontrol-origin: margin; "
-            "  left: 15px; "
-            "  padding: 0 5px; "
-            "}"
-            "QRadioButton { "
-            "  color: #fff; "
-            "  font-size: 13px; "
-            "  font-weight: normal; "
-            "  spacing: 8px; "
-            "}"
-            "QRadioButton::indicator { "
-            "  width: 18px; "
-            "  height: 18px; "
-            "}"
-            "QRadioButton::indicator::unchecked { "
-            "  border: 2px solid #666; "
-            "  border-radius: 9px; "
-            "  background: #1a1a1a; "
-            "}"
-            "QRadioButton::indicator::checked { "
-            "  border: 2px solid #667eea; "
-            "  border-radius: 9px; "
-            "  background: qradialgradient(cx:0.5, cy:0.5, radius:0.5, fx:0.5, fy:0.5, stop:0 #667eea, stop:1 #667eea); "
-            "}"
-        );
         
         QVBoxLayout* modeLayout = new QVBoxLayout(modeBox);
         
@@ -144,21 +189,6 @@ private:
         
         QGroupBox* formatBox = new QGroupBox("Format Selection", this);
         formatBox->setStyleSheet(
-            "QGroupBox { "
-            "  background: #2a2a2a; "
-            "  border: 2px solid #444; "
-            "  border-radius: 12px; "
-            "  margin-top: 10px; "
-            "  padding-top: 20px; "
-            "  color: #fff; "
-            "  font-size: 14px; "
-            "  font-weight: bold; "
-            "}"
-            "QGroupBox::title { "
-            "  subcontrol-origin: margin; "
-            "  left: 15px; "
-            "  padding: 0 5px; "
-            "}"
             "QLabel { "
             "  color: #fff; "
             "  font-size: 13px; "
@@ -244,15 +274,105 @@ private:
     QComboBox* sourceFormatCombo;
     QComboBox* targetFormatCombo;
 };
+#endif
 
-// Conversion Functions
-QJsonObject cheraxToYim(const QJsonObject& cherax) {
-    QJsonObject yim;
-    
-    if (cherax.contains("model")) {
-        yim["model"] = cherax["model"].toInteger();
+// Extension Side-Channel
+// Fields a target format has no place for travel in an "_ext" object, keyed
+// by the format they came from. Converters pass foreign entries through
+// untouched and restore their own, so Cherax -> YimMenu -> Cherax gives back
+// the original palettes, face features, tints and attachments instead of
+// defaults, and a repeated sync produces byte-identical output.
+const QString kExtensionKey = "_ext";
+const QString kCheraxExt = "cherax";
+const QString kYimExt = "yimmenu";
+const QString kLexisExt = "lexis";
+const QString kStandExt = "stand";
+
+QJsonObject unmappedFields(const QJsonObject& obj, const QStringList& mappedKeys) {
+    QJsonObject extra;
+    for (auto it = obj.begin(); it != obj.end(); ++it) {
+        if (!mappedKeys.contains(it.key()) && it.key() != kExtensionKey) {
+            extra[it.key()] = it.value();
+        }
     }
+    return extra;
+}
+
+void restoreFields(QJsonObject& target, const QJsonObject& fields) {
+    for (auto it = fields.begin(); it != fields.end(); ++it) {
+        target[it.key()] = it.value();
+    }
+}
+
+// The source's side-channel entry for one format.
+QJsonObject extensionFor(const QJsonObject& source, const QString& formatKey) {
+    return source.value(kExtensionKey).toObject().value(formatKey).toObject();
+}
+
+// Copies the source's foreign extensions to target, minus the one target
+// restores natively, and adds the source format's own leftovers.
+void attachExtensions(QJsonObject& target, const QJsonObject& source, const QString& consumedKey,
+                      const QString& ownKey, const QJsonObject& own) {
+    QJsonObject ext = source.value(kExtensionKey).toObject();
+    ext.remove(consumedKey);
+    if (!own.isEmpty()) ext[ownKey] = own;
+    if (!ext.isEmpty()) target[kExtensionKey] = ext;
+}
+
+// Unmapped per-slot fields of a named-slot object (Cherax components/props).
+QJsonObject unmappedSlotFields(const QJsonObject& slotObjects, const QStringList& knownSlots,
+                               const QStringList& mappedKeys) {
+    QJsonObject extra;
+    for (auto it = slotObjects.begin(); it != slotObjects.end(); ++it) {
+        QJsonObject fields = knownSlots.contains(it.key())
+                                 ? unmappedFields(it.value().toObject(), mappedKeys)
+                                 : it.value().toObject();
+        if (!fields.isEmpty()) extra[it.key()] = fields;
+    }
+    return extra;
+}
+
+void restoreSlotFields(QJsonObject& slotObjects, const QJsonObject& extra) {
+    for (auto it = extra.begin(); it != extra.end(); ++it) {
+        // A slot removed since (no drawable of its own) stays removed.
+        QJsonObject fields = it.value().toObject();
+        if (!slotObjects.contains(it.key()) && !fields.contains("drawable")) continue;
+        
+        QJsonObject slot = slotObjects.value(it.key()).toObject();
+        restoreFields(slot, fields);
+        slotObjects[it.key()] = slot;
+    }
+}
+
+// YimMenu root fields other formats cannot hold (blend_data and anything
+// unknown); targetKeys names the ones the target does map. Targets that pad
+// missing slots also record which ones to drop.
+QJsonObject yimExtension(const QJsonObject& yim, bool recordAbsentSlots = false,
+                         const QStringList& targetKeys = QStringList()) {
+    QJsonObject own;
+    QJsonObject root = unmappedFields(yim, QStringList{"model", "components", "props"} + targetKeys);
+    if (!root.isEmpty()) own["root"] = root;
     
+    if (recordAbsentSlots) {
+        QJsonObject comps = yim.value("components").toObject();
+        QJsonObject props = yim.value("props").toObject();
+        QJsonArray absentComps;
+        QJsonArray absentProps;
+        for (int i = 0; i < 12; ++i) {
+            if (!comps.contains(QString::number(i))) absentComps.append(i);
+        }
+        for (int i = 0; i < 9; ++i) {
+            if (!props.contains(QString::number(i))) absentProps.append(i);
+        }
+        if (yim.contains("components") && !absentComps.isEmpty()) own["absent_components"] = absentComps;
+        if (yim.contains("props") && !absentProps.isEmpty()) own["absent_props"] = absentProps;
+    }
+    return own;
+}
+
+// Fills in what a YimMenu document converted from another format lacks:
+// the original blend data when the chain started at YimMenu, zeros otherwise.
+void restoreYimExtension(QJsonObject& yim, const QJsonObject& own) {
     QJsonObject blendData;
     blendData["is_parent"] = 0;
     blendData["shape_first_id"] = 0;
@@ -266,6 +386,305 @@ QJsonObject cheraxToYim(const QJsonObject& cherax) {
     blendData["third_mix"] = 0.0;
     yim["blend_data"] = blendData;
     
+    restoreFields(yim, own.value("root").toObject());
+    
+    const QJsonArray absentComps = own.value("absent_components").toArray();
+    const QJsonArray absentProps = own.value("absent_props").toArray();
+    if (absentComps.isEmpty() && absentProps.isEmpty()) return;
+    
+    QJsonObject comps = yim.value("components").toObject();
+    QJsonObject props = yim.value("props").toObject();
+    for (const QJsonValue& slot : absentComps) comps.remove(QString::number(slot.toInt()));
+    for (const QJsonValue& slot : absentProps) props.remove(QString::number(slot.toInt()));
+    yim["components"] = comps;
+    yim["props"] = props;
+}
+
+// Model Registry
+// Ped models every converter agrees on. A model hash is GTA's joaat of the
+// lower-case spawn name, computed here at compile time; the table is sorted
+// by hash and by label at compile time too, so either lookup is a binary
+// search. Models missing from the table travel as their raw hash, and any
+// spawn name hashes correctly whether it is listed or not.
+constexpr quint32 joaat(std::string_view text) {
+    quint32 hash = 0;
+    for (char c : text) {
+        hash += quint8(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+        hash += hash << 10;
+        hash ^= hash >> 6;
+    }
+    hash += hash << 3;
+    hash ^= hash >> 11;
+    hash += hash << 15;
+    return hash;
+}
+
+// Outfit files hold the hash as a signed 32-bit number.
+constexpr qint64 modelHash(std::string_view name) {
+    return static_cast<qint32>(joaat(name));
+}
+
+constexpr qint64 kFreemodeMaleModel = 1885233650;
+constexpr qint64 kFreemodeFemaleModel = -1667301416;
+static_assert(modelHash("mp_m_freemode_01") == kFreemodeMaleModel, "joaat mismatch");
+static_assert(modelHash("mp_f_freemode_01") == kFreemodeFemaleModel, "joaat mismatch");
+
+struct PedModel {
+    qint64 hash = 0;
+    const char* name = nullptr;   // spawn name
+    const char* label = nullptr;  // what Stand files and the UI show
+};
+
+constexpr PedModel kPedModels[] = {
+    {modelHash("mp_m_freemode_01"), "mp_m_freemode_01", "Online Male"},
+    {modelHash("mp_f_freemode_01"), "mp_f_freemode_01", "Online Female"},
+    {modelHash("player_zero"), "player_zero", "Michael"},
+    {modelHash("player_one"), "player_one", "Franklin"},
+    {modelHash("player_two"), "player_two", "Trevor"},
+    {modelHash("ig_lamardavis"), "ig_lamardavis", "Lamar"},
+    {modelHash("ig_lestercrest"), "ig_lestercrest", "Lester"},
+    {modelHash("ig_orleans"), "ig_orleans", "Bigfoot"},
+    {modelHash("u_m_y_imporage"), "u_m_y_imporage", "Impotent Rage"},
+    {modelHash("u_m_y_zombie_01"), "u_m_y_zombie_01", "Zombie"},
+    {modelHash("u_m_m_jesus_01"), "u_m_m_jesus_01", "Jesus"},
+    {modelHash("s_m_m_movalien_01"), "s_m_m_movalien_01", "Alien"},
+    {modelHash("s_m_y_clown_01"), "s_m_y_clown_01", "Clown"},
+    {modelHash("s_m_y_cop_01"), "s_m_y_cop_01", "Cop Male"},
+    {modelHash("s_f_y_cop_01"), "s_f_y_cop_01", "Cop Female"},
+    {modelHash("s_m_y_swat_01"), "s_m_y_swat_01", "SWAT"},
+    {modelHash("s_m_y_marine_01"), "s_m_y_marine_01", "Marine"},
+    {modelHash("s_m_y_blackops_01"), "s_m_y_blackops_01", "Black Ops"},
+    {modelHash("s_m_y_fireman_01"), "s_m_y_fireman_01", "Firefighter"},
+    {modelHash("s_m_m_paramedic_01"), "s_m_m_paramedic_01", "Paramedic"},
+    {modelHash("a_m_y_hipster_01"), "a_m_y_hipster_01", "Hipster Male"},
+    {modelHash("a_f_y_hipster_01"), "a_f_y_hipster_01", "Hipster Female"},
+    {modelHash("a_m_y_beach_01"), "a_m_y_beach_01", "Beach Male"},
+    {modelHash("a_f_y_beach_01"), "a_f_y_beach_01", "Beach Female"},
+    {modelHash("a_m_m_tramp_01"), "a_m_m_tramp_01", "Tramp"},
+    {modelHash("g_m_y_ballaorig_01"), "g_m_y_ballaorig_01", "Ballas"},
+    {modelHash("g_m_y_famca_01"), "g_m_y_famca_01", "Families"},
+    {modelHash("a_c_chimp"), "a_c_chimp", "Chimp"},
+    {modelHash("a_c_chop"), "a_c_chop", "Chop"},
+    {modelHash("a_c_husky"), "a_c_husky", "Husky"},
+    {modelHash("a_c_rottweiler"), "a_c_rottweiler", "Rottweiler"},
+    {modelHash("a_c_cat_01"), "a_c_cat_01", "Cat"},
+    {modelHash("a_c_mtlion"), "a_c_mtlion", "Mountain Lion"},
+    {modelHash("a_c_coyote"), "a_c_coyote", "Coyote"},
+    {modelHash("a_c_deer"), "a_c_deer", "Deer"},
+    {modelHash("a_c_boar"), "a_c_boar", "Boar"}};
+constexpr size_t kPedModelCount = sizeof(kPedModels) / sizeof(kPedModels[0]);
+
+constexpr char lowerAscii(char c) {
+    return c >= 'A' && c <= 'Z' ? char(c - 'A' + 'a') : c;
+}
+
+// Case-insensitive strcmp() < 0 for ASCII labels.
+constexpr bool pedLabelLess(const char* a, const char* b) {
+    for (; *a && lowerAscii(*a) == lowerAscii(*b); ++a, ++b) {}
+    return lowerAscii(*a) < lowerAscii(*b);
+}
+
+template<typename Less>
+constexpr std::array<PedModel, kPedModelCount> sortedPedModels(Less less) {
+    std::array<PedModel, kPedModelCount> result{};
+    for (size_t i = 0; i < kPedModelCount; ++i) {
+        size_t j = i;
+        for (; j > 0 && less(kPedModels[i], result[j - 1]); --j) result[j] = result[j - 1];
+        result[j] = kPedModels[i];
+    }
+    return result;
+}
+
+constexpr std::array<PedModel, kPedModelCount> kPedModelsByHash =
+    sortedPedModels([](const PedModel& a, const PedModel& b) { return a.hash < b.hash; });
+constexpr std::array<PedModel, kPedModelCount> kPedModelsByLabel =
+    sortedPedModels([](const PedModel& a, const PedModel& b) { return pedLabelLess(a.label, b.label); });
+
+constexpr bool pedModelsUnique() {
+    for (size_t i = 1; i < kPedModelCount; ++i) {
+        if (kPedModelsByHash[i - 1].hash == kPedModelsByHash[i].hash) return false;
+        if (!pedLabelLess(kPedModelsByLabel[i - 1].label, kPedModelsByLabel[i].label)) return false;
+    }
+    return true;
+}
+static_assert(pedModelsUnique(), "every ped model needs its own hash and label");
+
+class ModelRegistry {
+public:
+    static const PedModel* find(qint64 hash) {
+        auto it = std::lower_bound(kPedModelsByHash.begin(), kPedModelsByHash.end(), hash,
+                                   [](const PedModel& model, qint64 value) { return model.hash < value; });
+        return it != kPedModelsByHash.end() && it->hash == hash ? &*it : nullptr;
+    }
+    
+    // Case-insensitive.
+    static const PedModel* findByLabel(QStringView label) {
+        QByteArray key = label.toString().toLower().toLatin1();
+        auto it = std::lower_bound(kPedModelsByLabel.begin(), kPedModelsByLabel.end(), key.constData(),
+                                   [](const PedModel& model, const char* value) { return pedLabelLess(model.label, value); });
+        return it != kPedModelsByLabel.end() && !pedLabelLess(key.constData(), it->label) ? &*it : nullptr;
+    }
+    
+    // "Online Male", another ped's label, or the raw hash in decimal.
+    static QString label(qint64 hash) {
+        const PedModel* model = find(hash);
+        return model ? QString::fromLatin1(model->label) : QString::number(hash);
+    }
+    
+    // Reads what label() writes, plus decimal or 0x hashes, spawn names and
+    // a bare "male"/"female" for freemode. Any other text is left to the
+    // caller rather than guessed at, so "Stripper Female" never becomes a
+    // freemode ped.
+    static bool parse(QStringView text, qint64& hash) {
+        text = text.trimmed();
+        if (text.isEmpty()) return false;
+        
+        if (const PedModel* model = findByLabel(text)) {
+            hash = model->hash;
+            return true;
+        }
+        
+        bool ok = false;
+        qint64 number = text.startsWith(u"0x", Qt::CaseInsensitive) ? text.mid(2).toLongLong(&ok, 16)
+                                                                   : text.toLongLong(&ok);
+        if (ok && number >= std::numeric_limits<qint32>::min() && number <= std::numeric_limits<quint32>::max()) {
+            hash = static_cast<qint32>(static_cast<quint32>(number));
+            return true;
+        }
+        
+        QString lower = text.toString().toLower();
+        bool spawnName = lower.contains('_');
+        for (QChar c : lower) {
+            if (c.unicode() >= 128 || !(c.isLetterOrNumber() || c == '_')) spawnName = false;
+        }
+        if (spawnName) {
+            QByteArray name = lower.toLatin1();
+            hash = modelHash(std::string_view(name.constData(), size_t(name.size())));
+            return true;
+        }
+        
+        if (lower == u"female") {
+            hash = kFreemodeFemaleModel;
+            return true;
+        }
+        if (lower == u"male") {
+            hash = kFreemodeMaleModel;
+            return true;
+        }
+        return false;
+    }
+};
+
+// Face Data
+// Heritage and face features as the game keeps them: blend ids and mixes,
+// and twenty feature floats in the game's own index order. YimMenu holds
+// heritage in "blend_data"; Cherax holds only the features, keyed by name.
+//
+// YimMenu's outfit files have no field for face features. The root
+// "face_features" array is this app's own extension: YimMenu ignores it
+// when loading, it survives YimMenu -> Cherax -> YimMenu, and it is a
+// fixed twenty-float array rather than Cherax's twenty named members. Only
+// this app reads or writes it. A face with every feature at zero is the
+// game's default, so it is never written out at all.
+constexpr int kFaceFeatureCount = 20;
+const char* const kFaceFeatureNames[kFaceFeatureCount] = {
+    "Nose Width", "Nose Peak", "Nose Length", "Nose Bone Curveness", "Nose Tip", "Nose Bone Twist",
+    "Eyebrow Height", "Eyebrow Indent", "Cheek Bones", "Cheek Sideways Bone Size", "Cheek Bones Width",
+    "Eye Opening", "Lip Thickness", "Jaw Bone Width", "Jaw Bone Shape", "Chin Bone", "Chin Bone Length",
+    "Chin Bone Shape", "Chin Hole", "Neck Thickness"};
+
+struct FaceData {
+    qint32 shapeIds[3] = {};    // first, second, third parent
+    qint32 skinIds[3] = {};
+    float shapeMix = 0.0f;
+    float skinMix = 0.0f;
+    float thirdMix = 0.0f;
+    bool isParent = false;
+    bool hasBlend = false;      // blend_data was an object
+    float features[kFaceFeatureCount] = {};
+    bool hasFeatures = false;   // face_features held all twenty values
+    
+    bool operator==(const FaceData& other) const {
+        if (std::memcmp(shapeIds, other.shapeIds, sizeof(shapeIds)) != 0 ||
+            std::memcmp(skinIds, other.skinIds, sizeof(skinIds)) != 0 ||
+            shapeMix != other.shapeMix || skinMix != other.skinMix || thirdMix != other.thirdMix ||
+            isParent != other.isParent || hasBlend != other.hasBlend || hasFeatures != other.hasFeatures) {
+            return false;
+        }
+        for (int i = 0; i < kFaceFeatureCount; ++i) {
+            if (features[i] != other.features[i]) return false;
+        }
+        return true;
+    }
+};
+
+bool isDefaultFace(const float* features) {
+    for (int i = 0; i < kFaceFeatureCount; ++i) {
+        if (features[i] != 0.0f) return false;
+    }
+    return true;
+}
+
+// The shortest decimal that reads back as the same float, so a feature of
+// 0.1 is written as 0.1 and not as 0.10000000149011612.
+double faceFeatureValue(float feature) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), feature);
+    return QByteArray::fromRawData(buffer, result.ptr - buffer).toDouble();
+}
+
+// A feature value as the game stores it; false for numbers a float cannot hold
+// exactly as written (0.123456789 would come back as 0.12345679), which callers
+// then carry through unchanged instead of mapping.
+bool toFaceFeature(double value, float& feature) {
+    feature = static_cast<float>(value);
+    return std::isfinite(feature) && faceFeatureValue(feature) == value;
+}
+
+// The app-private YimMenu "face_features" (see Face Data): exactly
+// kFaceFeatureCount numbers, or nothing.
+bool yimFaceFeatures(const QJsonValue& value, float* features) {
+    const QJsonArray array = value.toArray();
+    if (!value.isArray() || array.size() != kFaceFeatureCount) return false;
+    for (int i = 0; i < kFaceFeatureCount; ++i) {
+        if (!array[i].isDouble() || !toFaceFeature(array[i].toDouble(), features[i])) return false;
+    }
+    return true;
+}
+
+// Cherax "face_features": every named feature as a number and nothing else.
+bool cheraxFaceFeatures(const QJsonValue& value, float* features) {
+    const QJsonObject object = value.toObject();
+    if (!value.isObject() || object.size() != kFaceFeatureCount) return false;
+    for (int i = 0; i < kFaceFeatureCount; ++i) {
+        QJsonValue feature = object.value(QLatin1String(kFaceFeatureNames[i]));
+        if (!feature.isDouble() || !toFaceFeature(feature.toDouble(), features[i])) return false;
+    }
+    return true;
+}
+
+QJsonArray yimFaceFeatureArray(const float* features) {
+    QJsonArray array;
+    for (int i = 0; i < kFaceFeatureCount; ++i) array.append(faceFeatureValue(features[i]));
+    return array;
+}
+
+QJsonObject cheraxFaceFeatureObject(const float* features) {
+    QJsonObject object;
+    for (int i = 0; i < kFaceFeatureCount; ++i) {
+        object[QLatin1String(kFaceFeatureNames[i])] = faceFeatureValue(features[i]);
+    }
+    return object;
+}
+
+// Conversion Functions
+QJsonObject cheraxToYim(const QJsonObject& cherax) {
+    QJsonObject yim;
+    
+    if (cherax.contains("model")) {
+        yim["model"] = cherax["model"].toInteger();
+    }
+    
     QMap<QString, int> componentMap = {
         {"Head", 0}, {"Beard", 1}, {"Hair", 2}, {"Torso", 3},
         {"Legs", 4}, {"Hands", 5}, {"Feet", 6}, {"Teeth", 7},
@@ -308,6 +727,28 @@ QJsonObject cheraxToYim(const QJsonObject& cherax) {
     }
     yim["props"] = props;
     
+    restoreYimExtension(yim, extensionFor(cherax, kYimExt));
+    
+    // Into the app-private "face_features" array; YimMenu itself has no face
+    // field. A face of the game's default stays with the Cherax leftovers.
+    QStringList mappedRoot = {"format", "model", "components", "props"};
+    float features[kFaceFeatureCount];
+    if (cheraxFaceFeatures(cherax.value("face_features"), features) && !isDefaultFace(features)) {
+        yim["face_features"] = yimFaceFeatureArray(features);
+        mappedRoot.append("face_features");
+    }
+    
+    QJsonObject own;
+    QJsonObject root = unmappedFields(cherax, mappedRoot);
+    QJsonObject compExtra = unmappedSlotFields(cherax.value("components").toObject(),
+                                               componentMap.keys(), {"drawable", "texture"});
+    QJsonObject propExtra = unmappedSlotFields(cherax.value("props").toObject(),
+                                               propsMap.keys(), {"drawable", "texture"});
+    if (!root.isEmpty()) own["root"] = root;
+    if (!compExtra.isEmpty()) own["components"] = compExtra;
+    if (!propExtra.isEmpty()) own["props"] = propExtra;
+    attachExtensions(yim, cherax, kYimExt, kCheraxExt, own);
+    
     return yim;
 }
 
@@ -368,22 +809,27 @@ QJsonObject yimToCherax(const QJsonObject& yim) {
     }
     cherax["props"] = props;
     
-    QJsonObject faceFeatures;
-    QStringList features = {"Nose Width", "Nose Peak", "Nose Length", "Nose Bone Curveness",
-                           "Nose Tip", "Nose Bone Twist", "Eyebrow Height", "Eyebrow Indent",
-                           "Cheek Bones", "Cheek Sideways Bone Size", "Cheek Bones Width",
-                           "Eye Opening", "Lip Thickness", "Jaw Bone Width", "Jaw Bone Shape",
-                           "Chin Bone", "Chin Bone Length", "Chin Bone Shape", "Chin Hole",
-                           "Neck Thickness"};
-    for (const QString& feature : features) {
-        faceFeatures[feature] = 0.0;
-    }
-    cherax["face_features"] = faceFeatures;
+    float features[kFaceFeatureCount] = {};
+    bool faceMapped = yimFaceFeatures(yim.value("face_features"), features) && !isDefaultFace(features);
+    if (!faceMapped) std::fill(features, features + kFaceFeatureCount, 0.0f);
+    cherax["face_features"] = cheraxFaceFeatureObject(features);
     
     cherax["primary_hair_tint"] = 255;
     cherax["secondary_hair_tint"] = 255;
     cherax["attachments"] = QJsonArray();
     
+    // Originals from an earlier Cherax source replace the defaults above.
+    QJsonObject own = extensionFor(yim, kCheraxExt);
+    restoreFields(cherax, own.value("root").toObject());
+    restoreSlotFields(components, own.value("components").toObject());
+    restoreSlotFields(props, own.value("props").toObject());
+    cherax["components"] = components;
+    cherax["props"] = props;
+    if (faceMapped) cherax["face_features"] = cheraxFaceFeatureObject(features);
+    
+    attachExtensions(cherax, yim, kCheraxExt, kYimExt,
+                     yimExtension(yim, false, faceMapped ? QStringList{"face_features"} : QStringList()));
+    
     return cherax;
 }
 
@@ -437,7 +883,12 @@ QJsonObject yimToLexis(const QJsonObject& yim) {
     outfit["prop"] = propArray;
     outfit["prop variation"] = propVarArray;
     
+    QJsonObject own = extensionFor(yim, kLexisExt);
+    restoreFields(outfit, own.value("outfit").toObject());
+    restoreFields(lexis, own.value("root").toObject());
+    
     lexis["outfit"] = outfit;
+    attachExtensions(lexis, yim, kLexisExt, kYimExt, yimExtension(yim, true));
     return lexis;
 }
 
@@ -445,8 +896,16 @@ QString yimToStand(const QJsonObject& yim) {
     QString standText;
     QTextStream stream(&standText);
     
+    // Stand's plain text has nowhere to carry the other formats' extensions;
+    // only lines from an earlier Stand source come back, after the slots.
+    const QJsonArray lines = extensionFor(yim, kStandExt).value("lines").toArray();
+    bool keptModelLine = false;
+    for (const QJsonValue& line : lines) {
+        keptModelLine |= !yim.contains("model") && line.toString().startsWith("Model:");
+    }
+    
     qint64 model = yim.value("model").toInteger();
-    stream << "Model: " << (model == 1885233650 ? "Online Male" : "Online Female") << "\n";
+    if (!keptModelLine) stream << "Model: " << ModelRegistry::label(model) << "\n";
     
     QMap<int, QString> componentNames = {
         {0, "Head"}, {1, "Mask"}, {2, "Hair"}, {3, "Top"},
@@ -484,6 +943,10 @@ QString yimToStand(const QJsonObject& yim) {
         }
     }
     
+    for (const QJsonValue& line : lines) {
+        stream << line.toString() << "\n";
+    }
+    
     return standText;
 }
 
@@ -497,19 +960,6 @@ QJsonObject lexisToYim(const QJsonObject& lexis) {
             yim["model"] = outfit["model"].toInteger();
         }
         
-        QJsonObject blendData;
-        blendData["is_parent"] = 0;
-        blendData["shape_first_id"] = 0;
-        blendData["shape_mix"] = 0.0;
-        blendData["shape_second_id"] = 0;
-        blendData["shape_third_id"] = 0;
-        blendData["skin_first_id"] = 0;
-        blendData["skin_mix"] = 0.0;
-        blendData["skin_second_id"] = 0;
-        blendData["skin_third_id"] = 0;
-        blendData["third_mix"] = 0.0;
-        yim["blend_data"] = blendData;
-        
         QJsonObject components;
         if (outfit.contains("component")) {
             QJsonArray compArray = outfit["component"].toArray();
@@ -539,23 +989,23 @@ QJsonObject lexisToYim(const QJsonObject& lexis) {
         yim["props"] = props;
     }
     
+    restoreYimExtension(yim, extensionFor(lexis, kYimExt));
+    
+    QJsonObject own;
+    QJsonObject root = unmappedFields(lexis, {"outfit"});
+    QJsonObject outfitExtra = unmappedFields(lexis.value("outfit").toObject(),
+        {"model", "component", "component variation", "prop", "prop variation"});
+    if (!root.isEmpty()) own["root"] = root;
+    if (!outfitExtra.isEmpty()) own["outfit"] = outfitExtra;
+    attachExtensions(yim, lexis, kYimExt, kLexisExt, own);
+    
     return yim;
 }
 
 QString standToYim(const QString& standText) {
     QJsonObject yim;
-    QJsonObject blendData;
-    blendData["is_parent"] = 0;
-    blendData["shape_first_id"] = 0;
-    blendData["shape_mix"] = 0.0;
-    blendData["shape_second_id"] = 0;
-    blendData["shape_third_id"] = 0;
-    blendData["skin_first_id"] = 0;
-    blendData["skin_mix"] = 0.0;
-    blendData["skin_second_id"] = 0;
-    blendData["skin_third_id"] = 0;
-    blendData["third_mix"] = 0.0;
-    yim["blend_data"] = blendData;
+    restoreYimExtension(yim, QJsonObject());
+    QJsonArray unknownLines;
     
     QMap<QString, int> standMapping = {
         {"Head:", 0}, {"Mask:", 1}, {"Hair:", 2}, {"Top:", 3},
@@ -575,10 +1025,13 @@ QString standToYim(const QString& standText) {
     QStringList lines = standText.split('\n');
     for (const QString& line : lines) {
         QString trimmed = line.trimmed();
+        bool known = trimmed.isEmpty() || trimmed.startsWith("Model:") || trimmed.contains(" Variation:");
         
         if (trimmed.startsWith("Model:")) {
-            QString model = trimmed.mid(6).trimmed();
-            yim["model"] = (model.contains("Male") && !model.contains("Female")) ? 1885233650 : -1667301416;
+            // A model this app cannot name is kept as the line it was.
+            qint64 model = 0;
+            if (ModelRegistry::parse(QStringView(trimmed).mid(6), model)) yim["model"] = model;
+            else known = false;
         }
         
         for (auto it = standMapping.begin(); it != standMapping.end(); ++it) {
@@ -601,6 +1054,7 @@ varKey.replace(":", " Variation:");
                 comp["drawable_id"] = value;
                 comp["texture_id"] = varValue;
                 components[QString::number(it.value())] = comp;
+                known = true;
                 break;
             }
         }
@@ -625,1001 +1079,9113 @@ varKey.replace(":", " Variation:");
                 prop["drawable_id"] = value;
                 prop["texture_id"] = varValue;
                 props[QString::number(it.value())] = prop;
+                known = true;
                 break;
             }
         }
+        
+        if (!known) unknownLines.append(trimmed);
     }
     
     yim["components"] = components;
     yim["props"] = props;
     
+    QJsonObject own;
+    if (!unknownLines.isEmpty()) own["lines"] = unknownLines;
+    attachExtensions(yim, QJsonObject(), kYimExt, kStandExt, own);
+    
     QJsonDocument doc(yim);
     return QString(doc.toJson(QJsonDocument::Indented));
 }
 
-OutfitFormat detectFormat(const QString& filePath) {
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly)) {
-        return OutfitFormat::Unknown;
+// Outfit Data
+// Typed view of an outfit: model, fixed component and prop slot arrays, and
+// the face.
+constexpr int kComponentSlotCount = 12;
+constexpr int kPropSlotCount = 9;
+const QStringList kComponentSlotNames = {"Head", "Mask/Beard", "Hair", "Top", "Pants", "Gloves",
+                                         "Shoes", "Accessories", "Undershirt", "Armor", "Decals", "Torso Extra"};
+const QStringList kPropSlotNames = {"Hat", "Glasses", "Earwear", "Mouth", "Left Hand",
+                                    "Right Hand", "Watch", "Bracelet", "Hip"};
+
+struct OutfitSlot {
+    qint32 drawable = -1;
+    qint32 texture = -1;
+};
+
+struct OutfitData {
+    qint64 model = 0;
+    bool hasModel = false;
+    OutfitSlot components[kComponentSlotCount];
+    OutfitSlot props[kPropSlotCount];
+    quint32 componentMask = 0;  // bit i set when component i is present
+    quint32 propMask = 0;       // bit i set when prop i is present
+    FaceData face;
+    
+    bool hasSlot(bool isProp, int slot) const {
+        return ((isProp ? propMask : componentMask) >> slot) & 1u;
     }
     
-    QByteArray data = file.readAll();
-    file.close();
+    const OutfitSlot& slot(bool isProp, int slot) const {
+        return isProp ? props[slot] : components[slot];
+    }
     
-    if (filePath.endsWith(".txt", Qt::CaseInsensitive)) {
-        QString content = QString::fromUtf8(data);
-        if (content.contains("Model:") && content.contains("Variation:")) {
-            return OutfitFormat::Stand;
+    bool operator==(const OutfitData& other) const {
+        if (model != other.model || hasModel != other.hasModel ||
+            componentMask != other.componentMask || propMask != other.propMask || !(face == other.face)) {
+            return false;
         }
-        return OutfitFormat::Unknown;
+        for (int i = 0; i < kComponentSlotCount; ++i) {
+            if (components[i].drawable != other.components[i].drawable ||
+                components[i].texture != other.components[i].texture) return false;
+        }
+        for (int i = 0; i < kPropSlotCount; ++i) {
+            if (props[i].drawable != other.props[i].drawable ||
+                props[i].texture != other.props[i].texture) return false;
+        }
+        return true;
     }
+};
+
+OutfitData outfitDataFromYim(const QJsonObject& yim) {
+    OutfitData data;
     
-    QJsonParseError error;
-    QJsonDocument doc = QJsonDocument::fromJson(data, &error);
+    if (yim.contains("model")) {
+        data.model = yim["model"].toInteger();
+        data.hasModel = true;
+    }
     
-    if (error.error != QJsonParseError::NoError) {
-        return OutfitFormat::Unknown;
+    QJsonObject comps = yim.value("components").toObject();
+    for (auto it = comps.constBegin(); it != comps.constEnd(); ++it) {
+        bool ok = false;
+        int id = it.key().toInt(&ok);
+        if (!ok || id < 0 || id >= kComponentSlotCount) continue;
+        
+        QJsonObject comp = it.value().toObject();
+        data.components[id].drawable = comp.value("drawable_id").toInt();
+        data.components[id].texture = comp.value("texture_id").toInt();
+        data.componentMask |= 1u << id;
     }
     
-    QJsonObject obj = doc.object();
+    QJsonObject props = yim.value("props").toObject();
+    for (auto it = props.constBegin(); it != props.constEnd(); ++it) {
+        bool ok = false;
+        int id = it.key().toInt(&ok);
+        if (!ok || id < 0 || id >= kPropSlotCount) continue;
+        
+        QJsonObject prop = it.value().toObject();
+        data.props[id].drawable = prop.value("drawable_id").toInt();
+        data.props[id].texture = prop.value("texture_id").toInt();
+        data.propMask |= 1u << id;
+    }
     
-    if (obj.contains("format") && obj["format"].toString() == "Cherax Entity") {
-        return OutfitFormat::Cherax;
+    const QJsonValue blendValue = yim.value("blend_data");
+    if (blendValue.isObject()) {
+        const QJsonObject blend = blendValue.toObject();
+        FaceData& face = data.face;
+        face.hasBlend = true;
+        face.isParent = blend.value("is_parent").toInt() != 0;
+        face.shapeIds[0] = blend.value("shape_first_id").toInt();
+        face.shapeIds[1] = blend.value("shape_second_id").toInt();
+        face.shapeIds[2] = blend.value("shape_third_id").toInt();
+        face.skinIds[0] = blend.value("skin_first_id").toInt();
+        face.skinIds[1] = blend.value("skin_second_id").toInt();
+        face.skinIds[2] = blend.value("skin_third_id").toInt();
+        face.shapeMix = static_cast<float>(blend.value("shape_mix").toDouble());
+        face.skinMix = static_cast<float>(blend.value("skin_mix").toDouble());
+        face.thirdMix = static_cast<float>(blend.value("third_mix").toDouble());
     }
     
-    if (obj.contains("outfit")) {
-        QJsonObject outfit = obj["outfit"].toObject();
-        if (outfit.contains("component") && outfit.contains("component variation")) {
-            return OutfitFormat::Lexis;
+    data.face.hasFeatures = yimFaceFeatures(yim.value("face_features"), data.face.features);
+    if (!data.face.hasFeatures) std::fill(data.face.features, data.face.features + kFaceFeatureCount, 0.0f);
+    
+    return data;
+}
+
+// Conversion Arena
+// Scratch memory for one conversion at a time. Decoder temporaries are bumped
+// out of a block the worker owns and dropped together by reset() between
+// files. A file that outgrows the block spills to the heap once; the block
+// then grows to match, so a steady batch stops touching the global heap.
+class ConversionArena {
+public:
+    explicit ConversionArena(std::size_t initialBytes = 16 * 1024) : block(initialBytes) {
+        arena.emplace(block.data(), block.size(), &upstream);
+    }
+    
+    ConversionArena(const ConversionArena&) = delete;
+    ConversionArena& operator=(const ConversionArena&) = delete;
+    
+    std::pmr::memory_resource* resource() { return &*arena; }
+    
+    void reset() {
+        std::size_t spilled = upstream.bytes;
+        upstream.bytes = 0;
+        arena.reset();
+        if (spilled > 0 && block.size() < kMaxBlockBytes) {
+            block.resize(qMin(block.size() + spilled, kMaxBlockBytes));
         }
+        arena.emplace(block.data(), block.size(), &upstream);
     }
     
-    if (obj.contains("blend_data") && obj.contains("components")) {
-        QJsonObject components = obj["components"].toObject();
-        if (!components.isEmpty()) {
-            QString firstKey = components.keys().first();
-            bool isNumeric = false;
-            firstKey.toInt(&isNumeric);
-            if (isNumeric) {
-                return OutfitFormat::YimMenu;
-            }
+    // Heap allocations the arena could not absorb since it was created.
+    qint64 spills() const { return upstream.allocations; }
+    
+private:
+    // Counts what the arena has to fetch from the heap.
+    class SpillCounter : public std::pmr::memory_resource {
+    public:
+        qint64 allocations = 0;
+        std::size_t bytes = 0;
+        
+    private:
+        void* do_allocate(std::size_t size, std::size_t alignment) override {
+            allocations++;
+            bytes += size;
+            return std::pmr::new_delete_resource()->allocate(size, alignment);
+        }
+        void do_deallocate(void* p, std::size_t size, std::size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(p, size, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+    
+    static constexpr std::size_t kMaxBlockBytes = 4 * 1024 * 1024;
+    
+    std::vector<char> block;
+    SpillCounter upstream;
+    std::optional<std::pmr::monotonic_buffer_resource> arena;
+};
+
+// Fast Outfit Reader
+// Pull parser over raw UTF-8 for the fixed outfit schemas. Keys are compared
+// in place, unknown subtrees are validated and skipped without building
+// anything, and nothing is allocated per key or value. String bodies are
+// scanned 16 bytes at a time with SSE2 where available. Input it cannot
+// treat exactly like QJsonDocument would (escaped keys, non-object roots,
+// invalid JSON) is reported as a failure so callers fall back to the DOM.
+struct JsonKey {
+    const char* data = nullptr;
+    qsizetype size = 0;
+    
+    template <qsizetype N>
+    bool is(const char (&literal)[N]) const {
+        return size == N - 1 && std::memcmp(data, literal, N - 1) == 0;
+    }
+    
+    // Same rules as QString::toInt() for the keys outfits use.
+    bool toInt(int& value) const {
+        qsizetype i = 0;
+        bool negative = false;
+        if (i < size && (data[i] == '-' || data[i] == '+')) negative = data[i++] == '-';
+        if (i == size) return false;
+        
+        qint64 result = 0;
+        for (; i < size; ++i) {
+            if (data[i] < '0' || data[i] > '9') return false;
+            result = result * 10 + (data[i] - '0');
+            if (result > std::numeric_limits<int>::max() + qint64(1)) return false;
         }
+        result = negative ? -result : result;
+        if (result > std::numeric_limits<int>::max()) return false;
+        value = static_cast<int>(result);
+        return true;
     }
     
-    return OutfitFormat::Unknown;
-}
+    // Byte order, which matches QJsonObject's key order for these keys.
+    bool operator<(const JsonKey& other) const {
+        int cmp = std::memcmp(data, other.data, qMin(size, other.size));
+        return cmp < 0 || (cmp == 0 && size < other.size);
+    }
+};
 
-class DropZone : public QWidget {
-    Q_OBJECT
+class OutfitJsonReader {
 public:
-    explicit DropZone(QWidget* parent = nullptr) : QWidget(parent), batchMode(false) {
-        setAcceptDrops(true);
-        setMinimumHeight(200);
-        
-        QVBoxLayout* layout = new QVBoxLayout(this);
-        layout->setAlignment(Qt::AlignCenter);
-        
-        iconLabel = new QLabel("📁", this);
-        iconLabel->setAlignment(Qt::AlignCenter);
-        iconLabel->setStyleSheet("font-size: 48px;");
-        
-        textLabel = new QLabel("Drop file(s) here or click to browse\nSupports: .json (Cherax/YimMenu/Lexis) and .txt (Stand)", this);
-        textLabel->setAlignment(Qt::AlignCenter);
-        textLabel->setStyleSheet("color: #888; font-size: 13px;");
-        
-        layout->addWidget(iconLabel);
-        layout->addWidget(textLabel);
-        
-        updateStyle(false);
+    OutfitJsonReader(const char* begin, const char* end) : p(begin), end(end) {}
+    
+    bool failed() const { return error; }
+    
+    // True when only whitespace is left.
+    bool atEnd() {
+        skipWhitespace();
+        return p == end;
     }
     
-    void setBatchMode(bool batch) {
-        batchMode = batch;
-        if (batch) {
-            iconLabel->setText("📂");
-            textLabel->setText("Drop multiple files here or click to browse\nBatch conversion enabled");
-        } else {
-            iconLabel->setText("📁");
-            textLabel->setText("Drop file(s) here or click to browse\nSupports: .json (Cherax/YimMenu/Lexis) and .txt (Stand)");
-        }
+    bool peekObject() {
+        skipWhitespace();
+        return p < end && *p == '{';
     }
     
-signals:
-    void filesDropped(const QStringList& filePaths);
+    // Start of the next value; together with position() after reading it,
+    // this delimits the value's raw text.
+    const char* valueStart() {
+        skipWhitespace();
+        return p;
+    }
     
-protected:
-    void dragEnterEvent(QDragEnterEvent* event) override {
-        if (event->mimeData()->hasUrls()) {
-            event->acceptProposedAction();updateStyle(true);
+    const char* position() const { return p; }
+    
+    bool peekArray() {
+        skipWhitespace();
+        return p < end && *p == '[';
+    }
+    
+    bool enterObject() { return enter('{'); }
+    bool enterArray() { return enter('['); }
+    
+    // Advances to the next member of the current object and reads its key;
+    // false (consuming the '}') once the object is done.
+    bool nextMember(JsonKey& key) {
+        if (!nextItem('}')) return false;
+        if (p >= end || *p != '"') return fail();
+        if (!readKey(key)) return false;
+        
+        skipWhitespace();
+        if (p >= end || *p != ':') return fail();
+        ++p;
+        return true;
+    }
+    
+    // Like nextMember(), but takes any valid key as written, escapes included.
+    bool nextRawMember(JsonKey& key) {
+        if (!nextItem('}')) return false;
+        if (p >= end || *p != '"') return fail();
+        const char* start = p + 1;
+        if (!skipString()) return fail();
+        key.data = start;
+        key.size = p - 1 - start;
+        
+        skipWhitespace();
+        if (p >= end || *p != ':') return fail();
+        ++p;
+        return true;
+    }
+    
+    // Advances to the next element of the current array; false (consuming
+    // the ']') once the array is done.
+    bool nextElement() {
+        return nextItem(']');
+    }
+    
+    // QJsonValue::toInteger() of the next value.
+    qint64 readInteger() {
+        Number number;
+        if (!readNumber(number)) return 0;
+        if (number.isInteger) return number.integer;
+        
+        double truncated = std::trunc(number.real);
+        if (truncated != number.real || truncated < -9223372036854775808.0 || truncated >= 9223372036854775808.0) {
+            return 0;
         }
+        return static_cast<qint64>(truncated);
     }
     
-    void dragLeaveEvent(QDragLeaveEvent* event) override {
-        updateStyle(false);
+    // QJsonValue::toInt() of the next value.
+    int readInt() {
+        Number number;
+        if (!readNumber(number)) return 0;
+        if (number.isInteger) {
+            return number.integer == static_cast<int>(number.integer) ? static_cast<int>(number.integer) : 0;
+        }
+        
+        double truncated = std::trunc(number.real);
+        if (truncated != number.real || truncated < std::numeric_limits<int>::min() ||
+            truncated > std::numeric_limits<int>::max()) {
+            return 0;
+        }
+        return static_cast<int>(truncated);
     }
     
-    void dropEvent(QDropEvent* event) override {
-        const QMimeData* mimeData = event->mimeData();
-        if (mimeData->hasUrls()) {
-            QStringList filePaths;
-            QList<QUrl> urls = mimeData->urls();
-            for (const QUrl& url : urls) {
-                QString filePath = url.toLocalFile();
-                if (filePath.endsWith(".json", Qt::CaseInsensitive) || 
-                    filePath.endsWith(".txt", Qt::CaseInsensitive)) {
-                    filePaths.append(filePath);
-                }
-            }
-            if (!filePaths.isEmpty()) {
-                emit filesDropped(filePaths);
-            }
+    // QJsonValue::toDouble() of the next value; false when it is no number.
+    bool readDouble(double& value) {
+        Number number;
+        if (!readNumber(number)) {
+            value = 0.0;
+            return false;
         }
-        updateStyle(false);
+        value = number.isInteger ? static_cast<double>(number.integer) : number.real;
+        return true;
     }
     
-    void mousePressEvent(QMouseEvent* event) override {
-        if (batchMode) {
-            QStringList filePaths = QFileDialog::getOpenFileNames(this, "Select Files", "", 
-                "Outfit Files (*.json *.txt);;JSON Files (*.json);;Text Files (*.txt)");
-            if (!filePaths.isEmpty()) {
-                emit filesDropped(filePaths);
+    // True when the next value is exactly the string literal. Escaped
+    // strings fail the read rather than being decoded.
+    template <qsizetype N>
+    bool readStringEquals(const char (&literal)[N]) {
+        skipWhitespace();
+        if (p >= end || *p != '"') {
+            skipValue();
+            return false;
+        }
+        JsonKey value;
+        return readKey(value) && value.is(literal);
+    }
+    
+    // Validates and steps over the next value.
+    bool skipValue(int depth = 0) {
+        skipWhitespace();
+        if (p >= end || depth > kMaxDepth) return fail();
+        
+        switch (*p) {
+            case '{': {
+                ++p;
+                skipWhitespace();
+                if (p < end && *p == '}') { ++p; return true; }
+                while (true) {
+                    skipWhitespace();
+                    if (p >= end || *p != '"' || !skipString()) return fail();
+                    skipWhitespace();
+                    if (p >= end || *p != ':') return fail();
+                    ++p;
+                    if (!skipValue(depth + 1)) return false;
+                    skipWhitespace();
+                    if (p < end && *p == ',') { ++p; continue; }
+                    if (p < end && *p == '}') { ++p; return true; }
+                    return fail();
+                }
             }
-        } else {
-            QString filePath = QFileDialog::getOpenFileName(this, "Select File", "", 
-                "Outfit Files (*.json *.txt);;JSON Files (*.json);;Text Files (*.txt)");
-            if (!filePath.isEmpty()) {
-                emit filesDropped(QStringList() << filePath);
+            case '[': {
+                ++p;
+                skipWhitespace();
+                if (p < end && *p == ']') { ++p; return true; }
+                while (true) {
+                    if (!skipValue(depth + 1)) return false;
+                    skipWhitespace();
+                    if (p < end && *p == ',') { ++p; continue; }
+                    if (p < end && *p == ']') { ++p; return true; }
+                    return fail();
+                }
+            }
+            case '"':
+                return skipString() || fail();
+            case 't':
+                return skipLiteral("true");
+            case 'f':
+                return skipLiteral("false");
+            case 'n':
+                return skipLiteral("null");
+            default: {
+                Number number;
+                return scanNumber(number);
             }
         }
     }
     
 private:
-    void updateStyle(bool dragging) {
-        if (dragging) {
-            setStyleSheet("DropZone { background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #667eea, stop:1 #764ba2); border: 3px dashed #fff; border-radius: 16px; }");
-        } else {
-            setStyleSheet("DropZone { background: #2a2a2a; border: 2px dashed #555; border-radius: 16px; }");
-        }
+    static constexpr int kMaxDepth = 1024;
+    static constexpr int kMaxCursorDepth = 63;
+    
+    struct Number {
+        bool isInteger = true;
+        qint64 integer = 0;
+        double real = 0.0;
+    };
+    
+    bool fail() {
+        error = true;
+        p = end;
+        return false;
     }
     
-    QLabel* iconLabel;
-    QLabel* textLabel;
-    bool batchMode;
-};
-
-// Outfit Editor Tab
-class OutfitEditorTab : public QWidget {
-    Q_OBJECT
-public:
-    explicit OutfitEditorTab(QWidget* parent = nullptr) : QWidget(parent) {
-        setupUI();
-        loadPlayerData();
+    void skipWhitespace() {
+        while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) ++p;
     }
     
-private slots:
-    void loadPlayerData() {
-        QString yimPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/OutfitConverter/YimMenu";
-        QDir dir(yimPath);
-        
-        if (!dir.exists()) {
-            playerNameLabel->setText("Player: Unknown");
-            return;
+    bool enter(char open) {
+        skipWhitespace();
+        if (error || p >= end || *p != open || cursorDepth >= kMaxCursorDepth) return fail();
+        ++p;
+        needComma &= ~(quint64(1) << ++cursorDepth);
+        return true;
+    }
+    
+    bool nextItem(char close) {
+        if (error) return false;
+        skipWhitespace();
+        if (p < end && *p == close) {
+            ++p;
+            cursorDepth--;
+            return false;
         }
         
-        playerNameLabel->setText("Player: " + qgetenv("USERNAME"));
-        
-        outfitList->clear();
-        QStringList filters;
-        filters << "*.json";
-        QFileInfoList files = dir.entryInfoList(filters, QDir::Files);
-        
-        for (const QFileInfo& fileInfo : files) {
-            outfitList->addItem(fileInfo.baseName());
+        quint64 bit = quint64(1) << cursorDepth;
+        if (needComma & bit) {
+            if (p >= end || *p != ',') return fail();
+            ++p;
+            skipWhitespace();
         }
+        needComma |= bit;
+        return true;
     }
     
-    void onOutfitSelected(QListWidgetItem* item) {
-        if (!item) return;
-        
-        currentOutfitName = item->text();
-        QString yimPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/OutfitConverter/YimMenu";
-        QString filePath = yimPath + "/" + currentOutfitName + ".json";
-        
-        QFile file(filePath);
-        if (!file.open(QIODevice::ReadOnly)) {
-            QMessageBox::warning(this, "Error", "Failed to load outfit");
-            return;
+    // Reads a string without escapes in place; escapes fail the read.
+    bool readKey(JsonKey& key) {
+        const char* start = ++p;
+        while (true) {
+            p = scanString(p, end);
+            if (p >= end) return fail();
+            unsigned char c = static_cast<unsigned char>(*p);
+            if (c == '"') break;
+            if (c < 0x80 || !skipUtf8()) return fail();
         }
-        
-        QByteArray data = file.readAll();
-        file.close();
-        
-        QJsonDocument doc = QJsonDocument::fromJson(data);
-        currentOutfit = doc.object();
-        
-        outfitNameEdit->setText(currentOutfitName);
-        loadOutfitToEditor();
+        key.data = start;
+        key.size = p - start;
+        ++p;
+        return true;
     }
     
-    void loadOutfitToEditor() {
-        QLayoutItem* item;
-        while ((item = componentsLayout->takeAt(0)) != nullptr) {
-            delete item->widget();
-            delete item;
-        }
-        componentSpinBoxes.clear();
-        textureSpinBoxes.clear();
-        
-        if (currentOutfit.contains("components")) {
-            QJsonObject comps = currentOutfit["components"].toObject();
-            
-            QStringList compNames = {"Head", "Mask/Beard", "Hair", "Top", "Pants", "Gloves", 
-                                     "Shoes", "Accessories", "Undershirt", "Armor", "Decals", "Torso Extra"};
-            
-            for (int i = 0; i < 12; ++i) {
-                QString key = QString::number(i);
-                QJsonObject comp = comps.value(key).toObject();
-                
-                QLabel* label = new QLabel(compNames[i] + ":", this);
-                label->setStyleSheet("color: #fff; font-weight: bold;");
-                
-                QSpinBox* drawableSpin = new QSpinBox(this);
-                drawableSpin->setRange(-1, 500);
-                drawableSpin->setValue(comp.value("drawable_id").toInt());
-                drawableSpin->setStyleSheet("QSpinBox { background: #2a2a2a; color: #fff; border: 1px solid #555; padding: 5px; }");
-                
-                QSpinBox* textureSpin = new QSpinBox(this);
-                textureSpin->setRange(-1, 500);
-                textureSpin->setValue(comp.value("texture_id").toInt());
-                textureSpin->setStyleSheet("QSpinBox { background: #2a2a2a; color: #fff; border: 1px solid #555; padding: 5px; }");
-                
-                connect(drawableSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &OutfitEditorTab::onComponentChanged);
-                connect(textureSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &OutfitEditorTab::onComponentChanged);
-                
-                componentSpinBoxes[i] = drawableSpin;
-                textureSpinBoxes[i] = textureSpin;
-                
-                QHBoxLayout* rowLayout = new QHBoxLayout();
-                rowLayout->addWidget(label, 1);
-                rowLayout->addWidget(new QLabel("Drawable:", this));
-                rowLayout->addWidget(drawableSpin, 1);
-                rowLayout->addWidget(new QLabel("Texture:", this));
-                rowLayout->addWidget(textureSpin, 1);
-                
-                componentsLayout->addLayout(rowLayout);
+    bool skipString() {
+        ++p;
+        while (true) {
+            p = scanString(p, end);
+            if (p >= end) return false;
+            unsigned char c = static_cast<unsigned char>(*p);
+            if (c == '"') {
+                ++p;
+                return true;
+            }
+            if (c == '\\') {
+                if (!skipEscape()) return false;
+            } else if (c < 0x80 || !skipUtf8()) {
+                return false;
             }
         }
-        
-        if (currentOutfit.contains("props")) {
-            QJsonObject props = currentOutfit["props"].toObject();
-            
-            QStringList propNames = {"Hat", "Glasses", "Earwear", "Mouth", "Left Hand", 
-                                     "Right Hand", "Watch", "Bracelet", "Hip"};
-            
-            for (int i = 0; i < 9; ++i) {
-                QString key = QString::number(i);
-                QJsonObject prop = props.value(key).toObject();
-                
-                QLabel* label = new QLabel(propNames[i] + ":", this);
-                label->setStyleSheet("color: #fff; font-weight: bold;");
-                
-                QSpinBox* drawableSpin = new QSpinBox(this);
-                drawableSpin->setRange(-1, 500);
-                drawableSpin->setValue(prop.value("drawable_id").toInt());
-                drawableSpin->setStyleSheet("QSpinBox { background: #2a2a2a; color: #fff; border: 1px solid #555; padding: 5px; }");
-                
-                QSpinBox* textureSpin = new QSpinBox(this);
-                textureSpin->setRange(-1, 500);
-                textureSpin->setValue(prop.value("texture_id").toInt());
-                textureSpin->setStyleSheet("QSpinBox { background: #2a2a2a; color: #fff; border: 1px solid #555; padding: 5px; }");
-                
-                connect(drawableSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &OutfitEditorTab::onPropChanged);
-                connect(textureSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &OutfitEditorTab::onPropChanged);
-                
-                propDrawableSpinBoxes[i] = drawableSpin;
-                propTextureSpinBoxes[i] = textureSpin;
-                
-                QHBoxLayout* rowLayout = new QHBoxLayout();
-                rowLayout->addWidget(label, 1);
-                rowLayout->addWidget(new QLabel("Drawable:", this));
-                rowLayout->addWidget(drawableSpin, 1);
-                rowLayout->addWidget(new QLabel("Texture:", this));
-                rowLayout->addWidget(textureSpin, 1);
-                
-                propsLayout->addLayout(rowLayout);
+    }
+    
+    bool skipEscape() {
+        if (end - p < 2) return false;
+        char c = p[1];
+        p += 2;
+        if (c == 'u') {
+            if (end - p < 4) return false;
+            for (int i = 0; i < 4; ++i) {
+                if (!std::isxdigit(static_cast<unsigned char>(p[i]))) return false;
             }
+            p += 4;
+            return true;
         }
+        return c == '"' || c == '\\' || c == '/' || c == 'b' || c == 'f' || c == 'n' || c == 'r' || c == 't';
     }
     
-    void onComponentChanged() {
-        if (currentOutfit.isEmpty()) return;
-        
-        QJsonObject comps = currentOutfit["components"].toObject();
-        
-        for (auto it = componentSpinBoxes.begin(); it != componentSpinBoxes.end(); ++it) {
-            int idx = it.key();
-            QJsonObject comp;
-            comp["drawable_id"] = componentSpinBoxes[idx]->value();
-            comp["texture_id"] = textureSpinBoxes[idx]->value();
-            comps[QString::number(idx)] = comp;
+    // Steps over one well-formed multi-byte UTF-8 sequence.
+    bool skipUtf8() {
+        const unsigned char* s = reinterpret_cast<const unsigned char*>(p);
+        qsizetype left = end - p;
+        int length = 0;
+        quint32 codePoint = 0;
+        if (s[0] >= 0xC2 && s[0] <= 0xDF) { length = 2; codePoint = s[0] & 0x1F; }
+        else if (s[0] >= 0xE0 && s[0] <= 0xEF) { length = 3; codePoint = s[0] & 0x0F; }
+        else if (s[0] >= 0xF0 && s[0] <= 0xF4) { length = 4; codePoint = s[0] & 0x07; }
+        else return false;
+        
+        if (left < length) return false;
+        for (int i = 1; i < length; ++i) {
+            if ((s[i] & 0xC0) != 0x80) return false;
+            codePoint = (codePoint << 6) | (s[i] & 0x3F);
         }
         
-        currentOutfit["components"] = comps;
-        saveCurrentOutfit();
+        // Overlong forms, surrogates and values past U+10FFFF.
+        if ((length == 3 && codePoint < 0x800) || (length == 4 && codePoint < 0x10000) ||
+            (codePoint >= 0xD800 && codePoint <= 0xDFFF) || codePoint > 0x10FFFF) {
+            return false;
+        }
+        p += length;
+        return true;
     }
     
-    void onPropChanged() {
-        if (currentOutfit.isEmpty()) return;
-        
-        QJsonObject props = currentOutfit["props"].toObject();
-        
-        for (auto it = propDrawableSpinBoxes.begin(); it != propDrawableSpinBoxes.end(); ++it) {
-            int idx = it.key();
-            QJsonObject prop;
-            prop["drawable_id"] = propDrawableSpinBoxes[idx]->value();
-            prop["texture_id"] = propTextureSpinBoxes[idx]->value();
-            props[QString::number(idx)] = prop;
+    // Next byte that ends a plain run inside a string: '"', '\\', a control
+    // character or the start of a multi-byte sequence.
+    static const char* scanString(const char* s, const char* end) {
+#ifdef OUTFIT_READER_SSE2
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i space = _mm_set1_epi8(0x20);
+        while (end - s >= 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+            // The signed compare also flags every byte >= 0x80.
+            __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                                        _mm_cmpeq_epi8(chunk, backslash)),
+                                           _mm_cmplt_epi8(chunk, space));
+            int mask = _mm_movemask_epi8(special);
+            if (mask != 0) {
+                return s + qCountTrailingZeroBits(static_cast<quint32>(mask));
+            }
+            s += 16;
         }
-        
-        currentOutfit["props"] = props;
-        saveCurrentOutfit();
+#endif
+        while (s < end) {
+            unsigned char c = static_cast<unsigned char>(*s);
+            if (c == '"' || c == '\\' || c < 0x20 || c >= 0x80) break;
+            ++s;
+        }
+        return s;
     }
     
-    void saveCurrentOutfit() {
-        QString yimPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/OutfitConverter/YimMenu";
-        QString filePath = yimPath + "/" + currentOutfitName + ".json";
-        
-        QFile file(filePath);
-        if (!file.open(QIODevice::WriteOnly)) {
-            return;
+    template <qsizetype N>
+    bool skipLiteral(const char (&literal)[N]) {
+        if (end - p < N - 1 || std::memcmp(p, literal, N - 1) != 0) return fail();
+        p += N - 1;
+        return true;
+    }
+    
+    // Reads the next value as a number; other values are skipped and
+    // report false, like QJsonValue's numeric accessors returning 0.
+    bool readNumber(Number& number) {
+        skipWhitespace();
+        if (p < end && (*p == '-' || (*p >= '0' && *p <= '9'))) {
+            return scanNumber(number);
         }
-        
-        QJsonDocument doc(currentOutfit);
-        file.write(doc.toJson(QJsonDocument::Indented));
-        file.close();
-        
-        statusLabel->setText("✓ Auto-saved at " + QTime::currentTime().toString("hh:mm:ss"));
-        statusLabel->setStyleSheet("color: #4CAF50; font-size: 12px;");
+        skipValue();
+        return false;
     }
     
-    void renameOutfit() {
-        if (currentOutfitName.isEmpty()) {
-            QMessageBox::warning(this, "Warning", "No outfit selected");
-            return;
+    // JSON number grammar. Plain integers that fit in qint64 stay exact, the
+    // rest become doubles, as in QJsonDocument.
+    bool scanNumber(Number& number) {
+        const char* start = p;
+        bool negative = p < end && *p == '-';
+        if (negative) ++p;
+        if (p >= end || *p < '0' || *p > '9') return fail();
+        
+        quint64 magnitude = 0;
+        bool overflow = false;
+        if (*p == '0') {
+            ++p;
+        } else {
+            while (p < end && *p >= '0' && *p <= '9') {
+                unsigned digit = *p++ - '0';
+                if (magnitude > (std::numeric_limits<quint64>::max() - digit) / 10) overflow = true;
+                else magnitude = magnitude * 10 + digit;
+            }
         }
         
-        QString newName = outfitNameEdit->text().trimmed();
-        if (newName.isEmpty() || newName == currentOutfitName) {
-            return;
+        bool fractional = false;
+        if (p < end && *p == '.') {
+            ++p;
+            if (p >= end || *p < '0' || *p > '9') return fail();
+            while (p < end && *p >= '0' && *p <= '9') ++p;
+            fractional = true;
         }
-        
-        QString yimPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/OutfitConverter/YimMenu";
-        QString oldPath = yimPath + "/" + currentOutfitName + ".json";
-        QString newPath = yimPath + "/" + newName + ".json";
-        
-        if (QFile::exists(newPath)) {
-            QMessageBox::warning(this, "Warning", "An outfit with this name already exists");
-            return;
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            ++p;
+            if (p < end && (*p == '+' || *p == '-')) ++p;
+            if (p >= end || *p < '0' || *p > '9') return fail();
+            while (p < end && *p >= '0' && *p <= '9') ++p;
+            fractional = true;
         }
         
-        if (QFile::rename(oldPath, newPath)) {
-            currentOutfitName = newName;
-            loadPlayerData();
-            statusLabel->setText("✓ Outfit renamed successfully");
-            statusLabel->setStyleSheet("color: #4CAF50; font-size: 12px;");
+        const quint64 limit = negative ? quint64(1) << 63 : (quint64(1) << 63) - 1;
+        if (!fractional && !overflow && magnitude <= limit) {
+            number.isInteger = true;
+            number.integer = negative ? static_cast<qint64>(0 - magnitude) : static_cast<qint64>(magnitude);
         } else {
-            QMessageBox::critical(this, "Error", "Failed to rename outfit");
+            number.isInteger = false;
+            number.real = QByteArray::fromRawData(start, p - start).toDouble();
         }
+        return true;
     }
     
-    void exportOutfit() {
-        if (currentOutfit.isEmpty()) {
-            QMessageBox::warning(this, "Warning", "No outfit selected");
-            return;
+    const char* p;
+    const char* end;
+    quint64 needComma = 0;
+    int cursorDepth = 0;
+    bool error = false;
+};
+
+// An object member kept as its raw, already validated JSON text.
+struct RawMember {
+    JsonKey key;
+    JsonKey value;
+};
+using RawMembers = std::pmr::vector<RawMember>;
+
+// Last member named key, as QJsonObject would keep it.
+const RawMember* findRawMember(const RawMembers& members, const char* key) {
+    qsizetype size = qsizetype(std::strlen(key));
+    for (qsizetype i = members.size() - 1; i >= 0; --i) {
+        if (members[i].key.size == size && std::memcmp(members[i].key.data, key, size) == 0) {
+            return &members[i];
         }
-        
+    }
+    return nullptr;
+}
+
+// Reads a YimMenu "blend_data" value the way outfitDataFromYim() does.
+void readBlendData(OutfitJsonReader& reader, FaceData& face) {
+    FaceData blend;
+    if (!reader.peekObject()) {
+        reader.skipValue();
+    } else {
+        blend.hasBlend = true;
+        reader.enterObject();
+        JsonKey key;
+        double mix = 0.0;
+        while (reader.nextMember(key)) {
+            if (key.is("is_parent")) blend.isParent = reader.readInt() != 0;
+            else if (key.is("shape_first_id")) blend.shapeIds[0] = reader.readInt();
+            else if (key.is("shape_second_id")) blend.shapeIds[1] = reader.readInt();
+            else if (key.is("shape_third_id")) blend.shapeIds[2] = reader.readInt();
+            else if (key.is("skin_first_id")) blend.skinIds[0] = reader.readInt();
+            else if (key.is("skin_second_id")) blend.skinIds[1] = reader.readInt();
+            else if (key.is("skin_third_id")) blend.skinIds[2] = reader.readInt();
+            else if (key.is("shape_mix")) { reader.readDouble(mix); blend.shapeMix = static_cast<float>(mix); }
+            else if (key.is("skin_mix")) { reader.readDouble(mix); blend.skinMix = static_cast<float>(mix); }
+            else if (key.is("third_mix")) { reader.readDouble(mix); blend.thirdMix = static_cast<float>(mix); }
+            else reader.skipValue();
+        }
+    }
+    
+    std::memcpy(face.shapeIds, blend.shapeIds, sizeof(face.shapeIds));
+    std::memcpy(face.skinIds, blend.skinIds, sizeof(face.skinIds));
+    face.shapeMix = blend.shapeMix;
+    face.skinMix = blend.skinMix;
+    face.thirdMix = blend.thirdMix;
+    face.isParent = blend.isParent;
+    face.hasBlend = blend.hasBlend;
+}
+
+// Reads a YimMenu "face_features" array under yimFaceFeatures()' rules.
+void readYimFaceFeatures(OutfitJsonReader& reader, FaceData& face) {
+    face.hasFeatures = false;
+    std::fill(face.features, face.features + kFaceFeatureCount, 0.0f);
+    if (!reader.peekArray()) {
+        reader.skipValue();
+        return;
+    }
+    
+    float features[kFaceFeatureCount];
+    int count = 0;
+    bool valid = true;
+    reader.enterArray();
+    while (reader.nextElement()) {
+        double value = 0.0;
+        if (count < kFaceFeatureCount && reader.readDouble(value) && toFaceFeature(value, features[count])) {
+            count++;
+            continue;
+        }
+        if (count >= kFaceFeatureCount) reader.skipValue();
+        valid = false;
+    }
+    if (valid && count == kFaceFeatureCount) {
+        std::memcpy(face.features, features, sizeof(features));
+        face.hasFeatures = true;
+    }
+}
+
+// Reads a Cherax "face_features" object under cheraxFaceFeatures()' rules.
+bool readCheraxFaceFeatures(OutfitJsonReader& reader, float* features) {
+    if (!reader.peekObject()) {
+        reader.skipValue();
+        return false;
+    }
+    
+    // Repeated keys count once, and the last one wins, as in QJsonObject.
+    quint32 seen = 0;
+    quint32 invalid = 0;
+    bool unknown = false;
+    reader.enterObject();
+    JsonKey key;
+    while (reader.nextMember(key)) {
+        int index = -1;
+        for (int i = 0; i < kFaceFeatureCount && index < 0; ++i) {
+            if (key.size == qsizetype(std::strlen(kFaceFeatureNames[i])) &&
+                std::memcmp(key.data, kFaceFeatureNames[i], key.size) == 0) {
+                index = i;
+            }
+        }
+        double value = 0.0;
+        if (index < 0) {
+            reader.skipValue();
+            unknown = true;
+            continue;
+        }
+        seen |= 1u << index;
+        if (reader.readDouble(value) && toFaceFeature(value, features[index])) invalid &= ~(1u << index);
+        else invalid |= 1u << index;
+    }
+    return !unknown && invalid == 0 && seen == (1u << kFaceFeatureCount) - 1;
+}
+
+// Cherax slot names, indexed like the YimMenu slot numbers.
+const char* const kCheraxComponentNames[kComponentSlotCount] = {
+    "Head", "Beard", "Hair", "Torso", "Legs", "Hands", "Feet", "Teeth",
+    "Special", "Special 2", "Decal", "Tuxedo/Jacket Bib"};
+const char* const kCheraxPropNames[kPropSlotCount] = {
+    "Head", "Eyes", "Ears", "Mouth", "Left Hand", "Right Hand",
+    "Left Wrist", "Right Wrist", "Hip"};
+
+struct DecodedOutfit {
+    // scratch backs the member lists; pass a ConversionArena's resource
+    // to keep decoding off the heap.
+    explicit DecodedOutfit(std::pmr::memory_resource* scratch = std::pmr::get_default_resource())
+        : root(scratch), components(scratch), props(scratch),
+          lexisOutfit(scratch), extensions(scratch), yimRoot(scratch) {}
+    
+    OutfitFormat format = OutfitFormat::Unknown;
+    OutfitData outfit;
+    
+    // Raw members of the source, pointing into the decoded buffer. The
+    // writers carry whatever the target has no field for through them.
+    RawMembers root;
+    RawMembers components;   // members of the root "components" object
+    RawMembers props;        // members of the root "props" object
+    RawMembers lexisOutfit;  // members of the Lexis "outfit" object
+    RawMembers extensions;   // members of the "_ext" side-channel
+    RawMembers yimRoot;      // members of "_ext" -> "yimmenu" -> "root"
+    bool cheraxFaceMapped = false;  // Cherax face_features the writers map natively
+};
+
+// Decodes a JSON outfit in one pass into the same OutfitData the DOM path
+// (convert to YimMenu, then outfitDataFromYim) would produce. assumed picks
+// the schema to report; Unknown detects it like detectFormatFromData.
+// Returns false when the caller has to fall back to QJsonDocument. The raw
+// members in result stay valid only as long as bytes does.
+bool decodeOutfitJson(const QByteArray& bytes, DecodedOutfit& result,
+                      OutfitFormat assumed = OutfitFormat::Unknown) {
+    auto cheraxSlot = [](const JsonKey& key, const char* const* names, int count) {
+        for (int i = 0; i < count; ++i) {
+            if (key.size == qsizetype(std::strlen(names[i])) && std::memcmp(key.data, names[i], key.size) == 0) {
+                return i;
+            }
+        }
+        return -1;
+    };
+    
+    OutfitJsonReader reader(bytes.constData(), bytes.constData() + bytes.size());
+    if (!reader.peekObject()) return false;
+    
+    result.root.clear();
+    result.components.clear();
+    result.props.clear();
+    result.lexisOutfit.clear();
+    result.extensions.clear();
+    result.yimRoot.clear();
+    result.cheraxFaceMapped = false;
+    
+    // YimMenu and Cherax share the root layout and differ in slot keys, so
+    // one pass fills both; Lexis lives under "outfit".
+    OutfitData yim;
+    OutfitData cherax;
+    OutfitData lexis;
+    bool isCherax = false;
+    bool hasBlendData = false;
+    bool cheraxFace = false;
+    float cheraxFeatures[kFaceFeatureCount] = {};
+    bool lexisHasComponent = false;
+    bool lexisHasVariation = false;
+    int componentCount = 0;
+    JsonKey firstComponentKey;
+    quint32 absentComponents = 0;
+    quint32 absentProps = 0;
+    
+    // Lexis arrays, kept until both halves of each pair are known.
+    int lexisValues[4][kComponentSlotCount] = {};
+    int lexisSizes[4] = {};
+    bool lexisHasProp = false;
+    
+    auto readSlotObject = [&reader](OutfitSlot* yimSlot, OutfitSlot* cheraxSlot) {
+        OutfitSlot yimValue{0, 0};
+        OutfitSlot cheraxValue{0, 0};
+        if (reader.peekObject()) {
+            reader.enterObject();
+            JsonKey key;
+            while (reader.nextMember(key)) {
+                if (key.is("drawable_id")) yimValue.drawable = reader.readInt();
+                else if (key.is("texture_id")) yimValue.texture = reader.readInt();
+                else if (key.is("drawable")) cheraxValue.drawable = reader.readInt();
+                else if (key.is("texture")) cheraxValue.texture = reader.readInt();
+                else reader.skipValue();
+            }
+        } else {
+            reader.skipValue();
+        }
+        if (yimSlot) *yimSlot = yimValue;
+        if (cheraxSlot) *cheraxSlot = cheraxValue;
+    };
+    
+    auto readSlots = [&](bool isProp) {
+        if (!reader.peekObject()) {
+            reader.skipValue();
+            return;
+        }
+        
+        int yimCount = isProp ? kPropSlotCount : kComponentSlotCount;
+        OutfitSlot* yimSlots = isProp ? yim.props : yim.components;
+        OutfitSlot* cheraxSlots = isProp ? cherax.props : cherax.components;
+        quint32& yimMask = isProp ? yim.propMask : yim.componentMask;
+        quint32& cheraxMask = isProp ? cherax.propMask : cherax.componentMask;
+        RawMembers& members = isProp ? result.props : result.components;
+        members.clear();
+        
+        reader.enterObject();
+        JsonKey key;
+        while (reader.nextMember(key)) {
+            const char* start = reader.valueStart();
+            if (!isProp) {
+                if (componentCount == 0 || key < firstComponentKey) firstComponentKey = key;
+                componentCount++;
+            }
+            
+            int id = -1;
+            bool numeric = key.toInt(id) && id >= 0 && id < yimCount;
+            int named = cheraxSlot(key, isProp ? kCheraxPropNames : kCheraxComponentNames, yimCount);
+            readSlotObject(numeric ? &yimSlots[id] : nullptr, named >= 0 ? &cheraxSlots[named] : nullptr);
+            if (numeric) yimMask |= 1u << id;
+            if (named >= 0) cheraxMask |= 1u << named;
+            members.push_back({key, {start, reader.position() - start}});
+        }
+    };
+    
+    auto readIntArray = [&reader](int* values, int capacity, int& size) {
+        size = 0;
+        if (!reader.peekArray()) {
+            reader.skipValue();
+            return;
+        }
+        reader.enterArray();
+        while (reader.nextElement()) {
+            if (size < capacity) values[size++] = reader.readInt();
+            else reader.skipValue();
+        }
+    };
+    
+    auto readAbsent = [&reader](quint32& mask, int count) {
+        if (!reader.peekArray()) {
+            reader.skipValue();
+            return;
+        }
+        reader.enterArray();
+        while (reader.nextElement()) {
+            int slot = reader.readInt();
+            if (slot >= 0 && slot < count) mask |= 1u << slot;
+        }
+    };
+    
+    bool extensionReplacesSlots = false;
+    auto readExtension = [&]() {
+        if (!reader.peekObject()) {
+            reader.skipValue();
+            return;
+        }
+        reader.enterObject();
+        JsonKey key;
+        while (reader.nextMember(key)) {
+            const char* start = reader.valueStart();
+            if (!key.is("yimmenu") || !reader.peekObject()) {
+                reader.skipValue();
+                result.extensions.push_back({key, {start, reader.position() - start}});
+                continue;
+            }
+            reader.enterObject();
+            JsonKey field;
+            while (reader.nextMember(field)) {
+                if (field.is("absent_components")) readAbsent(absentComponents, kComponentSlotCount);
+                else if (field.is("absent_props")) readAbsent(absentProps, kPropSlotCount);
+                else if (field.is("root") && reader.peekObject()) {
+                    // Restored root fields that replace slots are left to the DOM.
+                    reader.enterObject();
+                    JsonKey rootKey;
+                    while (reader.nextMember(rootKey)) {
+                        if (rootKey.is("model") || rootKey.is("components") || rootKey.is("props") ||
+                            rootKey.is("_ext")) {
+                            extensionReplacesSlots = true;
+                        }
+                        const char* rootStart = reader.valueStart();
+                        reader.skipValue();
+                        result.yimRoot.push_back({rootKey, {rootStart, reader.position() - rootStart}});
+                    }
+                } else {
+                    reader.skipValue();
+                }
+            }
+        }
+    };
+    
+    reader.enterObject();
+    JsonKey key;
+    while (reader.nextMember(key)) {
+        const char* start = reader.valueStart();
+        if (key.is("model")) {
+            yim.model = cherax.model = reader.readInteger();
+            yim.hasModel = cherax.hasModel = true;
+        } else if (key.is("format")) {
+            isCherax = reader.readStringEquals("Cherax Entity");
+        } else if (key.is("blend_data")) {
+            hasBlendData = true;
+            readBlendData(reader, yim.face);
+        } else if (key.is("face_features")) {
+            // YimMenu's array or Cherax's named features; the last one counts.
+            cheraxFace = false;
+            if (reader.peekObject()) {
+                yim.face.hasFeatures = false;
+                std::fill(yim.face.features, yim.face.features + kFaceFeatureCount, 0.0f);
+                cheraxFace = readCheraxFaceFeatures(reader, cheraxFeatures) && !isDefaultFace(cheraxFeatures);
+            } else {
+                readYimFaceFeatures(reader, yim.face);
+            }
+        } else if (key.is("components")) {
+            readSlots(false);
+        } else if (key.is("props")) {
+            readSlots(true);
+        } else if (key.is("_ext")) {
+            readExtension();
+        } else if (key.is("outfit") && reader.peekObject()) {
+            reader.enterObject();
+            JsonKey field;
+            while (reader.nextMember(field)) {
+                const char* fieldStart = reader.valueStart();
+                if (field.is("model")) {
+                    lexis.model = reader.readInteger();
+                    lexis.hasModel = true;
+                } else if (field.is("component")) {
+                    lexisHasComponent = true;
+                    readIntArray(lexisValues[0], kComponentSlotCount, lexisSizes[0]);
+                } else if (field.is("component variation")) {
+                    lexisHasVariation = true;
+                    readIntArray(lexisValues[1], kComponentSlotCount, lexisSizes[1]);
+                } else if (field.is("prop")) {
+                    lexisHasProp = true;
+                    readIntArray(lexisValues[2], kPropSlotCount, lexisSizes[2]);
+                } else if (field.is("prop variation")) {
+                    readIntArray(lexisValues[3], kPropSlotCount, lexisSizes[3]);
+                } else {
+                    reader.skipValue();
+                }
+                result.lexisOutfit.push_back({field, {fieldStart, reader.position() - fieldStart}});
+            }
+        } else {
+            reader.skipValue();
+        }
+        result.root.push_back({key, {start, reader.position() - start}});
+    }
+    if (reader.failed() || !reader.atEnd() || extensionReplacesSlots) return false;
+    
+    OutfitFormat format = assumed;
+    if (format == OutfitFormat::Unknown) {
+        int firstId = 0;
+        if (isCherax) {
+            format = OutfitFormat::Cherax;
+        } else if (lexisHasComponent && lexisHasVariation) {
+            format = OutfitFormat::Lexis;
+        } else if (hasBlendData && componentCount > 0 && firstComponentKey.toInt(firstId)) {
+            format = OutfitFormat::YimMenu;
+        }
+    }
+    
+    switch (format) {
+        case OutfitFormat::Cherax:
+            result.outfit = cherax;
+            break;
+        case OutfitFormat::Lexis: {
+            lexis.componentMask = 0;
+            if (lexisHasComponent) {
+                for (int i = 0; i < lexisSizes[0]; ++i) {
+                    lexis.components[i].drawable = lexisValues[0][i];
+                    lexis.components[i].texture = i < lexisSizes[1] ? lexisValues[1][i] : 0;
+                    lexis.componentMask |= 1u << i;
+                }
+            }
+            if (lexisHasProp) {
+                for (int i = 0; i < lexisSizes[2]; ++i) {
+                    lexis.props[i].drawable = lexisValues[2][i];
+                    lexis.props[i].texture = i < lexisSizes[3] ? lexisValues[3][i] : -1;
+                    lexis.propMask |= 1u << i;
+                }
+            }
+            result.outfit = lexis;
+            break;
+        }
+        default:
+            result.outfit = yim;
+            break;
+    }
+    
+    // Slots the YimMenu side-channel records as absent are dropped again.
+    if (format == OutfitFormat::Cherax || format == OutfitFormat::Lexis) {
+        result.outfit.componentMask &= ~absentComponents;
+        result.outfit.propMask &= ~absentProps;
+        for (int i = 0; i < kComponentSlotCount; ++i) {
+            if (!result.outfit.hasSlot(false, i)) result.outfit.components[i] = OutfitSlot();
+        }
+        for (int i = 0; i < kPropSlotCount; ++i) {
+            if (!result.outfit.hasSlot(true, i)) result.outfit.props[i] = OutfitSlot();
+        }
+        
+        // Zero blend data unless the side-channel has the original, as in
+        // restoreYimExtension(); Cherax's own face wins over a carried one.
+        FaceData& face = result.outfit.face;
+        face = FaceData();
+        face.hasBlend = true;
+        if (const RawMember* blend = findRawMember(result.yimRoot, "blend_data")) {
+            OutfitJsonReader blendReader(blend->value.data, blend->value.data + blend->value.size);
+            readBlendData(blendReader, face);
+        }
+        if (const RawMember* features = findRawMember(result.yimRoot, "face_features")) {
+            OutfitJsonReader featureReader(features->value.data, features->value.data + features->value.size);
+            readYimFaceFeatures(featureReader, face);
+        }
+        result.cheraxFaceMapped = format == OutfitFormat::Cherax && cheraxFace;
+        if (result.cheraxFaceMapped) {
+            std::memcpy(face.features, cheraxFeatures, sizeof(cheraxFeatures));
+            face.hasFeatures = true;
+        }
+    }
+    
+    result.format = format;
+    return true;
+}
+
+// Outfit Writer
+// Emits indented JSON straight into a reusable byte buffer, so converting a
+// decoded outfit builds no QJsonObject tree and makes no QString round trip.
+// Keep one writer per thread; reset() keeps the buffer's capacity.
+//
+// The layout is QJsonDocument::toJson(Indented)'s, which makes it the
+// canonical one for every outfit file the app writes: members are sorted by
+// key when their object closes, whatever order they were written in, and
+// copied objects and arrays are laid out again. Only scalars are copied as
+// written, so output matches the DOM path byte for byte whenever the source
+// spelled its strings and numbers the way QJsonDocument does.
+class OutfitJsonWriter {
+public:
+    struct Mark {
+        qsizetype size;
+        quint64 hasMembers;
+        int depth;
+        std::size_t members;
+        std::size_t objects;
+    };
+    
+    void reset() {
+        out.resize(0);
+        hasMembers = 0;
+        depth = 0;
+        members.clear();
+        objects.clear();
+    }
+    
+    const QByteArray& data() const { return out; }
+    
+    // Lets a caller drop a member it started but had nothing to put in.
+    Mark mark() const { return {out.size(), hasMembers, depth, members.size(), objects.size()}; }
+    
+    void rollback(const Mark& mark) {
+        out.resize(mark.size);
+        hasMembers = mark.hasMembers;
+        depth = mark.depth;
+        members.resize(mark.members);
+        objects.resize(mark.objects);
+    }
+    
+    void beginObject() {
+        out.append('{');
+        hasMembers &= ~(quint64(1) << ++depth);
+        objects.push_back(members.size());
+    }
+    
+    void endObject() {
+        sortMembers();
+        close('}');
+    }
+    
+    void beginArray() {
+        out.append('[');
+        hasMembers &= ~(quint64(1) << ++depth);
+    }
+    
+    void endArray() {
+        close(']');
+    }
+    
+    // Starts the next array element.
+    void element() {
+        quint64 bit = quint64(1) << depth;
+        if (hasMembers & bit) out.append(',');
+        hasMembers |= bit;
+        out.append('\n');
+        indent();
+    }
+    
+    template <qsizetype N>
+    void key(const char (&literal)[N]) {
+        key(literal, N - 1);
+    }
+    
+    void key(const JsonKey& raw) {
+        key(raw.data, raw.size);
+    }
+    
+    void key(const char* text, qsizetype size) {
+        quint64 bit = quint64(1) << depth;
+        if (hasMembers & bit) out.append(',');
+        hasMembers |= bit;
+        members.push_back({out.size(), out.size() + 2 + 4 * depth, size});
+        out.append('\n');
+        indent();
+        out.append('"');
+        out.append(text, size);
+        out.append("\": ", 3);
+    }
+    
+    void value(qint64 number) {
+        char buffer[24];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+        out.append(buffer, result.ptr - buffer);
+    }
+    
+    // Shortest text that reads back as the same float; number must be finite.
+    void realValue(float number) {
+        char buffer[32];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+        if (std::find(buffer, result.ptr, 'e') != result.ptr) {
+            // QJsonDocument picks exponents by its own rule; spell those its way.
+            out.append(QByteArray::number(faceFeatureValue(number), 'g', QLocale::FloatingPointShortest));
+            return;
+        }
+        out.append(buffer, result.ptr - buffer);
+    }
+    
+    // A string that needs no escaping.
+    template <qsizetype N>
+    void stringValue(const char (&literal)[N]) {
+        out.append('"');
+        out.append(literal, N - 1);
+        out.append('"');
+    }
+    
+    // Already validated JSON text. Objects and arrays are written again
+    // member by member; anything nested too deep for that is copied as is.
+    void rawValue(const JsonKey& raw) {
+        OutfitJsonReader reader(raw.data, raw.data + raw.size);
+        if (!reader.peekObject() && !reader.peekArray()) {
+            out.append(raw.data, raw.size);
+            return;
+        }
+        Mark start = mark();
+        if (!copyValue(reader)) {
+            rollback(start);
+            out.append(raw.data, raw.size);
+        }
+    }
+    
+private:
+    static constexpr int kMaxDepth = 63;
+    
+    struct Member {
+        qsizetype start;  // the '\n' that begins the member, after any ','
+        qsizetype keyStart;
+        qsizetype keySize;
+    };
+    
+    bool copyValue(OutfitJsonReader& reader) {
+        bool object = reader.peekObject();
+        if (!object && !reader.peekArray()) {
+            const char* start = reader.valueStart();
+            if (!reader.skipValue()) return false;
+            out.append(start, reader.position() - start);
+            return true;
+        }
+        if (depth >= kMaxDepth) return false;
+        
+        if (object) {
+            if (!reader.enterObject()) return false;
+            beginObject();
+            JsonKey name;
+            while (reader.nextRawMember(name)) {
+                key(name);
+                if (!copyValue(reader)) return false;
+            }
+            if (reader.failed()) return false;
+            endObject();
+        } else {
+            if (!reader.enterArray()) return false;
+            beginArray();
+            while (reader.nextElement()) {
+                element();
+                if (!copyValue(reader)) return false;
+            }
+            if (reader.failed()) return false;
+            endArray();
+        }
+        return true;
+    }
+    
+    // Puts the members of the object being closed in key order. Each one
+    // runs from its start to the ',' before the next, or to the end, so the
+    // sorted members fill exactly the same bytes.
+    void sortMembers() {
+        std::size_t first = objects.back();
+        objects.pop_back();
+        std::size_t count = members.size() - first;
+        auto keyAt = [this](std::size_t i) {
+            return JsonKey{out.constData() + members[i].keyStart, members[i].keySize};
+        };
+        bool sorted = true;
+        for (std::size_t i = first + 1; i < members.size() && sorted; ++i) {
+            sorted = !(keyAt(i) < keyAt(i - 1));
+        }
+        if (sorted) {
+            members.resize(first);
+            return;
+        }
+        
+        order.resize(count);
+        for (std::size_t i = 0; i < count; ++i) order[i] = first + i;
+        std::stable_sort(order.begin(), order.end(),
+                         [&keyAt](std::size_t a, std::size_t b) { return keyAt(a) < keyAt(b); });
+        
+        qsizetype objectStart = members[first].start;
+        sortScratch.resize(0);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::size_t m = order[i];
+            qsizetype end = m + 1 < members.size() ? members[m + 1].start - 1 : out.size();
+            if (i > 0) sortScratch.append(',');
+            sortScratch.append(out.constData() + members[m].start, end - members[m].start);
+        }
+        std::memcpy(out.data() + objectStart, sortScratch.constData(), sortScratch.size());
+        members.resize(first);
+    }
+    
+    void close(char bracket) {
+        depth--;
+        out.append('\n');
+        indent();
+        out.append(bracket);
+        if (depth == 0) out.append('\n');
+    }
+    
+    void indent() {
+        for (int i = 0; i < depth; ++i) out.append("    ", 4);
+    }
+    
+    QByteArray out;
+    quint64 hasMembers = 0;
+    int depth = 0;
+    std::vector<Member> members;      // of every object still open, outermost first
+    std::vector<std::size_t> objects;  // where each open object's members begin
+    std::vector<std::size_t> order;
+    QByteArray sortScratch;
+};
+
+bool isOneOf(const JsonKey& key, std::initializer_list<const char*> names) {
+    for (const char* name : names) {
+        if (key.size == qsizetype(std::strlen(name)) && std::memcmp(key.data, name, key.size) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Writes "name": { members not in mapped } and reports whether it wrote
+// anything; an empty object is left out, like unmappedFields() would.
+bool writeUnmappedMembers(OutfitJsonWriter& writer, const char* name, const RawMembers& members,
+                          std::initializer_list<const char*> mapped) {
+    OutfitJsonWriter::Mark start = writer.mark();
+    writer.key(name, qsizetype(std::strlen(name)));
+    writer.beginObject();
+    
+    int written = 0;
+    for (const RawMember& member : members) {
+        if (isOneOf(member.key, mapped) || member.key.is("_ext")) continue;
+        writer.key(member.key);
+        writer.rawValue(member.value);
+        written++;
+    }
+    
+    if (written == 0) {
+        writer.rollback(start);
+        return false;
+    }
+    writer.endObject();
+    return true;
+}
+
+// Direct equivalent of unmappedSlotFields() over raw Cherax slot members.
+bool writeCheraxSlotExtras(OutfitJsonWriter& writer, const char* name, const RawMembers& slotMembers,
+                           std::initializer_list<const char*> knownSlots) {
+    OutfitJsonWriter::Mark start = writer.mark();
+    writer.key(name, qsizetype(std::strlen(name)));
+    writer.beginObject();
+    
+    int written = 0;
+    for (const RawMember& slot : slotMembers) {
+        OutfitJsonReader reader(slot.value.data, slot.value.data + slot.value.size);
+        if (!reader.peekObject()) continue;
+        
+        OutfitJsonWriter::Mark slotStart = writer.mark();
+        writer.key(slot.key);
+        bool known = isOneOf(slot.key, knownSlots);
+        if (!known) {
+            writer.rawValue(slot.value);
+        } else {
+            writer.beginObject();
+        }
+        
+        int fields = 0;
+        reader.enterObject();
+        JsonKey field;
+        while (reader.nextMember(field)) {
+            const char* fieldStart = reader.valueStart();
+            reader.skipValue();
+            if (known && isOneOf(field, {"drawable", "texture", "_ext"})) continue;
+            if (known) {
+                writer.key(field);
+                writer.rawValue({fieldStart, reader.position() - fieldStart});
+            }
+            fields++;
+        }
+        
+        if (fields == 0) {
+            writer.rollback(slotStart);
+            continue;
+        }
+        if (known) writer.endObject();
+        written++;
+    }
+    
+    if (written == 0) {
+        writer.rollback(start);
+        return false;
+    }
+    writer.endObject();
+    return true;
+}
+
+// Writes the YimMenu document for a decoded Cherax or Lexis source: the
+// direct equivalent of cheraxToYim()/lexisToYim() plus serialization.
+// Returns false for sources it does not cover.
+bool writeYimJson(OutfitJsonWriter& writer, const DecodedOutfit& decoded) {
+    bool fromCherax = decoded.format == OutfitFormat::Cherax;
+    if (!fromCherax && decoded.format != OutfitFormat::Lexis) return false;
+    // lexisToYim only emits slots when there is an "outfit" to read.
+    if (!fromCherax && !findRawMember(decoded.root, "outfit")) return false;
+    
+    const OutfitData& outfit = decoded.outfit;
+    writer.reset();
+    writer.beginObject();
+    
+    if (outfit.hasModel) {
+        writer.key("model");
+        writer.value(outfit.model);
+    }
+    
+    for (int kind = 0; kind < 2; ++kind) {
+        bool isProp = kind == 1;
+        writer.key(isProp ? "props" : "components", isProp ? 5 : 10);
+        writer.beginObject();
+        int count = isProp ? kPropSlotCount : kComponentSlotCount;
+        for (int i = 0; i < count; ++i) {
+            if (!outfit.hasSlot(isProp, i)) continue;
+            char slotKey[4];
+            auto result = std::to_chars(slotKey, slotKey + sizeof(slotKey), i);
+            writer.key(slotKey, result.ptr - slotKey);
+            writer.beginObject();
+            writer.key("drawable_id");
+            writer.value(outfit.slot(isProp, i).drawable);
+            writer.key("texture_id");
+            writer.value(outfit.slot(isProp, i).texture);
+            writer.endObject();
+        }
+        writer.endObject();
+    }
+    
+    // Blend data and other YimMenu-only fields come back from the side-channel.
+    writer.key("blend_data");
+    if (const RawMember* blendData = findRawMember(decoded.yimRoot, "blend_data")) {
+        writer.rawValue(blendData->value);
+    } else {
+        static const char* const blendKeys[] = {
+            "is_parent", "shape_first_id", "shape_mix", "shape_second_id", "shape_third_id",
+            "skin_first_id", "skin_mix", "skin_second_id", "skin_third_id", "third_mix"};
+        writer.beginObject();
+        for (const char* blendKey : blendKeys) {
+            writer.key(blendKey, qsizetype(std::strlen(blendKey)));
+            writer.value(0);
+        }
+        writer.endObject();
+    }
+    for (const RawMember& member : decoded.yimRoot) {
+        if (member.key.is("blend_data") || (decoded.cheraxFaceMapped && member.key.is("face_features"))) continue;
+        writer.key(member.key);
+        writer.rawValue(member.value);
+    }
+    // The app-private feature array (see Face Data).
+    if (decoded.cheraxFaceMapped) {
+        writer.key("face_features");
+        writer.beginArray();
+        for (float feature : outfit.face.features) {
+            writer.element();
+            writer.realValue(feature);
+        }
+        writer.endArray();
+    }
+    
+    // The source's own leftovers, then every foreign extension it carried.
+    OutfitJsonWriter::Mark extStart = writer.mark();
+    writer.key("_ext");
+    writer.beginObject();
+    
+    OutfitJsonWriter::Mark ownStart = writer.mark();
+    writer.key(fromCherax ? "cherax" : "lexis", fromCherax ? 6 : 5);
+    writer.beginObject();
+    bool ownWritten = false;
+    if (fromCherax) {
+        if (decoded.cheraxFaceMapped) {
+            ownWritten |= writeUnmappedMembers(writer, "root", decoded.root,
+                                               {"format", "model", "components", "props", "face_features"});
+        } else {
+            ownWritten |= writeUnmappedMembers(writer, "root", decoded.root, {"format", "model", "components", "props"});
+        }
+        ownWritten |= writeCheraxSlotExtras(writer, "components", decoded.components,
+            {"Head", "Beard", "Hair", "Torso", "Legs", "Hands", "Feet", "Teeth",
+             "Special", "Special 2", "Decal", "Tuxedo/Jacket Bib"});
+        ownWritten |= writeCheraxSlotExtras(writer, "props", decoded.props,
+            {"Head", "Eyes", "Ears", "Mouth", "Left Hand", "Right Hand", "Left Wrist", "Right Wrist", "Hip"});
+    } else {
+        ownWritten |= writeUnmappedMembers(writer, "root", decoded.root, {"outfit"});
+        ownWritten |= writeUnmappedMembers(writer, "outfit", decoded.lexisOutfit,
+            {"model", "component", "component variation", "prop", "prop variation"});
+    }
+    if (ownWritten) writer.endObject();
+    else writer.rollback(ownStart);
+    
+    int carried = 0;
+    for (const RawMember& member : decoded.extensions) {
+        if (member.key.is("yimmenu")) continue;
+        if (ownWritten && isOneOf(member.key, {fromCherax ? "cherax" : "lexis"})) continue;
+        writer.key(member.key);
+        writer.rawValue(member.value);
+        carried++;
+    }
+    
+    if (ownWritten || carried > 0) writer.endObject();
+    else writer.rollback(extStart);
+    
+    writer.endObject();
+    return true;
+}
+
+// Whether the raw JSON object text has a member called key.
+bool rawObjectHas(const JsonKey& object, const char* key) {
+    qsizetype size = qsizetype(std::strlen(key));
+    OutfitJsonReader reader(object.data, object.data + object.size);
+    if (!reader.peekObject()) return false;
+    reader.enterObject();
+    JsonKey member;
+    while (reader.nextMember(member)) {
+        if (member.size == size && std::memcmp(member.data, key, size) == 0) return true;
+        reader.skipValue();
+    }
+    return false;
+}
+
+bool hasDuplicateKeys(const RawMembers& members) {
+    for (std::size_t i = 0; i < members.size(); ++i) {
+        for (std::size_t j = i + 1; j < members.size(); ++j) {
+            const JsonKey& a = members[i].key;
+            const JsonKey& b = members[j].key;
+            if (a.size == b.size && std::memcmp(a.data, b.data, a.size) == 0) return true;
+        }
+    }
+    return false;
+}
+
+// Every member is a slot number written plainly ("0", not "00" or "+0")
+// and in range: the only keys yimToCherax() and yimToLexis() read alike.
+bool hasPlainSlotKeys(const RawMembers& members, int count) {
+    for (const RawMember& member : members) {
+        const JsonKey& key = member.key;
+        if (key.size == 0 || key.size > 2 || (key.size == 2 && key.data[0] == '0')) return false;
+        int id = 0;
+        for (qsizetype i = 0; i < key.size; ++i) {
+            if (key.data[i] < '0' || key.data[i] > '9') return false;
+            id = id * 10 + (key.data[i] - '0');
+        }
+        if (id >= count) return false;
+    }
+    return true;
+}
+
+// A decoded YimMenu document the direct target writers below cover: no
+// originals of the target (ownKey) to restore, no YimMenu side-channel of
+// its own and no keys the DOM converters would collapse.
+bool isPlainYimSource(const DecodedOutfit& decoded, const char* ownKey) {
+    if (decoded.format != OutfitFormat::YimMenu || hasDuplicateKeys(decoded.root) ||
+        hasDuplicateKeys(decoded.components) || hasDuplicateKeys(decoded.props) ||
+        hasDuplicateKeys(decoded.extensions) ||
+        !hasPlainSlotKeys(decoded.components, kComponentSlotCount) ||
+        !hasPlainSlotKeys(decoded.props, kPropSlotCount)) {
+        return false;
+    }
+    const RawMember* ext = findRawMember(decoded.root, "_ext");
+    return !ext || (!rawObjectHas(ext->value, ownKey) && !rawObjectHas(ext->value, "yimmenu"));
+}
+
+// "_ext" of a target written from a plain YimMenu source, as attachExtensions()
+// with yimExtension() builds it: the source's foreign extensions, then the
+// root fields the target has no place for. Targets that pad missing slots
+// (recordAbsent) also list the slots to drop again.
+void writeYimLeftovers(OutfitJsonWriter& writer, const DecodedOutfit& decoded, bool faceMapped, bool recordAbsent) {
+    OutfitJsonWriter::Mark extStart = writer.mark();
+    writer.key("_ext");
+    writer.beginObject();
+    int written = 0;
+    for (const RawMember& member : decoded.extensions) {
+        writer.key(member.key);
+        writer.rawValue(member.value);
+        written++;
+    }
+    
+    OutfitJsonWriter::Mark ownStart = writer.mark();
+    writer.key("yimmenu");
+    writer.beginObject();
+    bool ownWritten = faceMapped
+        ? writeUnmappedMembers(writer, "root", decoded.root, {"model", "components", "props", "face_features"})
+        : writeUnmappedMembers(writer, "root", decoded.root, {"model", "components", "props"});
+    for (int kind = 0; recordAbsent && kind < 2; ++kind) {
+        bool isProp = kind == 1;
+        int count = isProp ? kPropSlotCount : kComponentSlotCount;
+        quint32 mask = isProp ? decoded.outfit.propMask : decoded.outfit.componentMask;
+        if (!findRawMember(decoded.root, isProp ? "props" : "components") || mask == (1u << count) - 1) continue;
+        writer.key(isProp ? "absent_props" : "absent_components", isProp ? 12 : 17);
+        writer.beginArray();
+        for (int i = 0; i < count; ++i) {
+            if ((mask >> i) & 1u) continue;
+            writer.element();
+            writer.value(i);
+        }
+        writer.endArray();
+        ownWritten = true;
+    }
+    if (ownWritten) {
+        writer.endObject();
+        written++;
+    } else {
+        writer.rollback(ownStart);
+    }
+    
+    if (written > 0) writer.endObject();
+    else writer.rollback(extStart);
+}
+
+// Writes the Cherax document for a decoded YimMenu source: the direct
+// equivalent of yimToCherax() plus serialization. Returns false for
+// sources isPlainYimSource() does not cover.
+bool writeCheraxJson(OutfitJsonWriter& writer, const DecodedOutfit& decoded) {
+    if (!isPlainYimSource(decoded, "cherax")) return false;
+    
+    const OutfitData& outfit = decoded.outfit;
+    writer.reset();
+    writer.beginObject();
+    writer.key("format");
+    writer.stringValue("Cherax Entity");
+    writer.key("type");
+    writer.value(2);
+    if (outfit.hasModel) {
+        writer.key("model");
+        writer.value(outfit.model);
+    }
+    writer.key("baseFlags");
+    writer.value(66855);
+    
+    for (int kind = 0; kind < 2; ++kind) {
+        bool isProp = kind == 1;
+        writer.key(isProp ? "props" : "components", isProp ? 5 : 10);
+        writer.beginObject();
+        int count = isProp ? kPropSlotCount : kComponentSlotCount;
+        for (int i = 0; i < count; ++i) {
+            if (!outfit.hasSlot(isProp, i)) continue;
+            const char* name = isProp ? kCheraxPropNames[i] : kCheraxComponentNames[i];
+            writer.key(name, qsizetype(std::strlen(name)));
+            writer.beginObject();
+            writer.key("drawable");
+            writer.value(outfit.slot(isProp, i).drawable);
+            writer.key("texture");
+            writer.value(outfit.slot(isProp, i).texture);
+            if (!isProp) {
+                writer.key("palette");
+                writer.value(0);
+            }
+            writer.endObject();
+        }
+        writer.endObject();
+    }
+    
+    bool faceMapped = outfit.face.hasFeatures && !isDefaultFace(outfit.face.features);
+    writer.key("face_features");
+    writer.beginObject();
+    for (int i = 0; i < kFaceFeatureCount; ++i) {
+        writer.key(kFaceFeatureNames[i], qsizetype(std::strlen(kFaceFeatureNames[i])));
+        writer.realValue(faceMapped ? outfit.face.features[i] : 0.0f);
+    }
+    writer.endObject();
+    
+    writer.key("primary_hair_tint");
+    writer.value(255);
+    writer.key("secondary_hair_tint");
+    writer.value(255);
+    writer.key("attachments");
+    writer.beginArray();
+    writer.endArray();
+    
+    writeYimLeftovers(writer, decoded, faceMapped, false);
+    writer.endObject();
+    return true;
+}
+
+// Writes the Lexis document for a decoded YimMenu source: the direct
+// equivalent of yimToLexis() plus serialization.
+bool writeLexisJson(OutfitJsonWriter& writer, const DecodedOutfit& decoded) {
+    if (!isPlainYimSource(decoded, "lexis")) return false;
+    
+    const OutfitData& outfit = decoded.outfit;
+    writer.reset();
+    writer.beginObject();
+    writer.key("outfit");
+    writer.beginObject();
+    if (outfit.hasModel) {
+        writer.key("model");
+        writer.value(outfit.model);
+    }
+    
+    // Missing slots are padded: 0 for components, -1 for props.
+    static const char* const arrayKeys[4] = {"component", "component variation", "prop", "prop variation"};
+    for (int array = 0; array < 4; ++array) {
+        bool isProp = array >= 2;
+        bool texture = array % 2 == 1;
+        int count = isProp ? kPropSlotCount : kComponentSlotCount;
+        bool present = findRawMember(decoded.root, isProp ? "props" : "components");
+        writer.key(arrayKeys[array], qsizetype(std::strlen(arrayKeys[array])));
+        writer.beginArray();
+        for (int i = 0; present && i < count; ++i) {
+            writer.element();
+            if (!outfit.hasSlot(isProp, i)) writer.value(isProp ? -1 : 0);
+            else writer.value(texture ? outfit.slot(isProp, i).texture : outfit.slot(isProp, i).drawable);
+        }
+        writer.endArray();
+    }
+    writer.endObject();
+    
+    writeYimLeftovers(writer, decoded, false, true);
+    writer.endObject();
+    return true;
+}
+
+// Stand text for a decoded YimMenu source: the direct equivalent of
+// yimToStand().
+bool writeStandText(QByteArray& out, const DecodedOutfit& decoded) {
+    if (!isPlainYimSource(decoded, "stand")) return false;
+    
+    static const char* const componentNames[kComponentSlotCount] = {
+        "Head", "Mask", "Hair", "Top", "Pants", "Gloves / Torso", "Shoes",
+        "Accessories", "Top 2", "Top 3", "Decals", "Parachute / Bag"};
+    static const std::pair<int, const char*> propNames[] = {
+        {0, "Hat"}, {1, "Glasses"}, {2, "Earwear"}, {6, "Watch"}, {7, "Bracelet"}};
+    
+    const OutfitData& outfit = decoded.outfit;
+    auto writeSlot = [&out, &outfit](bool isProp, int slot, const char* name) {
+        const OutfitSlot& value = outfit.slot(isProp, slot);
+        out.append(name).append(": ").append(QByteArray::number(value.drawable)).append('\n');
+        out.append(name).append(" Variation: ").append(QByteArray::number(value.texture)).append('\n');
+    };
+    
+    out.clear();
+    out.append("Model: ").append(ModelRegistry::label(outfit.hasModel ? outfit.model : 0).toUtf8()).append('\n');
+    for (int i = 0; i < kComponentSlotCount; ++i) {
+        if (outfit.hasSlot(false, i)) writeSlot(false, i, componentNames[i]);
+    }
+    for (const auto& [slot, name] : propNames) {
+        if (outfit.hasSlot(true, slot)) writeSlot(true, slot, name);
+    }
+    return true;
+}
+
+OutfitFormat detectFormatFromData(const QByteArray& data, const QString& filePath,
+                                  std::pmr::memory_resource* scratch = std::pmr::get_default_resource()) {
+    if (filePath.endsWith(".txt", Qt::CaseInsensitive)) {
+        QString content = QString::fromUtf8(data);
+        if (content.contains("Model:") && content.contains("Variation:")) {
+            return OutfitFormat::Stand;
+        }
+        return OutfitFormat::Unknown;
+    }
+    
+    DecodedOutfit decoded(scratch);
+    if (decodeOutfitJson(data, decoded)) {
+        return decoded.format;
+    }
+    
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(data, &error);
+    
+    if (error.error != QJsonParseError::NoError) {
+        return OutfitFormat::Unknown;
+    }
+    
+    QJsonObject obj = doc.object();
+    
+    if (obj.contains("format") && obj["format"].toString() == "Cherax Entity") {
+        return OutfitFormat::Cherax;
+    }
+    
+    if (obj.contains("outfit")) {
+        QJsonObject outfit = obj["outfit"].toObject();
+        if (outfit.contains("component") && outfit.contains("component variation")) {
+            return OutfitFormat::Lexis;
+        }
+    }
+    
+    if (obj.contains("blend_data") && obj.contains("components")) {
+        QJsonObject components = obj["components"].toObject();
+        if (!components.isEmpty()) {
+            QString firstKey = components.keys().first();
+            bool isNumeric = false;
+            firstKey.toInt(&isNumeric);
+            if (isNumeric) {
+                return OutfitFormat::YimMenu;
+            }
+        }
+    }
+    
+    return OutfitFormat::Unknown;
+}
+
+OutfitFormat detectFormat(const QString& filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return OutfitFormat::Unknown;
+    }
+    
+    QByteArray data = file.readAll();
+    file.close();
+    
+    return detectFormatFromData(data, filePath);
+}
+
+// Converts already-loaded file contents to an indented YimMenu document.
+// Returns an empty string for unsupported formats.
+QString convertDataToYim(const QByteArray& data, OutfitFormat fmt) {
+    QJsonObject yimObj;
+    
+    switch (fmt) {
+        case OutfitFormat::Cherax: {
+            QJsonDocument doc = QJsonDocument::fromJson(data);
+            yimObj = cheraxToYim(doc.object());
+            break;
+        }
+        case OutfitFormat::YimMenu: {
+            return QString::fromUtf8(data);
+        }
+        case OutfitFormat::Lexis: {
+            QJsonDocument doc = QJsonDocument::fromJson(data);
+            yimObj = lexisToYim(doc.object());
+            break;
+        }
+        case OutfitFormat::Stand: {
+            return standToYim(QString::fromUtf8(data));
+        }
+        default:
+            return QString();
+    }
+    
+    QJsonDocument doc(yimObj);
+    return QString(doc.toJson(QJsonDocument::Indented));
+}
+
+// UTF-8 YimMenu document for already-loaded file contents; empty for
+// unsupported formats. Cherax and Lexis go through the fast reader and the
+// direct writer, everything else (and input the reader declines) through
+// convertDataToYim(). writer and scratch are reused across calls.
+QByteArray convertDataToYimUtf8(const QByteArray& data, OutfitFormat fmt, OutfitJsonWriter& writer,
+                                std::pmr::memory_resource* scratch = std::pmr::get_default_resource()) {
+    if (fmt == OutfitFormat::YimMenu) {
+        return data;
+    }
+    
+    if (fmt == OutfitFormat::Cherax || fmt == OutfitFormat::Lexis) {
+        DecodedOutfit decoded(scratch);
+        if (decodeOutfitJson(data, decoded, fmt) && writeYimJson(writer, decoded)) {
+            // One exact-size copy; the writer keeps its buffer for the next file.
+            return QByteArray(writer.data().constData(), writer.data().size());
+        }
+    }
+    
+    return convertDataToYim(data, fmt).toUtf8();
+}
+
+// Per-thread writer and arena for conversions that do not own a pipeline
+// worker, such as library calls and server requests. They keep their
+// buffers from one call to the next on the same thread.
+struct ConversionScratch {
+    OutfitJsonWriter writer;
+    ConversionArena arena;
+};
+
+ConversionScratch& conversionScratch() {
+    thread_local ConversionScratch scratch;
+    return scratch;
+}
+
+// Format of in-memory contents without a file name to go by: Stand text is
+// recognized by its content.
+OutfitFormat detectFormatFromBytes(const QByteArray& data, ConversionScratch& scratch) {
+    scratch.arena.reset();
+    OutfitFormat format = detectFormatFromData(data, QString(), scratch.arena.resource());
+    if (format == OutfitFormat::Unknown) format = detectFormatFromData(data, "outfit.txt");
+    return format;
+}
+
+enum class ConvertResult {
+    Ok,
+    Unrecognized,   // source format unknown and not detectable
+    Failed
+};
+
+// Converts in-memory contents between any two formats, through YimMenu when
+// neither side is YimMenu. The YimMenu document is decoded once more by the
+// fast reader and written by the target's direct writer; the DOM converters
+// only see what those writers decline. from Unknown detects the source and
+// reports it back through detected. Same-format input is returned as it is,
+// once detection agrees that it is an outfit in that format.
+ConvertResult convertOutfitBytes(const QByteArray& data, OutfitFormat from, OutfitFormat to,
+                                 ConversionScratch& scratch, QByteArray& result,
+                                 OutfitFormat* detected = nullptr) {
+    OutfitFormat source = from == OutfitFormat::Unknown ? detectFormatFromBytes(data, scratch) : from;
+    if (detected) *detected = source;
+    if (source == OutfitFormat::Unknown) return ConvertResult::Unrecognized;
+    if (source == to) {
+        // A given source format has not been checked yet; detected input has.
+        if (from != OutfitFormat::Unknown) {
+            OutfitFormat actual = detectFormatFromBytes(data, scratch);
+            if (actual == OutfitFormat::Unknown) return ConvertResult::Unrecognized;
+            if (actual != source) return ConvertResult::Failed;
+        }
+        result = data;
+        return ConvertResult::Ok;
+    }
+    
+    scratch.arena.reset();
+    QByteArray yim = convertDataToYimUtf8(data, source, scratch.writer, scratch.arena.resource());
+    if (yim.isEmpty()) return ConvertResult::Failed;
+    if (to == OutfitFormat::YimMenu) {
+        result = std::move(yim);
+        return ConvertResult::Ok;
+    }
+    
+    DecodedOutfit decoded(scratch.arena.resource());
+    if (decodeOutfitJson(yim, decoded, OutfitFormat::YimMenu)) {
+        if (to == OutfitFormat::Stand && writeStandText(result, decoded)) return ConvertResult::Ok;
+        if ((to == OutfitFormat::Cherax && writeCheraxJson(scratch.writer, decoded)) ||
+            (to == OutfitFormat::Lexis && writeLexisJson(scratch.writer, decoded))) {
+            result = QByteArray(scratch.writer.data().constData(), scratch.writer.data().size());
+            return ConvertResult::Ok;
+        }
+    }
+    
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(yim, &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) return ConvertResult::Failed;
+    switch (to) {
+        case OutfitFormat::Cherax:
+            result = QJsonDocument(yimToCherax(doc.object())).toJson(QJsonDocument::Indented);
+            return ConvertResult::Ok;
+        case OutfitFormat::Lexis:
+            result = QJsonDocument(yimToLexis(doc.object())).toJson(QJsonDocument::Indented);
+            return ConvertResult::Ok;
+        case OutfitFormat::Stand:
+            result = yimToStand(doc.object()).toUtf8();
+            return ConvertResult::Ok;
+        default:
+            return ConvertResult::Failed;
+    }
+}
+
+bool isOutfitFileName(const QString& filePath) {
+    return filePath.endsWith(".json", Qt::CaseInsensitive) ||
+           filePath.endsWith(".txt", Qt::CaseInsensitive);
+}
+
+#ifdef OUTFIT_CORE_LIBRARY
+// C API
+// outfit_converter.h over convertOutfitBytes(), for the OutfitConverterCore
+// shared library. Each calling thread converts with its own scratch, so
+// repeated calls reuse their buffers and nothing is set up globally.
+#include "outfit_converter.h"
+
+static_assert(int(OutfitFormat::Unknown) == OUTFIT_FORMAT_UNKNOWN && int(OutfitFormat::Cherax) == OUTFIT_FORMAT_CHERAX &&
+              int(OutfitFormat::YimMenu) == OUTFIT_FORMAT_YIMMENU && int(OutfitFormat::Lexis) == OUTFIT_FORMAT_LEXIS &&
+              int(OutfitFormat::Stand) == OUTFIT_FORMAT_STAND,
+              "outfit_format values must match OutfitFormat");
+
+static bool isApiFormat(outfit_format format) {
+    return format >= OUTFIT_FORMAT_UNKNOWN && format <= OUTFIT_FORMAT_STAND;
+}
+
+static outfit_status convertApiBuffer(const char* input, size_t inputSize, outfit_format from, outfit_format to,
+                                      QByteArray& result) {
+    if ((!input && inputSize > 0) || !isApiFormat(from) || !isApiFormat(to) || to == OUTFIT_FORMAT_UNKNOWN) {
+        return OUTFIT_ERROR_ARGUMENT;
+    }
+    
+    // Read the caller's bytes in place rather than copying them.
+    const QByteArray data = QByteArray::fromRawData(input, qsizetype(inputSize));
+    switch (convertOutfitBytes(data, OutfitFormat(from), OutfitFormat(to), conversionScratch(), result)) {
+        case ConvertResult::Ok:
+            return OUTFIT_OK;
+        case ConvertResult::Unrecognized:
+            return OUTFIT_ERROR_UNRECOGNIZED;
+        default:
+            return OUTFIT_ERROR_CONVERSION;
+    }
+}
+
+static outfit_status copyApiResult(const QByteArray& result, char* output, size_t capacity, size_t* outputSize) {
+    *outputSize = size_t(result.size());
+    if (*outputSize > capacity) return OUTFIT_ERROR_BUFFER_TOO_SMALL;
+    if (*outputSize == 0) return OUTFIT_OK;
+    if (!output) return OUTFIT_ERROR_ARGUMENT;
+    // Same-format results still point into the input, which may overlap output.
+    std::memmove(output, result.constData(), *outputSize);
+    return OUTFIT_OK;
+}
+
+extern "C" {
+
+int outfit_api_version(void) {
+    return OUTFIT_API_VERSION;
+}
+
+outfit_format outfit_detect_format(const char* data, size_t size) {
+    if (!data) return OUTFIT_FORMAT_UNKNOWN;
+    return outfit_format(detectFormatFromBytes(QByteArray::fromRawData(data, qsizetype(size)), conversionScratch()));
+}
+
+outfit_status outfit_convert(const char* input, size_t input_size, outfit_format from, outfit_format to,
+                             char* output, size_t output_capacity, size_t* output_size) {
+    if (!output_size) return OUTFIT_ERROR_ARGUMENT;
+    
+    QByteArray result;
+    outfit_status status = convertApiBuffer(input, input_size, from, to, result);
+    if (status != OUTFIT_OK) {
+        *output_size = 0;
+        return status;
+    }
+    return copyApiResult(result, output, output_capacity, output_size);
+}
+
+size_t outfit_convert_batch(outfit_batch_item* items, size_t count, outfit_format to, int threads) {
+    if (!items || count == 0) return 0;
+    
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> converted{0};
+    auto work = [&]() {
+        QByteArray result;
+        for (size_t index = next++; index < count; index = next++) {
+            outfit_batch_item& item = items[index];
+            item.status = convertApiBuffer(item.input, item.input_size, item.from, to, result);
+            if (item.status == OUTFIT_OK) {
+                item.status = copyApiResult(result, item.output, item.output_capacity, &item.output_size);
+            } else {
+                item.output_size = 0;
+            }
+            if (item.status == OUTFIT_OK) converted++;
+        }
+    };
+    
+    int workers = threads > 0 ? threads : qMax(1, QThread::idealThreadCount());
+    workers = int(qMin(size_t(workers), count));
+    if (workers == 1) {
+        work();
+        return converted.load();
+    }
+    
+    QThreadPool pool;
+    pool.setMaxThreadCount(workers);
+    for (int i = 0; i < workers; ++i) {
+        pool.start(work);
+    }
+    pool.waitForDone();
+    return converted.load();
+}
+
+}
+#endif
+
+// Everything from here on is the application itself: file output, the
+// library, the GUI and the command line. The core library stops above.
+#ifndef OUTFIT_CORE_LIBRARY
+
+// Output Writer
+// Every outfit written by the app goes through here. Data lands in a hidden
+// ".<name>.<n>.part" file next to the target and is renamed over it, so an
+// interrupted run leaves either the old file or the new one, never a
+// truncated outfit. Durable mode also fsyncs each file before the rename and
+// batches the directory fsync that makes the renames themselves persistent.
+class OutputWriter {
+public:
+    // The writes one caller queued. flush() waits for and reports only its
+    // own group, so a batch and a GUI export running at once never see each
+    // other's failures or wait on each other's files. A group given a byte
+    // budget is held to that alone; others share the writer-wide one.
+    class Group {
+    public:
+        explicit Group(qint64 maxQueuedBytes = 0) : maxQueuedBytes(maxQueuedBytes) {}
+        Group(const Group&) = delete;
+        Group& operator=(const Group&) = delete;
+        ~Group() { OutputWriter::instance().flush(*this); }
+        
+    private:
+        friend class OutputWriter;
+        const qint64 maxQueuedBytes;  // 0 = the writer-wide budget
+        qint64 queuedBytes = 0;
+        int inFlight = 0;
+        QHash<QString, int> unsyncedDirs;
+        QStringList failures;
+    };
+    
+    static OutputWriter& instance() {
+        static OutputWriter writer;
+        return writer;
+    }
+    
+    ~OutputWriter() {
+        QMutexLocker locker(&mutex);
+        while (inFlight > 0) {
+            drained.wait(&mutex);
+        }
+    }
+    
+    void setDurable(bool enabled) { durable.store(enabled); }
+    bool isDurable() const { return durable.load(); }
+    
+    // Atomically replaces filePath on the calling thread.
+    bool write(const QString& filePath, const QByteArray& data) {
+        bool ok = commit(filePath, data);
+        if (ok && durable.load()) {
+            ok = syncDirectory(QFileInfo(filePath).absolutePath());
+        }
+        return ok;
+    }
+    
+    // Queues filePath for the I/O pool as part of group. Blocks while too much
+    // data is already waiting so bulk exports cannot outrun the disk. onDone
+    // runs on the I/O thread once the file is in place (or failed).
+    void enqueue(Group& group, const QString& filePath, const QByteArray& data,
+                 std::function<void(bool)> onDone = nullptr) {
+        {
+            QMutexLocker locker(&mutex);
+            if (group.maxQueuedBytes > 0) {
+                while (group.queuedBytes > 0 && group.queuedBytes + data.size() > group.maxQueuedBytes) {
+                    drained.wait(&mutex);
+                }
+            } else {
+                while (queuedBytes > 0 && queuedBytes + data.size() > kDefaultMaxQueuedBytes) {
+                    drained.wait(&mutex);
+                }
+            }
+            queuedBytes += data.size();
+            group.queuedBytes += data.size();
+            inFlight++;
+            group.inFlight++;
+            pendingPaths.insert(filePath);
+        }
+        
+        pool.start([this, &group, filePath, data, onDone]() {
+            bool ok = commit(filePath, data);
+            if (onDone) onDone(ok);
+            
+            QString dirToSync;
+            QMutexLocker locker(&mutex);
+            if (!ok) {
+                group.failures.append(filePath);
+            } else if (durable.load()) {
+                QString dirPath = QFileInfo(filePath).absolutePath();
+                if (++group.unsyncedDirs[dirPath] >= kDirectorySyncBatch) {
+                    group.unsyncedDirs.remove(dirPath);
+                    dirToSync = dirPath;
+                }
+            }
+            
+            if (!dirToSync.isEmpty()) {
+                locker.unlock();
+                syncDirectory(dirToSync);
+                locker.relock();
+            }
+            
+            pendingPaths.remove(filePath);
+            queuedBytes -= data.size();
+            group.queuedBytes -= data.size();
+            inFlight--;
+            group.inFlight--;
+            drained.wakeAll();
+        });
+    }
+    
+    // True while filePath is queued but not yet renamed into place.
+    bool isPending(const QString& filePath) {
+        QMutexLocker locker(&mutex);
+        return pendingPaths.contains(filePath);
+    }
+    
+    // Waits for every write queued in group, syncs the directories it touched
+    // in durable mode and returns (and forgets) the paths that failed.
+    QStringList flush(Group& group) {
+        QMutexLocker locker(&mutex);
+        while (group.inFlight > 0) {
+            drained.wait(&mutex);
+        }
+        
+        const QStringList dirs = group.unsyncedDirs.keys();
+        group.unsyncedDirs.clear();
+        QStringList failed = group.failures;
+        group.failures.clear();
+        locker.unlock();
+        
+        for (const QString& dirPath : dirs) {
+            syncDirectory(dirPath);
+        }
+        return failed;
+    }
+    
+    // Removes temp files left behind by a crashed run. Recent ones are kept
+    // because another instance may still be writing them.
+    static void removeStaleTempFiles(const QString& dirPath) {
+        QDateTime cutoff = QDateTime::currentDateTime().addSecs(-600);
+        const QFileInfoList temps = QDir(dirPath).entryInfoList(QStringList() << ".*.part",
+                                                                QDir::Files | QDir::Hidden);
+        for (const QFileInfo& info : temps) {
+            if (info.lastModified() < cutoff) {
+                QFile::remove(info.absoluteFilePath());
+            }
+        }
+    }
+    
+private:
+    OutputWriter() {
+        pool.setMaxThreadCount(qBound(2, QThread::idealThreadCount() / 2, 4));
+    }
+    
+    static constexpr qint64 kDefaultMaxQueuedBytes = 64 * 1024 * 1024;
+    static constexpr int kDirectorySyncBatch = 256;
+    
+    bool commit(const QString& filePath, const QByteArray& data) {
+        QFileInfo info(filePath);
+        // Re-syncing an unchanged outfit leaves the file (and its mtime) alone.
+        if (hasContent(info, data)) {
+            return true;
+        }
+        
+        QString tempPath = info.absolutePath() + "/." + info.fileName() + "." +
+                           QString::number(tempCounter.fetch_add(1)) + ".part";
+        
+        QFile file(tempPath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            return false;
+        }
+        
+        bool ok = file.write(data) == data.size() && file.flush();
+        if (ok && durable.load()) {
+            ok = syncFile(file);
+        }
+        file.close();
+        
+        if (!ok || !replaceFile(tempPath, filePath)) {
+            QFile::remove(tempPath);
+            return false;
+        }
+        return true;
+    }
+    
+    static bool hasContent(const QFileInfo& info, const QByteArray& data) {
+        if (!info.exists() || info.size() != data.size()) {
+            return false;
+        }
+        QFile existing(info.absoluteFilePath());
+        return existing.open(QIODevice::ReadOnly) && existing.readAll() == data;
+    }
+    
+    static bool syncFile(QFile& file) {
+#ifdef _WIN32
+        return _commit(file.handle()) == 0;
+#else
+        return ::fsync(file.handle()) == 0;
+#endif
+    }
+    
+    static bool syncDirectory(const QString& dirPath) {
+#ifdef _WIN32
+        // Renames are issued with MOVEFILE_WRITE_THROUGH instead.
+        Q_UNUSED(dirPath);
+        return true;
+#else
+        int fd = ::open(QFile::encodeName(dirPath).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) return false;
+        bool ok = ::fsync(fd) == 0;
+        ::close(fd);
+        return ok;
+#endif
+    }
+    
+    bool replaceFile(const QString& from, const QString& to) {
+#ifdef _WIN32
+        DWORD flags = MOVEFILE_REPLACE_EXISTING;
+        if (durable.load()) flags |= MOVEFILE_WRITE_THROUGH;
+        return MoveFileExW(reinterpret_cast<LPCWSTR>(QDir::toNativeSeparators(from).utf16()),
+                           reinterpret_cast<LPCWSTR>(QDir::toNativeSeparators(to).utf16()), flags) != 0;
+#else
+        return ::rename(QFile::encodeName(from).constData(), QFile::encodeName(to).constData()) == 0;
+#endif
+    }
+    
+    QThreadPool pool;
+    QMutex mutex;
+    QWaitCondition drained;
+    qint64 queuedBytes = 0;
+    int inFlight = 0;
+    QSet<QString> pendingPaths;
+    std::atomic<bool> durable{false};
+    std::atomic<quint64> tempCounter{0};
+};
+
+QString outputRootPath() {
+    return QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/OutfitConverter";
+}
+
+void ensureOutputDirectories() {
+    QDir dir;
+    QStringList folders = {"Cherax", "YimMenu", "Lexis", "Stand"};
+    
+    for (const QString& folder : folders) {
+        QString path = outputRootPath() + "/" + folder;
+        if (!dir.exists(path)) {
+            dir.mkpath(path);
+        }
+        OutputWriter::removeStaleTempFiles(path);
+    }
+}
+
+// 64-bit FNV-1a; cheap enough to fingerprint every input of a batch.
+quint64 contentHash64(const QByteArray& data) {
+    quint64 hash = 14695981039346656037ULL;
+    for (char c : data) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+QString hashToHex(quint64 hash) {
+    return QString::number(hash, 16).rightJustified(16, '0');
+}
+
+// Slot Limits
+// How many drawables and textures the game has in each slot of a model, so
+// outfits are checked at conversion time instead of failing in a session.
+// The built-in table covers the freemode models; a slot_limits.json in the
+// output folder overrides it or adds ped models after a game update:
+//
+//   {"male": {"components": {"11": [520, 32]}, "props": {"0": [210, 32]}},
+//    "-1667301416": {"components": {"4": [210, 32]}},
+//    "player_zero": {"components": {"3": [40, 16]}}}
+//
+// Counts are exclusive (drawable 0..count-1 is valid). A prop slot with no
+// drawables is one the model cannot wear props in at all.
+struct SlotLimit {
+    qint16 drawables = 0;
+    qint16 textures = 0;
+};
+
+struct ModelSlotLimits {
+    SlotLimit components[kComponentSlotCount];
+    SlotLimit props[kPropSlotCount];
+    
+    const SlotLimit& slot(bool isProp, int index) const {
+        return isProp ? props[index] : components[index];
+    }
+    SlotLimit& slot(bool isProp, int index) {
+        return isProp ? props[index] : components[index];
+    }
+};
+
+// Per-slot counts for the two freemode models, as the game reports them with
+// GET_NUMBER_OF_PED_DRAWABLE_VARIATIONS / _TEXTURE_VARIATIONS and their prop
+// counterparts, rounded up; the texture counts are the highest any drawable
+// in the slot has. They go stale as game updates add clothing, which is
+// what slot_limits.json is for.
+constexpr ModelSlotLimits kFreemodeMaleLimits = {
+    {{46, 3}, {230, 26}, {84, 8}, {210, 26}, {180, 26}, {115, 26},
+     {140, 26}, {175, 26}, {200, 26}, {60, 26}, {200, 26}, {500, 26}},
+    {{200, 26}, {50, 26}, {45, 26}, {0, 0}, {0, 0}, {0, 0}, {45, 26}, {15, 26}, {0, 0}}};
+
+constexpr ModelSlotLimits kFreemodeFemaleLimits = {
+    {{46, 3}, {230, 26}, {88, 8}, {250, 26}, {200, 26}, {115, 26},
+     {150, 26}, {140, 26}, {250, 26}, {60, 26}, {220, 26}, {530, 26}},
+    {{210, 26}, {55, 26}, {25, 26}, {0, 0}, {0, 0}, {0, 0}, {30, 26}, {25, 26}, {0, 0}}};
+
+class SlotLimits {
+public:
+    static QString overridePath() {
+        return outputRootPath() + "/slot_limits.json";
+    }
+    
+    static SlotLimits builtIn() {
+        SlotLimits limits;
+        limits.models.insert(kFreemodeMaleModel, kFreemodeMaleLimits);
+        limits.models.insert(kFreemodeFemaleModel, kFreemodeFemaleLimits);
+        return limits;
+    }
+    
+    // The built-in table with path applied on top. A missing file is not an
+    // error; a malformed one leaves the built-in table and sets error.
+    static SlotLimits load(const QString& path, QString* error = nullptr) {
+        SlotLimits limits = builtIn();
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) return limits;
+        
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+        if (!doc.isObject()) {
+            if (error) *error = path + ": " + parseError.errorString();
+            return limits;
+        }
+        
+        const QJsonObject root = doc.object();
+        for (auto model = root.begin(); model != root.end(); ++model) {
+            qint64 hash = 0;
+            if (!ModelRegistry::parse(model.key(), hash)) continue;
+            ModelSlotLimits& table = limits.models[hash];
+            const QJsonObject groups = model.value().toObject();
+            for (int isProp = 0; isProp < 2; ++isProp) {
+                const QJsonObject slotCounts = groups.value(isProp ? "props" : "components").toObject();
+                int slotCount = isProp ? kPropSlotCount : kComponentSlotCount;
+                for (auto it = slotCounts.begin(); it != slotCounts.end(); ++it) {
+                    int slot = it.key().toInt();
+                    QJsonArray counts = it.value().toArray();
+                    if (slot < 0 || slot >= slotCount || counts.size() != 2) continue;
+                    table.slot(isProp, slot) = {qint16(qBound(0, counts[0].toInt(), 32767)),
+                                                qint16(qBound(0, counts[1].toInt(), 32767))};
+                }
+            }
+        }
+        return limits;
+    }
+    
+    // nullptr for models without a table; only their structure is checked.
+    const ModelSlotLimits* find(qint64 model) const {
+        auto it = models.constFind(model);
+        return it == models.constEnd() ? nullptr : &it.value();
+    }
+    
+private:
+    QHash<qint64, ModelSlotLimits> models;
+};
+
+struct SlotIssue {
+    enum class Kind : quint8 { Drawable, Texture, NoProps };
+    
+    Kind kind = Kind::Drawable;
+    bool isProp = false;
+    qint8 slot = 0;
+    OutfitSlot value;
+    SlotLimit limit;
+    
+    QString describe() const {
+        QString name = isProp ? kPropSlotNames[slot] : kComponentSlotNames[slot];
+        switch (kind) {
+            case Kind::Drawable:
+                return QString("%1 drawable %2 is out of range (%3 available)").arg(name).arg(value.drawable).arg(limit.drawables);
+            case Kind::Texture:
+                return QString("%1 texture %2 is out of range (%3 available)").arg(name).arg(value.texture).arg(limit.textures);
+            case Kind::NoProps:
+                return QString("%1 cannot hold a prop on this model").arg(name);
+        }
+        return QString();
+    }
+};
+
+using SlotIssues = QVector<SlotIssue>;
+
+// Checks every slot of outfit against the limits for its model and appends
+// what is wrong to issues. Each slot is checked on its own; the only prop
+// rule is that a prop slot the model has no props for stays empty, and no
+// combinations of slots are checked. Models without a table only get the
+// checks that hold for any ped: no negative textures on a worn slot and no
+// prop drawable below -1. Returns true when the outfit is valid.
+bool validateOutfit(const OutfitData& outfit, const SlotLimits& limits, SlotIssues* issues = nullptr) {
+    const ModelSlotLimits* table = outfit.hasModel ? limits.find(outfit.model) : nullptr;
+    bool valid = true;
+    auto flag = [&](SlotIssue::Kind kind, bool isProp, int slot, const OutfitSlot& value) {
+        valid = false;
+        if (issues) issues->append({kind, isProp, qint8(slot), value, table ? table->slot(isProp, slot) : SlotLimit()});
+    };
+    
+    for (int isProp = 0; isProp < 2; ++isProp) {
+        int slotCount = isProp ? kPropSlotCount : kComponentSlotCount;
+        for (int slot = 0; slot < slotCount; ++slot) {
+            if (!outfit.hasSlot(isProp, slot)) continue;
+            const OutfitSlot& value = outfit.slot(isProp, slot);
+            
+            // A prop drawable of -1 takes the prop off; its texture is ignored.
+            if (isProp && value.drawable == -1) continue;
+            if (value.drawable < (isProp ? -1 : 0) && (table || isProp)) {
+                flag(SlotIssue::Kind::Drawable, isProp, slot, value);
+                continue;
+            }
+            if (value.drawable >= 0 && value.texture < 0) {
+                flag(SlotIssue::Kind::Texture, isProp, slot, value);
+                continue;
+            }
+            if (!table) continue;
+            
+            const SlotLimit& limit = table->slot(isProp, slot);
+            if (isProp && limit.drawables == 0) {
+                flag(SlotIssue::Kind::NoProps, isProp, slot, value);
+            } else if (value.drawable >= limit.drawables) {
+                flag(SlotIssue::Kind::Drawable, isProp, slot, value);
+            } else if (value.texture >= limit.textures) {
+                flag(SlotIssue::Kind::Texture, isProp, slot, value);
+            }
+        }
+    }
+    return valid;
+}
+
+QString describeIssues(const SlotIssues& issues) {
+    QStringList lines;
+    for (const SlotIssue& issue : issues) {
+        lines.append(issue.describe());
+    }
+    return lines.join("; ");
+}
+
+struct LibraryValidation {
+    QString name;
+    bool unreadable = false;
+    SlotIssues issues;
+};
+
+// Validates one YimMenu outfit into result, setting result.name only when
+// the outfit is invalid or cannot be read.
+void validateLibraryOutfit(const QString& name, const QByteArray& bytes, const SlotLimits& limits,
+                           ConversionArena& arena, LibraryValidation& result) {
+    arena.reset();
+    DecodedOutfit decoded(arena.resource());
+    if (!decodeOutfitJson(bytes, decoded, OutfitFormat::YimMenu)) {
+        QJsonDocument doc = QJsonDocument::fromJson(bytes);
+        if (!doc.isObject()) {
+            result.name = name;
+            result.unreadable = true;
+            return;
+        }
+        decoded.outfit = outfitDataFromYim(doc.object());
+    }
+    if (!validateOutfit(decoded.outfit, limits, &result.issues)) result.name = name;
+}
+
+void sortValidationsByName(QVector<LibraryValidation>& results) {
+    std::sort(results.begin(), results.end(), [](const LibraryValidation& a, const LibraryValidation& b) {
+        return a.name.compare(b.name, Qt::CaseInsensitive) < 0;
+    });
+}
+
+// Validates every outfit file in libraryPath on all cores and returns the
+// ones that are invalid or cannot be read, sorted by name.
+QVector<LibraryValidation> validateLibrary(const QString& libraryPath, const SlotLimits& limits) {
+    QStringList paths;
+    QDirIterator it(libraryPath, QStringList() << "*.json", QDir::Files);
+    while (it.hasNext()) {
+        paths.append(it.next());
+    }
+    
+    QVector<LibraryValidation> results(paths.size());
+    LibraryValidation* entries = results.data();
+    std::atomic<int> next{0};
+    
+    QThreadPool pool;
+    int workers = qMin(qMax(1, QThread::idealThreadCount()), qMax(1, int(paths.size())));
+    for (int i = 0; i < workers; ++i) {
+        pool.start([&]() {
+            ConversionArena arena;
+            for (int index = next++; index < paths.size(); index = next++) {
+                LibraryValidation& result = entries[index];
+                QFile file(paths[index]);
+                if (!file.open(QIODevice::ReadOnly)) {
+                    result.name = QFileInfo(paths[index]).completeBaseName();
+                    result.unreadable = true;
+                    continue;
+                }
+                QByteArray bytes = file.readAll();
+                file.close();
+                validateLibraryOutfit(QFileInfo(paths[index]).completeBaseName(), bytes, limits, arena, result);
+            }
+        });
+    }
+    pool.waitForDone();
+    
+    QVector<LibraryValidation> invalid;
+    for (LibraryValidation& result : results) {
+        if (!result.name.isEmpty()) invalid.append(std::move(result));
+    }
+    sortValidationsByName(invalid);
+    return invalid;
+}
+
+// Output Path Templates
+// Where converted outfits land inside the output folder: the default
+// "{name}_converted.json", or layouts such as "{model}/{name}.json" and
+// "{shard}/{name}.json" for libraries too large for one flat directory.
+// A template is compiled once into literal and variable segments; resolving
+// it for a file appends those segments into a buffer the caller reuses.
+//
+//   {name}     input file name without extension
+//   {src_dir}  name of the folder the input came from
+//   {format}   source format (Cherax, YimMenu, Lexis, Stand)
+//   {target}   target format
+//   {ext}      extension of the target format (json or txt)
+//   {model}    male, female, a known ped's spawn name, the hash, or unknown
+//   {hash}     16 hex digits of the input's content hash
+//   {shard}    "ab/cd": two directory levels taken from a hash of {name}
+const QString kDefaultPathTemplate = "{name}_converted.json";
+const QString kPathTemplateHelp = "Path of each converted file inside the output folder.\n"
+                                  "Variables: {name} {src_dir} {format} {target} {ext} {model} {hash} {shard}\n"
+                                  "e.g. {model}/{name}.json or {shard}/{name}.json";
+
+struct PathContext {
+    QStringView name;
+    QStringView sourceDir;
+    OutfitFormat format = OutfitFormat::Unknown;
+    OutfitFormat target = OutfitFormat::YimMenu;
+    quint64 hash = 0;
+    bool hasModel = false;
+    qint64 model = 0;
+};
+
+class PathTemplate {
+public:
+    // An invalid template (check isValid()) when pattern does not parse;
+    // error then says why.
+    static PathTemplate compile(const QString& pattern, QString* error = nullptr) {
+        static const QHash<QString, Variable> variables = {
+            {"name", Variable::Name}, {"src_dir", Variable::SourceDir}, {"format", Variable::Format},
+            {"target", Variable::Target}, {"ext", Variable::Extension}, {"model", Variable::Model},
+            {"hash", Variable::Hash}, {"shard", Variable::Shard}};
+        
+        PathTemplate result;
+        result.source = pattern;
+        auto fail = [&](const QString& message) {
+            if (error) *error = message;
+            result.segments.clear();
+            return result;
+        };
+        
+        if (pattern.isEmpty()) return fail("The output layout is empty");
+        if (pattern.startsWith('/') || pattern.startsWith('\\') || pattern.contains(':')) {
+            return fail("The output layout must be relative to the output folder");
+        }
+        if (pattern.endsWith('/')) return fail("The output layout must end in a file name");
+        // Windows refuses these in file names; reject them up front rather
+        // than failing every write of the batch.
+        static const QString reserved = "<>\"|?*";
+        for (QChar c : pattern) {
+            if (c.unicode() < 0x20 || reserved.contains(c)) {
+                return fail("The output layout cannot contain < > : \" | ? * or control characters");
+            }
+        }
+        
+        bool unique = false;
+        QString literal;
+        for (int i = 0; i < pattern.size(); ++i) {
+            QChar c = pattern[i];
+            if (c == '}') return fail("Unmatched } in the output layout");
+            if (c != '{') {
+                literal.append(c == '\\' ? QChar('/') : c);
+                continue;
+            }
+            
+            int end = pattern.indexOf('}', i);
+            if (end < 0) return fail("Unmatched { in the output layout");
+            QString name = pattern.mid(i + 1, end - i - 1);
+            auto it = variables.constFind(name);
+            if (it == variables.constEnd()) return fail("Unknown variable {" + name + "} in the output layout");
+            
+            if (!literal.isEmpty()) result.segments.append({Variable::Literal, literal});
+            literal.clear();
+            result.segments.append({it.value(), QString()});
+            result.needsModel |= it.value() == Variable::Model;
+            unique |= it.value() == Variable::Name || it.value() == Variable::Hash;
+            i = end;
+        }
+        if (!literal.isEmpty()) result.segments.append({Variable::Literal, literal});
+        
+        if (!unique) return fail("The output layout needs {name} or {hash} to tell outfits apart");
+        for (const Segment& segment : result.segments) {
+            if (segment.variable == Variable::Literal && segment.literal.split('/').contains("..")) {
+                return fail("The output layout must stay inside the output folder");
+            }
+        }
+        return result;
+    }
+    
+    bool isValid() const { return !segments.isEmpty(); }
+    bool usesModel() const { return needsModel; }
+    const QString& pattern() const { return source; }
+    
+    // Writes the relative output path for context into out, reusing its capacity.
+    void resolve(const PathContext& context, QString& out) const {
+        out.resize(0);
+        for (const Segment& segment : segments) {
+            switch (segment.variable) {
+                case Variable::Literal:
+                    out.append(segment.literal);
+                    break;
+                case Variable::Name:
+                    out.append(context.name);
+                    break;
+                case Variable::SourceDir:
+                    out.append(context.sourceDir.isEmpty() ? QStringView(u"root") : context.sourceDir);
+                    break;
+                case Variable::Format:
+                    out.append(formatName(context.format));
+                    break;
+                case Variable::Target:
+                    out.append(formatName(context.target));
+                    break;
+                case Variable::Extension:
+                    out.append(context.target == OutfitFormat::Stand ? "txt" : "json");
+                    break;
+                case Variable::Model:
+                    if (!context.hasModel) out.append("unknown");
+                    else if (context.model == kFreemodeMaleModel) out.append("male");
+                    else if (context.model == kFreemodeFemaleModel) out.append("female");
+                    else if (const PedModel* ped = ModelRegistry::find(context.model)) out.append(ped->name);
+                    else out.append(QString::number(context.model));
+                    break;
+                case Variable::Hash:
+                    appendHex(out, context.hash, 16);
+                    break;
+                case Variable::Shard: {
+                    // FNV-1a over the UTF-16 name: stable across runs, unlike qHash().
+                    quint64 hash = 14695981039346656037ULL;
+                    for (QChar c : context.name) {
+                        hash ^= c.unicode();
+                        hash *= 1099511628211ULL;
+                    }
+                    appendHex(out, hash >> 56, 2);
+                    out.append('/');
+                    appendHex(out, (hash >> 48) & 0xff, 2);
+                    break;
+                }
+            }
+        }
+    }
+    
+private:
+    enum class Variable : quint8 { Literal, Name, SourceDir, Format, Target, Extension, Model, Hash, Shard };
+    
+    struct Segment {
+        Variable variable;
+        QString literal;
+    };
+    
+    static QStringView formatName(OutfitFormat format) {
+        switch (format) {
+            case OutfitFormat::Cherax: return u"Cherax";
+            case OutfitFormat::YimMenu: return u"YimMenu";
+            case OutfitFormat::Lexis: return u"Lexis";
+            case OutfitFormat::Stand: return u"Stand";
+            default: return u"Unknown";
+        }
+    }
+    
+    static void appendHex(QString& out, quint64 value, int digits) {
+        static const char16_t hexDigits[] = u"0123456789abcdef";
+        for (int shift = (digits - 1) * 4; shift >= 0; shift -= 4) {
+            out.append(QChar(hexDigits[(value >> shift) & 0xf]));
+        }
+    }
+    
+    QVector<Segment> segments;
+    QString source;
+    bool needsModel = false;
+};
+
+// The file name and folder name of path as views into it.
+PathContext pathContextFor(const QString& path) {
+    PathContext context;
+    QStringView view(path);
+    qsizetype slash = view.lastIndexOf('/');
+    QStringView fileName = view.mid(slash + 1);
+    qsizetype dot = fileName.indexOf('.');
+    context.name = dot < 0 ? fileName : fileName.left(dot);
+    if (slash > 0) {
+        QStringView dir = view.left(slash);
+        context.sourceDir = dir.mid(dir.lastIndexOf('/') + 1);
+    }
+    return context;
+}
+
+// Returns candidate, or "<stem>_N.<ext>" when earlier conversions already
+// exist there, are still queued for writing or were claimed by the caller.
+QString uniqueOutputPath(const QString& candidate, const QSet<QString>* claimed = nullptr) {
+    auto isTaken = [claimed](const QString& path) {
+        return QFile::exists(path) || OutputWriter::instance().isPending(path) ||
+               (claimed && claimed->contains(path));
+    };
+    if (!isTaken(candidate)) {
+        return candidate;
+    }
+    
+    qsizetype dot = candidate.lastIndexOf('.');
+    if (dot < candidate.lastIndexOf('/')) dot = candidate.size();
+    QString stem = candidate.left(dot);
+    QString extension = candidate.mid(dot);
+    for (int counter = 1;; ++counter) {
+        QString path = stem + "_" + QString::number(counter) + extension;
+        if (!isTaken(path)) return path;
+    }
+}
+
+// Whether path is candidate itself or one of the _N names uniqueOutputPath()
+// falls back to for it.
+bool isOutputPathFor(const QString& path, const QString& candidate) {
+    if (path == candidate) return true;
+    
+    qsizetype dot = candidate.lastIndexOf('.');
+    if (dot < candidate.lastIndexOf('/')) dot = candidate.size();
+    QStringView stem = QStringView(candidate).left(dot);
+    QStringView extension = QStringView(candidate).mid(dot);
+    if (!path.startsWith(stem) || !path.endsWith(extension)) return false;
+    
+    QStringView middle = QStringView(path).mid(stem.size(), path.size() - stem.size() - extension.size());
+    if (middle.size() < 2 || middle[0] != '_') return false;
+    for (QChar c : middle.mid(1)) {
+        if (!c.isDigit()) return false;
+    }
+    return true;
+}
+
+OutfitFormat formatFromName(const QString& name) {
+    if (name == "Cherax") return OutfitFormat::Cherax;
+    if (name == "YimMenu") return OutfitFormat::YimMenu;
+    if (name == "Lexis") return OutfitFormat::Lexis;
+    if (name == "Stand") return OutfitFormat::Stand;
+    return OutfitFormat::Unknown;
+}
+
+QString formatName(OutfitFormat format) {
+    switch (format) {
+        case OutfitFormat::Cherax: return "Cherax";
+        case OutfitFormat::YimMenu: return "YimMenu";
+        case OutfitFormat::Lexis: return "Lexis";
+        case OutfitFormat::Stand: return "Stand";
+        default: return "Unknown";
+    }
+}
+
+// Job Journal
+// Append-only record of the inputs a batch has finished, one JSON object
+// per line. A batch started again over the same inputs skips everything
+// the journal already lists, so cancelled or crashed runs resume instead
+// of converting (and _converted_N-ing) every file again. Reopening a
+// journal rewrites it with one line per input, so it never grows past the
+// job's size. Watch mode keeps one too, for the outputs of earlier sessions.
+class JobJournal {
+public:
+    static QString journalDirectory() {
+        return outputRootPath() + "/.journal";
+    }
+    
+    // A job is identified by the set of inputs it was started with.
+    static QString jobIdFor(const QStringList& inputs) {
+        QStringList sorted;
+        for (const QString& input : inputs) {
+            sorted.append(QFileInfo(input).absoluteFilePath());
+        }
+        sorted.sort();
+        return hashToHex(contentHash64(sorted.join('\n').toUtf8()));
+    }
+    
+    // Like jobIdFor() but from each input's own name only, so machines that
+    // mount the inputs in different places still name the job the same.
+    static QString portableJobIdFor(const QStringList& inputs) {
+        QStringList sorted;
+        for (const QString& input : inputs) {
+            sorted.append(QFileInfo(QFileInfo(input).absoluteFilePath()).fileName());
+        }
+        sorted.sort();
+        return hashToHex(contentHash64(sorted.join('\n').toUtf8()));
+    }
+    
+    bool open(const QString& jobId, bool resume = true, const QString& directory = QString()) {
+        QString journalDir = directory.isEmpty() ? journalDirectory() : directory;
+        QDir().mkpath(journalDir);
+        file.setFileName(journalDir + "/" + jobId + ".jsonl");
+        completed.clear();
+        
+        if (resume && file.open(QIODevice::ReadOnly)) {
+            int lines = 0;
+            while (!file.atEnd()) {
+                // A line cut short by a crash simply fails to parse.
+                QJsonObject line = QJsonDocument::fromJson(file.readLine()).object();
+                lines++;
+                if (line.isEmpty() || !line.contains("in")) continue;
+                
+                Entry entry;
+                entry.size = line.value("size").toInteger(-1);
+                entry.mtime = line.value("mtime").toInteger(-1);
+                entry.hash = line.value("hash").toString().toULongLong(nullptr, 16);
+                entry.outputPath = line.value("out").toString();
+                entry.source = formatFromName(line.value("from").toString());
+                completed.insert(line.value("in").toString(), entry);
+            }
+            file.close();
+            
+            // Later lines for the same input replaced earlier ones; keep the latest only.
+            if (lines > completed.size()) {
+                QByteArray compact;
+                for (auto it = completed.constBegin(); it != completed.constEnd(); ++it) {
+                    compact.append(lineFor(it.key(), it.value()));
+                }
+                OutputWriter::instance().write(file.fileName(), compact);
+            }
+        }
+        
+        QIODevice::OpenMode mode = QIODevice::WriteOnly | (resume ? QIODevice::Append : QIODevice::Truncate);
+        return file.open(mode);
+    }
+    
+    void close() {
+        QMutexLocker locker(&mutex);
+        file.close();
+    }
+    
+    QString filePath() const { return file.fileName(); }
+    int completedCount() const { return completed.size(); }
+    
+    // Fast check from file metadata alone, so resumed inputs are not re-read.
+    // source is the format the input was forced to (Unknown = detected); an
+    // input converted before under another source format is not done.
+    bool isCompleted(const QString& inputPath, qint64 size, qint64 mtime, OutfitFormat source) const {
+        auto it = completed.constFind(inputPath);
+        return it != completed.constEnd() && it->size == size && it->mtime == mtime &&
+               it->source == source && QFile::exists(it->outputPath);
+    }
+    
+    bool isCompleted(const QString& inputPath, quint64 hash, OutfitFormat source) const {
+        auto it = completed.constFind(inputPath);
+        return it != completed.constEnd() && it->hash == hash && it->source == source &&
+               QFile::exists(it->outputPath);
+    }
+    
+    QString outputFor(const QString& inputPath) const {
+        return completed.value(inputPath).outputPath;
+    }
+    
+    // Thread-safe; called from the output writer's I/O threads.
+    void record(const QString& inputPath, qint64 size, qint64 mtime, quint64 hash, const QString& outputPath,
+                OutfitFormat source = OutfitFormat::Unknown) {
+        Entry entry;
+        entry.size = size;
+        entry.mtime = mtime;
+        entry.hash = hash;
+        entry.outputPath = outputPath;
+        entry.source = source;
+        QByteArray bytes = lineFor(inputPath, entry);
+        
+        QMutexLocker locker(&mutex);
+        file.write(bytes);
+        file.flush();
+    }
+    
+    // Maps the output of each input converted again to a new path to the
+    // output its first line gave it, i.e. the file the new one replaces.
+    static QHash<QString, QString> replacedOutputs(const QString& journalPath) {
+        QHash<QString, QString> replaced;
+        QFile in(journalPath);
+        if (!in.open(QIODevice::ReadOnly)) return replaced;
+        
+        QHash<QString, QString> latest;  // input -> its last output
+        while (!in.atEnd()) {
+            QJsonObject line = QJsonDocument::fromJson(in.readLine()).object();
+            if (!line.contains("in")) continue;
+            QString output = line.value("out").toString();
+            QString& current = latest[line.value("in").toString()];
+            if (!current.isEmpty() && current != output) replaced.insert(output, replaced.value(current, current));
+            current = output;
+        }
+        return replaced;
+    }
+    
+    // Points entries at the new home of outputs that were moved after the
+    // job wrote them, so a later run still finds them and skips the input.
+    static bool rewriteOutputs(const QString& journalPath, const QHash<QString, QString>& moved) {
+        QFile in(journalPath);
+        if (!in.open(QIODevice::ReadOnly)) return false;
+        
+        QByteArray rewritten;
+        while (!in.atEnd()) {
+            QByteArray raw = in.readLine();
+            QJsonObject line = QJsonDocument::fromJson(raw).object();
+            auto it = moved.constFind(line.value("out").toString());
+            if (it == moved.constEnd()) {
+                rewritten.append(raw);
+                continue;
+            }
+            line["out"] = *it;
+            rewritten.append(QJsonDocument(line).toJson(QJsonDocument::Compact));
+            rewritten.append('\n');
+        }
+        in.close();
+        return OutputWriter::instance().write(journalPath, rewritten);
+    }
+    
+private:
+    struct Entry {
+        qint64 size = -1;
+        qint64 mtime = -1;
+        quint64 hash = 0;
+        QString outputPath;
+        OutfitFormat source = OutfitFormat::Unknown;
+    };
+    
+    static QByteArray lineFor(const QString& inputPath, const Entry& entry) {
+        QJsonObject line;
+        line["in"] = inputPath;
+        line["size"] = entry.size;
+        line["mtime"] = entry.mtime;
+        line["hash"] = hashToHex(entry.hash);
+        line["out"] = entry.outputPath;
+        if (entry.source != OutfitFormat::Unknown) line["from"] = formatName(entry.source);
+        
+        QByteArray bytes = QJsonDocument(line).toJson(QJsonDocument::Compact);
+        bytes.append('\n');
+        return bytes;
+    }
+    
+    QHash<QString, Entry> completed;
+    QFile file;
+    QMutex mutex;
+};
+
+// Blocking FIFO between two pipeline stages. push() waits while the queue
+// is over its item or byte budget, so a fast stage can run ahead of a slow
+// one by at most the budget.
+template <typename T>
+class BoundedQueue {
+public:
+    BoundedQueue(int maxItems, qint64 maxBytes)
+        : maxItems(maxItems), maxBytes(maxBytes) {}
+    
+    // Returns false once the queue has been closed.
+    bool push(T item, qint64 bytes = 0) {
+        QMutexLocker locker(&mutex);
+        while (!closed && !items.isEmpty() &&
+               (items.size() >= maxItems || queuedBytes + bytes > maxBytes)) {
+            notFull.wait(&mutex);
+        }
+        if (closed) return false;
+        
+        items.enqueue(qMakePair(std::move(item), bytes));
+        queuedBytes += bytes;
+        peakBytes = qMax(peakBytes, queuedBytes);
+        notEmpty.wakeOne();
+        return true;
+    }
+    
+    // Blocks for the next item; false when closed and drained.
+    bool pop(T& item) {
+        QMutexLocker locker(&mutex);
+        while (items.isEmpty() && !closed) {
+            notEmpty.wait(&mutex);
+        }
+        if (items.isEmpty()) return false;
+        
+        QPair<T, qint64> entry = items.dequeue();
+        item = std::move(entry.first);
+        queuedBytes -= entry.second;
+        notFull.wakeAll();
+        return true;
+    }
+    
+    // No more pushes; consumers drain what is left.
+    void close() {
+        QMutexLocker locker(&mutex);
+        closed = true;
+        notEmpty.wakeAll();
+        notFull.wakeAll();
+    }
+    
+    qint64 peakQueuedBytes() {
+        QMutexLocker locker(&mutex);
+        return peakBytes;
+    }
+    
+private:
+    QQueue<QPair<T, qint64>> items;
+    QMutex mutex;
+    QWaitCondition notEmpty;
+    QWaitCondition notFull;
+    const int maxItems;
+    const qint64 maxBytes;
+    qint64 queuedBytes = 0;
+    qint64 peakBytes = 0;
+    bool closed = false;
+};
+
+// Hands input buffers from the converters back to the readers, so a batch
+// reuses a few allocations instead of making one per file. Buffers still
+// shared (a YimMenu input passed straight through) or unusually large are
+// let go instead.
+class BufferPool {
+public:
+    explicit BufferPool(int maxBuffers) : maxBuffers(maxBuffers) {}
+    
+    QByteArray acquire() {
+        QMutexLocker locker(&mutex);
+        return buffers.isEmpty() ? QByteArray() : buffers.takeLast();
+    }
+    
+    void release(QByteArray& buffer) {
+        if (buffer.isDetached() && buffer.capacity() <= kMaxPooledBytes) {
+            buffer.resize(0);
+            QMutexLocker locker(&mutex);
+            if (buffers.size() < maxBuffers) {
+                buffers.append(std::move(buffer));
+            }
+        }
+        buffer = QByteArray();
+    }
+    
+private:
+    static constexpr qsizetype kMaxPooledBytes = 1024 * 1024;
+    
+    QList<QByteArray> buffers;
+    QMutex mutex;
+    const int maxBuffers;
+};
+
+// Yields one input path per call; false when there are no more.
+using BatchInputSource = std::function<bool(QString&)>;
+
+// Walks files and folders lazily, so a batch over a huge tree never holds
+// the whole file list.
+class InputEnumerator {
+public:
+    explicit InputEnumerator(const QStringList& arguments) : arguments(arguments) {}
+    
+    bool next(QString& path) {
+        while (true) {
+            if (dirIterator) {
+                while (dirIterator->hasNext()) {
+                    path = dirIterator->next();
+                    if (isOutfitFileName(path)) return true;
+                }
+                dirIterator.reset();
+            }
+            
+            if (argumentIndex >= arguments.size()) return false;
+            QFileInfo info(arguments[argumentIndex++]);
+            if (info.isDir()) {
+                root = info.absoluteFilePath();
+                dirIterator = std::make_unique<QDirIterator>(root, QDir::Files, QDirIterator::Subdirectories);
+            } else if (info.isFile()) {
+                root.clear();
+                path = info.absoluteFilePath();
+                return true;
+            }
+        }
+    }
+    
+    // The last path from next() relative to the folder argument it was found
+    // in (just the file name for file arguments), which stays the same
+    // wherever the tree is mounted.
+    QString relativePath(const QString& path) const {
+        return root.isEmpty() ? QFileInfo(path).fileName() : QDir(root).relativeFilePath(path);
+    }
+    
+private:
+    QStringList arguments;
+    int argumentIndex = 0;
+    QString root;
+    std::unique_ptr<QDirIterator> dirIterator;
+};
+
+// Live counters of a running batch. The pipeline's threads bump them as
+// files finish and a UI samples them on its own timer, so nothing is called
+// back per file. Setting cancelRequested stops the batch from any thread.
+struct BatchProgress {
+    std::atomic<int> total{-1};                    // -1 until the source is fully enumerated
+    std::atomic<int> queued{0};
+    std::atomic<int> converted{0};
+    std::atomic<int> failed{0};
+    std::atomic<int> resumed{0};
+    std::atomic<int> invalid{0};
+    std::atomic<int> convertedByFormat[int(OutfitFormat::Stand) + 1] = {};
+    std::atomic<qint64> bytesRead{0};
+    std::atomic<bool> cancelRequested{false};
+    
+    int finished() const {
+        return converted.load() + failed.load() + resumed.load();
+    }
+};
+
+struct BatchOptions {
+    QString outputDir;
+    OutfitFormat manualSourceFormat = OutfitFormat::Unknown;  // Unknown = auto-detect
+    QHash<QString, OutfitFormat> formatOverrides;  // per absolute input path
+    QString pathTemplate = kDefaultPathTemplate;   // output layout inside outputDir
+    bool resume = true;
+    QString jobId;                                 // empty = derived from the input list
+    QString journalDir;                            // empty = JobJournal::journalDirectory()
+    std::function<QString(const QString&)> journalKey;  // input path -> journal key; empty = the path
+    qint64 maxMemoryBytes = 128 * 1024 * 1024;     // read-ahead plus queued output
+    int readerThreads = 2;
+    int converterThreads = 0;                      // 0 = one per core
+    const SlotLimits* slotLimits = nullptr;        // validate outputs against these when set
+    bool rejectInvalid = false;                    // fail invalid outfits instead of writing them
+    BatchProgress* progress = nullptr;             // bumped by the pipeline when set
+};
+
+struct BatchReport {
+    int total = 0;
+    int succeeded = 0;
+    int failed = 0;
+    int resumed = 0;
+    bool cancelled = false;
+    qint64 peakBufferedBytes = 0;
+    QStringList failedFiles;
+    QStringList invalidFiles;                      // "<file>: <issues>", written unless rejected
+    QString journalPath;
+    
+    int remaining() const {
+        return total - succeeded - failed - resumed;
+    }
+};
+
+// Converts inputs to YimMenu files in options.outputDir as a staged pipeline:
+// the caller's thread enumerates, reader threads load, fingerprint and detect,
+// converter threads convert, and the OutputWriter pool writes. Every stage
+// boundary is a bounded queue, so peak memory is set by maxMemoryBytes rather
+// than the batch size. Finished inputs are journaled; progress is called on
+// the caller's thread before each input is queued and may return false to
+// cancel. total is -1 when the source size is unknown. options.progress, when
+// set, is kept up to date from the worker threads instead.
+BatchReport runBatchConversion(const BatchInputSource& source, const BatchOptions& options,
+                               const std::function<bool(int, int, const QString&)>& progress,
+                               int total = -1) {
+    struct ReadItem {
+        QString path;
+        QString key;                    // the input's name in the journal
+        qint64 size = 0;
+        qint64 mtime = 0;
+        quint64 hash = 0;
+        OutfitFormat requested = OutfitFormat::Unknown;
+        OutfitFormat format = OutfitFormat::Unknown;
+        QByteArray data;
+    };
+    
+    BatchReport report;
+    QString outputRoot = QDir(options.outputDir).absolutePath();
+    QDir().mkpath(outputRoot);
+    QSet<QString> outputDirs{outputRoot};
+    
+    PathTemplate layout = PathTemplate::compile(options.pathTemplate);
+    if (!layout.isValid()) layout = PathTemplate::compile(kDefaultPathTemplate);
+    
+    // Another output root, target or layout is another job: the earlier
+    // outputs sit elsewhere or hold another format. A root inside the journal
+    // folder (a shard's staging folder) counts relative to it, so the id does
+    // not depend on where the share is mounted.
+    QString destinationRoot = outputRoot;
+    if (!options.journalDir.isEmpty()) {
+        QString relative = QDir(options.journalDir).relativeFilePath(outputRoot);
+        if (!relative.startsWith("..")) destinationRoot = relative;
+    }
+    QByteArray destination = (destinationRoot + '\n' + formatName(OutfitFormat::YimMenu) + '\n' +
+                              layout.pattern()).toUtf8();
+    QString jobId = options.jobId + "-" + hashToHex(contentHash64(destination)).left(8);
+    
+    JobJournal journal;
+    journal.open(jobId, options.resume, options.journalDir);
+    report.journalPath = journal.filePath();
+    
+    // Half the budget buffers raw input, half waits in the writer.
+    qint64 stageBudget = qMax<qint64>(options.maxMemoryBytes / 2, 1024 * 1024);
+    
+    int readerCount = qMax(1, options.readerThreads);
+    int converterCount = options.converterThreads > 0 ? options.converterThreads
+                                                       : qMax(1, QThread::idealThreadCount());
+    BoundedQueue<QString> pathQueue(256, std::numeric_limits<qint64>::max());
+    BoundedQueue<ReadItem> readQueue(1024, stageBudget);
+    BufferPool bufferPool(readerCount + converterCount + 64);
+    
+    std::atomic<int> succeeded{0};
+    std::atomic<int> resumed{0};
+    std::atomic<int> readersLeft{readerCount};
+    std::atomic<bool> cancelled{false};
+    QMutex failMutex;
+    QMutex outputPathMutex;
+    QSet<QString> claimedPaths;
+    OutputWriter::Group writes(stageBudget);
+    
+    // Throwaway counters when nobody watches, so the stages never branch on it.
+    BatchProgress unobserved;
+    BatchProgress& live = options.progress ? *options.progress : unobserved;
+    live.total.store(total);
+    auto isCancelled = [&]() {
+        return cancelled.load(std::memory_order_relaxed) || live.cancelRequested.load(std::memory_order_relaxed);
+    };
+    
+    auto fail = [&](const QString& path) {
+        live.failed++;
+        QMutexLocker locker(&failMutex);
+        report.failed++;
+        report.failedFiles.append(QFileInfo(path).fileName());
+    };
+    auto flagInvalid = [&](const QString& path, const SlotIssues& issues) {
+        live.invalid++;
+        QMutexLocker locker(&failMutex);
+        report.invalidFiles.append(QFileInfo(path).fileName() + ": " + describeIssues(issues));
+    };
+    
+    QThreadPool stagePool;
+    stagePool.setMaxThreadCount(readerCount + converterCount);
+    
+    for (int i = 0; i < readerCount; ++i) {
+        stagePool.start([&]() {
+            ConversionArena arena;
+            QString path;
+            while (pathQueue.pop(path)) {
+                if (isCancelled()) continue;
+                
+                QFileInfo info(path);
+                ReadItem item;
+                item.path = path;
+                item.key = options.journalKey ? options.journalKey(path) : path;
+                item.size = info.size();
+                item.mtime = info.lastModified().toMSecsSinceEpoch();
+                OutfitFormat requested = options.manualSourceFormat != OutfitFormat::Unknown
+                                             ? options.manualSourceFormat
+                                             : options.formatOverrides.value(path, OutfitFormat::Unknown);
+                if (journal.isCompleted(item.key, item.size, item.mtime, requested)) {
+                    resumed++;
+                    live.resumed++;
+                    continue;
+                }
+                
+                QFile file(path);
+                if (!file.open(QIODevice::ReadOnly)) {
+                    fail(path);
+                    continue;
+                }
+                item.data = bufferPool.acquire();
+                item.data.resize(item.size);
+                qint64 bytesRead = file.read(item.data.data(), item.size);
+                if (bytesRead < 0) {
+                    bufferPool.release(item.data);
+                    fail(path);
+                    continue;
+                }
+                item.data.resize(bytesRead);
+                if (!file.atEnd()) item.data.append(file.readAll());
+                file.close();
+                live.bytesRead += item.data.size();
+                
+                // Touched but unchanged since the last run: refresh its journal entry.
+                item.hash = contentHash64(item.data);
+                if (journal.isCompleted(item.key, item.hash, requested)) {
+                    journal.record(item.key, item.size, item.mtime, item.hash, journal.outputFor(item.key), requested);
+                    bufferPool.release(item.data);
+                    resumed++;
+                    live.resumed++;
+                    continue;
+                }
+                
+                arena.reset();
+                item.requested = requested;
+                item.format = options.formatOverrides.value(path, OutfitFormat::Unknown);
+                if (item.format == OutfitFormat::Unknown) {
+                    item.format = detectFormatFromData(item.data, path, arena.resource());
+                }
+                if (item.format == OutfitFormat::Unknown) {
+                    bufferPool.release(item.data);
+                    fail(path);
+                    continue;
+                }
+                
+                qint64 bytes = item.data.size();
+                readQueue.push(std::move(item), bytes);
+            }
+            
+            if (--readersLeft == 0) readQueue.close();
+        });
+    }
+    
+    for (int i = 0; i < converterCount; ++i) {
+        stagePool.start([&]() {
+            OutfitJsonWriter writer;
+            ConversionArena arena;
+            QString relativePath;
+            SlotIssues issues;
+            ReadItem item;
+            while (readQueue.pop(item)) {
+                if (isCancelled()) continue;
+                
+                OutfitFormat fmt = options.manualSourceFormat != OutfitFormat::Unknown
+                                       ? options.manualSourceFormat : item.format;
+                arena.reset();
+                QByteArray output = convertDataToYimUtf8(item.data, fmt, writer, arena.resource());
+                bufferPool.release(item.data);
+                if (output.isEmpty()) {
+                    fail(item.path);
+                    continue;
+                }
+                
+                PathContext context = pathContextFor(item.path);
+                context.format = fmt;
+                context.hash = item.hash;
+                if (layout.usesModel() || options.slotLimits) {
+                    DecodedOutfit decoded(arena.resource());
+                    if (decodeOutfitJson(output, decoded, OutfitFormat::YimMenu)) {
+                        context.hasModel = decoded.outfit.hasModel;
+                        context.model = decoded.outfit.model;
+                        
+                        issues.clear();
+                        if (options.slotLimits && !validateOutfit(decoded.outfit, *options.slotLimits, &issues)) {
+                            flagInvalid(item.path, issues);
+                            if (options.rejectInvalid) {
+                                fail(item.path);
+                                continue;
+                            }
+                        }
+                    }
+                }
+                layout.resolve(context, relativePath);
+                QString candidate = outputRoot + "/" + relativePath;
+                
+                // Pick and claim the output name in one step so two workers
+                // converting the same base name cannot collide. A changed input
+                // replaces its earlier output instead of adding a _N copy. The
+                // lock is released before enqueue, which may block on the disk.
+                QString outputPath;
+                {
+                    QMutexLocker locker(&outputPathMutex);
+                    outputPath = journal.outputFor(item.key);
+                    if (outputPath.isEmpty() || !isOutputPathFor(outputPath, candidate)) {
+                        outputPath = uniqueOutputPath(candidate, &claimedPaths);
+                    }
+                    claimedPaths.insert(outputPath);
+                    QString outputDir = QFileInfo(outputPath).absolutePath();
+                    if (!outputDirs.contains(outputDir)) {
+                        QDir().mkpath(outputDir);
+                        outputDirs.insert(outputDir);
+                    }
+                }
+                // Counted first; a failed write takes it back and reports the
+                // input, like a failed read or conversion does.
+                succeeded++;
+                live.converted++;
+                live.convertedByFormat[int(fmt)]++;
+                OutputWriter::instance().enqueue(writes, outputPath, output,
+                    [&, path = item.path, key = item.key, size = item.size, mtime = item.mtime,
+                     hash = item.hash, requested = item.requested, format = fmt, outputPath](bool ok) {
+                        if (ok) {
+                            journal.record(key, size, mtime, hash, outputPath, requested);
+                            return;
+                        }
+                        succeeded--;
+                        live.converted--;
+                        live.convertedByFormat[int(format)]--;
+                        fail(path);
+                    });
+            }
+        });
+    }
+    
+    // Enumerate on this thread; the path queue throttles it to the readers.
+    QString path;
+    int index = 0;
+    while (source(path)) {
+        if ((progress && !progress(index, total, path)) || live.cancelRequested.load()) {
+            cancelled.store(true);
+            report.cancelled = true;
+            break;
+        }
+        pathQueue.push(path);
+        live.queued.store(++index, std::memory_order_relaxed);
+    }
+    report.total = total >= 0 ? total : index;
+    live.total.store(report.total);
+    
+    pathQueue.close();
+    stagePool.waitForDone();
+    // Cancelled after everything was queued: the stages skipped the rest.
+    if (live.cancelRequested.load()) report.cancelled = true;
+    
+    // Write failures were reported by their callbacks.
+    OutputWriter::instance().flush(writes);
+    report.succeeded = succeeded.load();
+    report.resumed = resumed.load();
+    report.peakBufferedBytes = readQueue.peakQueuedBytes();
+    
+    journal.close();
+    return report;
+}
+
+BatchReport runBatchConversion(const QStringList& inputs, BatchOptions options,
+                               const std::function<bool(int, int, const QString&)>& progress) {
+    if (options.jobId.isEmpty()) {
+        options.jobId = JobJournal::jobIdFor(inputs);
+    }
+    
+    int next = 0;
+    return runBatchConversion([&inputs, &next](QString& path) {
+        if (next >= inputs.size()) return false;
+        path = QFileInfo(inputs[next++]).absoluteFilePath();
+        return true;
+    }, options, progress, inputs.size());
+}
+
+// Sharded Conversion
+// Splits one conversion across processes or machines. Each input belongs to
+// the shard picked by a hash of its path below the folder it was found in,
+// so machines that mount the same share in different places still agree on
+// the split. A shard converts into its own staging folder under
+// <output>/.shards with its own journal and report; mergeShards() then moves
+// the outputs into place, drops identical results and sums the reports.
+struct ShardSpec {
+    int index = 0;
+    int count = 1;
+    
+    // "i/N" with 0 <= i < N.
+    static ShardSpec parse(const QString& text, QString* error = nullptr) {
+        ShardSpec shard;
+        const QStringList parts = text.split('/');
+        bool indexOk = false;
+        bool countOk = false;
+        if (parts.size() == 2) {
+            shard.index = parts[0].trimmed().toInt(&indexOk);
+            shard.count = parts[1].trimmed().toInt(&countOk);
+        }
+        if (!indexOk || !countOk || shard.count < 1 || shard.index < 0 || shard.index >= shard.count) {
+            if (error) *error = QString("invalid shard \"%1\", expected i/N with 0 <= i < N").arg(text);
+            return ShardSpec{0, 0};
+        }
+        return shard;
+    }
+    
+    bool isValid() const { return count > 0; }
+    QString name() const { return QString("%1-of-%2").arg(index).arg(count); }
+    
+    bool contains(const QString& relativePath) const {
+        return count <= 1 || contentHash64(relativePath.toUtf8()) % quint64(count) == quint64(index);
+    }
+};
+
+QString shardsRootPath(const QString& outputDir) {
+    return QDir(outputDir).absolutePath() + "/.shards";
+}
+
+// Points a batch at the shard's staging folder and journal. The journal is
+// keyed on paths below the input folders and named after the input list,
+// so a shard rerun on another machine, or over other inputs, picks the
+// right one.
+void applyShard(BatchOptions& options, const ShardSpec& shard, const QStringList& inputs) {
+    QString root = shardsRootPath(options.outputDir);
+    options.outputDir = root + "/" + shard.name();
+    options.journalDir = root;
+    options.jobId = shard.name() + "-" + JobJournal::portableJobIdFor(inputs);
+    
+    QStringList folders;
+    for (const QString& input : inputs) {
+        QFileInfo info(input);
+        if (info.isDir()) folders.append(info.absoluteFilePath());
+    }
+    options.journalKey = [folders](const QString& path) {
+        for (const QString& folder : folders) {
+            if (path.startsWith(folder + "/")) return QDir(folder).relativeFilePath(path);
+        }
+        return QFileInfo(path).fileName();
+    };
+}
+
+// Written last, so a staging folder without a report belongs to a shard that
+// is still running or died, and is left alone by mergeShards().
+bool writeShardReport(const QString& outputDir, const ShardSpec& shard, const BatchReport& report, qint64 elapsedMs) {
+    QJsonObject json;
+    json["shard"] = shard.name();
+    json["host"] = QSysInfo::machineHostName();
+    json["total"] = report.total;
+    json["succeeded"] = report.succeeded;
+    json["failed"] = report.failed;
+    json["resumed"] = report.resumed;
+    json["cancelled"] = report.cancelled;
+    json["elapsedMs"] = elapsedMs;
+    json["failedFiles"] = QJsonArray::fromStringList(report.failedFiles);
+    json["invalidFiles"] = QJsonArray::fromStringList(report.invalidFiles);
+    
+    QString path = shardsRootPath(outputDir) + "/" + shard.name() + ".json";
+    return OutputWriter::instance().write(path, QJsonDocument(json).toJson());
+}
+
+struct ShardMergeReport {
+    int shards = 0;
+    int moved = 0;
+    int duplicates = 0;              // identical to an output already in place
+    int renamed = 0;                 // name already taken by a different outfit
+    QStringList pending;             // staging folders without a report yet
+    QStringList errors;
+    BatchReport totals;
+};
+
+// Moves every finished shard's outputs from <output>/.shards into <output>,
+// keeping their layout. An output identical to one already merged (or
+// already at its name) is dropped, and one whose name is taken by another
+// outfit gets an _N name; an input converted again replaces its earlier
+// merged output. Shard journals are rewritten to the final
+// paths, so rerunning a shard still resumes. Reports are consumed, so each
+// shard's counts are merged once.
+ShardMergeReport mergeShards(const QString& outputDir) {
+    ShardMergeReport merge;
+    QString outputRoot = QDir(outputDir).absolutePath();
+    QString root = shardsRootPath(outputDir);
+    QDir shardsDir(root);
+    
+    auto sameContent = [](const QString& path, const QByteArray& data) {
+        QFile file(path);
+        return file.open(QIODevice::ReadOnly) && file.size() == data.size() && file.readAll() == data;
+    };
+    
+    QHash<quint64, QString> merged;  // content hash -> final path
+    const QStringList stagingNames = shardsDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    const QStringList reportNames = shardsDir.entryList(QStringList() << "*-of-*.json", QDir::Files, QDir::Name);
+    
+    for (const QString& reportName : reportNames) {
+        QString shardName = QFileInfo(reportName).completeBaseName();
+        QString reportPath = root + "/" + reportName;
+        QFile reportFile(reportPath);
+        if (!reportFile.open(QIODevice::ReadOnly)) {
+            merge.errors.append("could not read " + reportPath);
+            continue;
+        }
+        QJsonObject report = QJsonDocument::fromJson(reportFile.readAll()).object();
+        reportFile.close();
+        
+        ++merge.shards;
+        merge.totals.total += report.value("total").toInt();
+        merge.totals.succeeded += report.value("succeeded").toInt();
+        merge.totals.failed += report.value("failed").toInt();
+        merge.totals.resumed += report.value("resumed").toInt();
+        merge.totals.cancelled = merge.totals.cancelled || report.value("cancelled").toBool();
+        for (const QJsonValue& name : report.value("failedFiles").toArray()) {
+            merge.totals.failedFiles.append(name.toString());
+        }
+        for (const QJsonValue& line : report.value("invalidFiles").toArray()) {
+            merge.totals.invalidFiles.append(line.toString());
+        }
+        
+        QString stagingPath = root + "/" + shardName;
+        QStringList staged;
+        QDirIterator it(stagingPath, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            staged.append(it.next());
+        }
+        staged.sort();
+        
+        // An input converted again after an earlier merge replaces the output
+        // that merge gave it rather than landing next to it as an _N copy.
+        const QStringList journals = shardsDir.entryList(
+            QStringList() << shardName + ".jsonl" << shardName + "-*.jsonl", QDir::Files);
+        QHash<QString, QString> replaces;  // staging path -> merged output it replaces
+        for (const QString& journal : journals) {
+            const QHash<QString, QString> replaced = JobJournal::replacedOutputs(root + "/" + journal);
+            for (auto it = replaced.constBegin(); it != replaced.constEnd(); ++it) {
+                if (!it.value().startsWith(root + "/")) replaces.insert(it.key(), it.value());
+            }
+        }
+        
+        QHash<QString, QString> moved;  // staging path -> final path
+        int errorsBefore = merge.errors.size();
+        for (const QString& stagedPath : staged) {
+            QFile file(stagedPath);
+            if (!file.open(QIODevice::ReadOnly)) {
+                merge.errors.append("could not read " + stagedPath);
+                continue;
+            }
+            QByteArray data = file.readAll();
+            file.close();
+            quint64 hash = contentHash64(data);
+            
+            QString target = outputRoot + "/" + QDir(stagingPath).relativeFilePath(stagedPath);
+            QString previous = replaces.value(stagedPath);
+            if (!previous.isEmpty() && isOutputPathFor(previous, target) && QFile::exists(previous) &&
+                !sameContent(previous, data)) {
+                // QFile::rename() does not overwrite.
+                if (!QFile::remove(previous) || !QFile::rename(stagedPath, previous)) {
+                    merge.errors.append("could not move " + stagedPath + " to " + previous);
+                    continue;
+                }
+                moved.insert(stagedPath, previous);
+                merged.insert(hash, previous);
+                ++merge.moved;
+                continue;
+            }
+            
+            QString existing = merged.value(hash);
+            if (existing.isEmpty() && QFile::exists(target) && sameContent(target, data)) existing = target;
+            if (!existing.isEmpty() && sameContent(existing, data)) {
+                QFile::remove(stagedPath);
+                moved.insert(stagedPath, existing);
+                ++merge.duplicates;
+                continue;
+            }
+            
+            if (QFile::exists(target)) {
+                target = uniqueOutputPath(target);
+                ++merge.renamed;
+            }
+            QDir().mkpath(QFileInfo(target).absolutePath());
+            if (!QFile::rename(stagedPath, target)) {
+                merge.errors.append("could not move " + stagedPath + " to " + target);
+                continue;
+            }
+            moved.insert(stagedPath, target);
+            merged.insert(hash, target);
+            ++merge.moved;
+        }
+        
+        for (const QString& journal : journals) {
+            if (!JobJournal::rewriteOutputs(root + "/" + journal, moved)) {
+                merge.errors.append("could not update journal " + root + "/" + journal);
+            }
+        }
+        
+        QFile::remove(reportPath);
+        // Anything that could not be moved stays staged for the next merge.
+        if (merge.errors.size() == errorsBefore) QDir(stagingPath).removeRecursively();
+    }
+    
+    for (const QString& stagingName : stagingNames) {
+        if (!reportNames.contains(stagingName + ".json") && QDir(root + "/" + stagingName).exists()) {
+            merge.pending.append(stagingName);
+        }
+    }
+    
+    merge.totals.journalPath = root;
+    return merge;
+}
+
+// Outfit Summary
+// What the library list shows for an outfit without opening its file: the
+// model, the slots set to something other than nothing, and a one-line
+// signature. Built along with the outfit's index entry, off the GUI thread.
+struct OutfitSummary {
+    QString signature;  // "Male · 7 slots · Top 15/2, Pants 4/0, Hat 12/0, …"
+    QString toolTip;    // the model, then every set slot on its own line
+};
+
+// The other formats pad missing components with 0/0 and missing props
+// with -1, so those read as unset.
+bool isUnsetSlot(bool isProp, const OutfitSlot& slot) {
+    return isProp ? slot.drawable < 0 : slot.drawable == 0 && slot.texture == 0;
+}
+
+OutfitSummary summarizeOutfit(const OutfitData& data) {
+    QStringList setSlots;
+    for (int kind = 0; kind < 2; ++kind) {
+        bool isProp = kind == 1;
+        int count = isProp ? kPropSlotCount : kComponentSlotCount;
+        for (int i = 0; i < count; ++i) {
+            const OutfitSlot& slot = data.slot(isProp, i);
+            if (!data.hasSlot(isProp, i) || isUnsetSlot(isProp, slot)) continue;
+            const QString& name = isProp ? kPropSlotNames[i] : kComponentSlotNames[i];
+            setSlots.append(QString("%1 %2/%3").arg(name).arg(slot.drawable).arg(slot.texture));
+        }
+    }
+    
+    QString model = data.hasModel ? ModelRegistry::label(data.model) : QString("No model");
+    OutfitSummary summary;
+    summary.signature = QString("%1 · %2 slot%3").arg(model).arg(setSlots.size()).arg(setSlots.size() == 1 ? "" : "s");
+    if (!setSlots.isEmpty()) {
+        summary.signature += " · " + setSlots.mid(0, 3).join(", ");
+        if (setSlots.size() > 3) summary.signature += ", …";
+    }
+    
+    summary.toolTip = "Model: " + model;
+    for (const QString& slot : setSlots) summary.toolTip += "\n" + slot;
+    if (setSlots.isEmpty()) summary.toolTip += "\nNo slots set";
+    return summary;
+}
+
+// Outfit Index
+// Inverted index over the library so slot/model queries never have to open
+// the outfit files themselves.
+QString normalizedSlotKey(const QString& text) {
+    QString key;
+    for (QChar c : text) {
+        if (c.isLetterOrNumber()) key += c.toLower();
+    }
+    return key;
+}
+
+// Resolves "top", "lefthand", "c3", "p0", ... to a slot.
+bool lookupSlotName(const QString& name, bool& isProp, int& slot) {
+    QString key = normalizedSlotKey(name);
+    
+    if (key.size() >= 2 && (key[0] == 'c' || key[0] == 'p')) {
+        bool ok = false;
+        int idx = key.mid(1).toInt(&ok);
+        int count = (key[0] == 'p') ? kPropSlotCount : kComponentSlotCount;
+        if (ok && idx >= 0 && idx < count) {
+            isProp = (key[0] == 'p');
+            slot = idx;
+            return true;
+        }
+    }
+    
+    for (int i = 0; i < kComponentSlotCount; ++i) {
+        if (normalizedSlotKey(kComponentSlotNames[i]) == key) {
+            isProp = false;
+            slot = i;
+            return true;
+        }
+    }
+    for (int i = 0; i < kPropSlotCount; ++i) {
+        if (normalizedSlotKey(kPropSlotNames[i]) == key) {
+            isProp = true;
+            slot = i;
+            return true;
+        }
+    }
+    
+    if (key == "mask" || key == "beard") {
+        isProp = false;
+        slot = 1;
+        return true;
+    }
+    
+    return false;
+}
+
+// Parsed form of a search such as "top=178/3 hat=* model=female".
+// Terms are ANDed; bare words filter on the outfit name.
+struct OutfitQuery {
+    enum class Match { Value, Set, Unset };
+    
+    struct SlotTerm {
+        bool isProp = false;
+        int slot = 0;
+        Match match = Match::Value;
+        qint32 drawable = 0;
+        qint32 texture = 0;
+        bool anyTexture = true;
+    };
+    
+    QVector<SlotTerm> slotTerms;
+    bool hasModel = false;
+    qint64 model = 0;
+    QStringList nameTerms;
+    QString error;
+    
+    bool isStructured() const {
+        return hasModel || !slotTerms.isEmpty();
+    }
+    
+    bool isEmpty() const {
+        return !isStructured() && nameTerms.isEmpty();
+    }
+    
+    static OutfitQuery parse(const QString& text) {
+        OutfitQuery query;
+        const QStringList tokens = text.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
+        
+        for (const QString& token : tokens) {
+            int sep = token.indexOf('=');
+            if (sep < 0) sep = token.indexOf(':');
+            if (sep <= 0) {
+                query.nameTerms.append(token);
+                continue;
+            }
+            
+            QString key = token.left(sep);
+            QString value = token.mid(sep + 1).trimmed().toLower();
+            
+            if (normalizedSlotKey(key) == "model") {
+                qint64 model = 0;
+                if (value == "m") query.model = kFreemodeMaleModel;
+                else if (value == "f") query.model = kFreemodeFemaleModel;
+                else if (ModelRegistry::parse(value, model)) query.model = model;
+                else {
+                    query.error = "Unknown model: " + value;
+                    continue;
+                }
+                query.hasModel = true;
+                continue;
+            }
+            
+            SlotTerm term;
+            if (!lookupSlotName(key, term.isProp, term.slot)) {
+                query.error = "Unknown slot: " + key;
+                continue;
+            }
+            
+            if (value == "*" || value == "set" || value == "any") {
+                term.match = Match::Set;
+            } else if (value == "-" || value == "none" || value == "unset") {
+                term.match = Match::Unset;
+            } else {
+                QStringList parts = value.split('/');
+                bool ok = false;
+                term.drawable = parts[0].toInt(&ok);
+                if (ok && parts.size() > 1 && parts[1] != "*") {
+                    term.texture = parts[1].toInt(&ok);
+                    term.anyTexture = false;
+                }
+                if (!ok || parts.size() > 2) {
+                    query.error = "Invalid slot value: " + token;
+                    continue;
+                }
+            }
+            query.slotTerms.append(term);
+        }
+        
+        return query;
+    }
+};
+
+class OutfitIndex {
+public:
+    static QString cachePathFor(const QString& libraryPath) {
+        return libraryPath + "/.outfit_index";
+    }
+    
+    void clear() {
+        entries.clear();
+        byName.clear();
+        freeIds.clear();
+        postings.clear();
+        modelPostings.clear();
+        dirty = true;
+    }
+    
+    int size() const { return byName.size(); }
+    bool isDirty() const { return dirty; }
+    
+    bool contains(const QString& name) const { return byName.contains(name); }
+    
+    bool isCurrent(const QString& name, qint64 mtime, qint64 fileSize) const {
+        auto it = byName.constFind(name);
+        if (it == byName.constEnd()) return false;
+        const Entry& entry = entries[it.value()];
+        return entry.mtime == mtime && entry.size == fileSize;
+    }
+    
+    const OutfitData* find(const QString& name) const {
+        auto it = byName.constFind(name);
+        return it == byName.constEnd() ? nullptr : &entries[it.value()].data;
+    }
+    
+    const OutfitSummary* summary(const QString& name) const {
+        auto it = byName.constFind(name);
+        return it == byName.constEnd() ? nullptr : &entries[it.value()].summary;
+    }
+    
+    void update(const QString& name, const OutfitData& data, qint64 mtime, qint64 fileSize) {
+        int id;
+        auto it = byName.constFind(name);
+        if (it != byName.constEnd()) {
+            id = it.value();
+            removePostings(id);
+        } else if (!freeIds.isEmpty()) {
+            id = freeIds.takeLast();
+            byName.insert(name, id);
+        } else {
+            id = entries.size();
+            entries.append(Entry());
+            byName.insert(name, id);
+        }
+        
+        Entry& entry = entries[id];
+        entry.name = name;
+        entry.data = data;
+        entry.summary = summarizeOutfit(data);
+        entry.mtime = mtime;
+        entry.size = fileSize;
+        entry.live = true;
+        addPostings(id);
+        dirty = true;
+    }
+    
+    void remove(const QString& name) {
+        auto it = byName.constFind(name);
+        if (it == byName.constEnd()) return;
+        int id = it.value();
+        removePostings(id);
+        byName.remove(name);
+        entries[id] = Entry();
+        freeIds.append(id);
+        dirty = true;
+    }
+    
+    void rename(const QString& from, const QString& to) {
+        auto it = byName.constFind(from);
+        if (it == byName.constEnd() || byName.contains(to)) return;
+        int id = it.value();
+        byName.remove(from);
+        byName.insert(to, id);
+        entries[id].name = to;
+        dirty = true;
+    }
+    
+    // Re-reads only files whose size or modification time changed since they
+    // were indexed, and drops entries whose files are gone. Returns the number
+    // of files parsed.
+    int refreshFromDirectory(const QString& libraryPath) {
+        QSet<QString> seen;
+        int parsed = 0;
+        ConversionArena arena;
+        
+        QDirIterator it(libraryPath, QStringList() << "*.json", QDir::Files);
+        while (it.hasNext()) {
+            it.next();
+            QFileInfo info = it.fileInfo();
+            QString name = info.completeBaseName();
+            qint64 mtime = info.lastModified().toMSecsSinceEpoch();
+            seen.insert(name);
+            
+            if (isCurrent(name, mtime, info.size())) continue;
+            
+            QFile file(info.absoluteFilePath());
+            if (!file.open(QIODevice::ReadOnly)) continue;
+            QByteArray bytes = file.readAll();
+            file.close();
+            
+            arena.reset();
+            DecodedOutfit decoded(arena.resource());
+            if (!decodeOutfitJson(bytes, decoded, OutfitFormat::YimMenu)) {
+                decoded.outfit = outfitDataFromYim(QJsonDocument::fromJson(bytes).object());
+            }
+            update(name, decoded.outfit, mtime, info.size());
+            parsed++;
+        }
+        
+        const QStringList indexed = byName.keys();
+        for (const QString& name : indexed) {
+            if (!seen.contains(name)) remove(name);
+        }
+        
+        return parsed;
+    }
+    
+    QStringList query(const OutfitQuery& query, int limit = -1) const {
+        QStringList results;
+        
+        // Start from the shortest posting list and verify the remaining
+        // terms against the stored slot data.
+        const QVector<int>* candidates = nullptr;
+        auto narrow = [&candidates](const QVector<int>* list) {
+            if (!candidates || list->size() < candidates->size()) candidates = list;
+        };
+        
+        static const QVector<int> empty;
+        if (query.hasModel) {
+            auto it = modelPostings.constFind(query.model);
+            narrow(it == modelPostings.constEnd() ? &empty : &it.value());
+        }
+        for (const OutfitQuery::SlotTerm& term : query.slotTerms) {
+            quint64 key;
+            if (term.match == OutfitQuery::Match::Unset) continue;
+            if (term.match == OutfitQuery::Match::Set) key = slotKey(term.isProp ? KindPropSet : KindComponentSet, term.slot, 0, 0);
+            else if (term.anyTexture) key = slotKey(term.isProp ? KindPropAnyTexture : KindComponentAnyTexture, term.slot, term.drawable, 0);
+            else key = slotKey(term.isProp ? KindProp : KindComponent, term.slot, term.drawable, term.texture);
+            
+            auto it = postings.constFind(key);
+            narrow(it == postings.constEnd() ? &empty : &it.value());
+        }
+        
+        auto consider = [&](int id) {
+            const Entry& entry = entries[id];
+            if (!entry.live || !matches(entry, query)) return;
+            results.append(entry.name);
+        };
+        
+        if (candidates) {
+            for (int id : *candidates) consider(id);
+        } else {
+            for (int id = 0; id < entries.size(); ++id) consider(id);
+        }
+        
+        results.sort(Qt::CaseInsensitive);
+        if (limit >= 0 && results.size() > limit) {
+            results = results.mid(0, limit);
+        }
+        return results;
+    }
+    
+    bool load(const QString& path) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) return false;
+        
+        QDataStream in(&file);
+        in.setVersion(QDataStream::Qt_6_0);
+        
+        quint32 magic = 0, version = 0;
+        qint32 count = 0;
+        in >> magic >> version >> count;
+        if (magic != kCacheMagic || version != kCacheVersion || count < 0) return false;
+        
+        clear();
+        for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+            QString name;
+            qint64 mtime, fileSize;
+            OutfitData data;
+            in >> name >> mtime >> fileSize >> data.model >> data.hasModel >> data.componentMask >> data.propMask;
+            for (OutfitSlot& s : data.components) in >> s.drawable >> s.texture;
+            for (OutfitSlot& s : data.props) in >> s.drawable >> s.texture;
+            if (in.status() == QDataStream::Ok) update(name, data, mtime, fileSize);
+        }
+        
+        if (in.status() != QDataStream::Ok) {
+            clear();
+            return false;
+        }
+        dirty = false;
+        return true;
+    }
+    
+    bool save(const QString& path) {
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly)) return false;
+        
+        QDataStream out(&file);
+        out.setVersion(QDataStream::Qt_6_0);
+        out << kCacheMagic << kCacheVersion << qint32(byName.size());
+        for (const Entry& entry : entries) {
+            if (!entry.live) continue;
+            const OutfitData& data = entry.data;
+            out << entry.name << entry.mtime << entry.size << data.model << data.hasModel << data.componentMask << data.propMask;
+            for (const OutfitSlot& s : data.components) out << s.drawable << s.texture;
+            for (const OutfitSlot& s : data.props) out << s.drawable << s.texture;
+        }
+        file.close();
+        
+        dirty = false;
+        return out.status() == QDataStream::Ok;
+    }
+    
+private:
+    enum PostingKind {
+        KindComponent, KindProp,
+        KindComponentAnyTexture, KindPropAnyTexture,
+        KindComponentSet, KindPropSet
+    };
+    
+    struct Entry {
+        QString name;
+        OutfitData data;
+        OutfitSummary summary;
+        qint64 mtime = 0;
+        qint64 size = 0;
+        bool live = false;
+    };
+    
+    static constexpr quint32 kCacheMagic = 0x4F494458;  // "OIDX"
+    static constexpr quint32 kCacheVersion = 1;
+    
+    static quint64 slotKey(PostingKind kind, int slot, qint32 drawable, qint32 texture) {
+        return (quint64(kind) << 59) | (quint64(slot) << 54)
+             | (quint64(quint32(drawable) & 0x3FFFFFF) << 27) | quint64(quint32(texture) & 0x7FFFFFF);
+    }
+    
+    static bool matches(const Entry& entry, const OutfitQuery& query) {
+        const OutfitData& data = entry.data;
+        if (query.hasModel && (!data.hasModel || data.model != query.model)) return false;
+        
+        for (const OutfitQuery::SlotTerm& term : query.slotTerms) {
+            bool present = data.hasSlot(term.isProp, term.slot);
+            const OutfitSlot& slot = data.slot(term.isProp, term.slot);
+            switch (term.match) {
+                case OutfitQuery::Match::Set:
+                    if (!present || slot.drawable < 0) return false;
+                    break;
+                case OutfitQuery::Match::Unset:
+                    if (present && slot.drawable >= 0) return false;
+                    break;
+                case OutfitQuery::Match::Value:
+                    if (!present || slot.drawable != term.drawable) return false;
+                    if (!term.anyTexture && slot.texture != term.texture) return false;
+                    break;
+            }
+        }
+        
+        for (const QString& word : query.nameTerms) {
+            if (!entry.name.contains(word, Qt::CaseInsensitive)) return false;
+        }
+        return true;
+    }
+    
+    template<typename F>
+    static void forEachKey(const OutfitData& data, F&& fn) {
+        for (int i = 0; i < kComponentSlotCount; ++i) {
+            if (!data.hasSlot(false, i)) continue;
+            const OutfitSlot& s = data.components[i];
+            fn(slotKey(KindComponent, i, s.drawable, s.texture));
+            fn(slotKey(KindComponentAnyTexture, i, s.drawable, 0));
+            if (s.drawable >= 0) fn(slotKey(KindComponentSet, i, 0, 0));
+        }
+        for (int i = 0; i < kPropSlotCount; ++i) {
+            if (!data.hasSlot(true, i)) continue;
+            const OutfitSlot& s = data.props[i];
+            fn(slotKey(KindProp, i, s.drawable, s.texture));
+            fn(slotKey(KindPropAnyTexture, i, s.drawable, 0));
+            if (s.drawable >= 0) fn(slotKey(KindPropSet, i, 0, 0));
+        }
+    }
+    
+    static void removeFromPosting(QVector<int>& list, int id) {
+        qsizetype pos = list.indexOf(id);
+        if (pos < 0) return;
+        list[pos] = list.last();
+        list.removeLast();
+    }
+    
+    void addPostings(int id) {
+        const OutfitData& data = entries[id].data;
+        forEachKey(data, [this, id](quint64 key) { postings[key].append(id); });
+        if (data.hasModel) modelPostings[data.model].append(id);
+    }
+    
+    void removePostings(int id) {
+        const OutfitData& data = entries[id].data;
+        forEachKey(data, [this, id](quint64 key) {
+            auto it = postings.find(key);
+            if (it == postings.end()) return;
+            removeFromPosting(it.value(), id);
+            if (it.value().isEmpty()) postings.erase(it);
+        });
+        if (data.hasModel) {
+            auto it = modelPostings.find(data.model);
+            if (it != modelPostings.end()) {
+                removeFromPosting(it.value(), id);
+                if (it.value().isEmpty()) modelPostings.erase(it);
+            }
+        }
+    }
+    
+    QVector<Entry> entries;
+    QHash<QString, int> byName;
+    QVector<int> freeIds;
+    QHash<quint64, QVector<int>> postings;
+    QHash<qint64, QVector<int>> modelPostings;
+    bool dirty = false;
+};
+
+QString defaultLibraryPath() {
+    return QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/OutfitConverter/YimMenu";
+}
+
+// Bulk Edit
+// One slot edit applied across many library outfits. Files are read, edited
+// and serialized in parallel without touching the disk; the caller previews
+// the changes, then commits them as one OutputWriter batch after their
+// previous contents have been saved to an undo journal.
+struct BulkEdit {
+    enum class Operation { Set, Replace, Offset };
+    
+    Operation operation = Operation::Set;
+    bool isProp = false;
+    int slot = 0;
+    OutfitSlot match{0, 0};  // Replace only: the value to look for
+    OutfitSlot value{0, 0};  // the new value, or the delta for Offset
+    
+    // Applies the edit to a YimMenu document. Replace and Offset leave
+    // outfits without the slot alone, and Offset also skips empty slots and
+    // stops at the lowest valid drawable and texture. Returns false when
+    // nothing changed.
+    bool apply(QJsonObject& yim, OutfitSlot& before, OutfitSlot& after) const {
+        const char* group = isProp ? "props" : "components";
+        QJsonObject slotObjects = yim.value(group).toObject();
+        QString key = QString::number(slot);
+        bool present = slotObjects.contains(key);
+        QJsonObject slotObject = slotObjects.value(key).toObject();
+        before = {slotObject.value("drawable_id").toInt(), slotObject.value("texture_id").toInt()};
+        
+        switch (operation) {
+            case Operation::Set:
+                after = value;
+                break;
+            case Operation::Replace:
+                if (!present || before.drawable != match.drawable || before.texture != match.texture) return false;
+                after = value;
+                break;
+            case Operation::Offset:
+                if (!present || before.drawable == -1) return false;
+                after = {qMax(isProp ? -1 : 0, before.drawable + value.drawable),
+                         qMax(0, before.texture + value.texture)};
+                break;
+        }
+        if (present && after.drawable == before.drawable && after.texture == before.texture) return false;
+        
+        slotObject["drawable_id"] = after.drawable;
+        slotObject["texture_id"] = after.texture;
+        slotObjects[key] = slotObject;
+        yim[group] = slotObjects;
+        return true;
+    }
+    
+    QString slotName() const {
+        return isProp ? kPropSlotNames[slot] : kComponentSlotNames[slot];
+    }
+};
+
+struct BulkEditChange {
+    QString name;
+    QString path;
+    bool changed = false;
+    bool failed = false;
+    OutfitSlot before{0, 0};
+    OutfitSlot after{0, 0};
+    QByteArray oldData;
+    QByteArray newData;
+    OutfitData outfit;  // the edited outfit, for the index
+};
+
+// Edits every change on all cores, reading its oldData from change.path
+// unless the caller already loaded it. Nothing is written.
+void editBulkChanges(QVector<BulkEditChange>& changes, const BulkEdit& edit) {
+    BulkEditChange* results = changes.data();
+    std::atomic<int> next{0};
+    
+    QThreadPool pool;
+    int workers = qMin(qMax(1, QThread::idealThreadCount()), qMax(1, int(changes.size())));
+    for (int i = 0; i < workers; ++i) {
+        pool.start([&]() {
+            for (int index = next++; index < changes.size(); index = next++) {
+                BulkEditChange& change = results[index];
+                if (change.failed) continue;
+                
+                if (change.oldData.isEmpty()) {
+                    QFile file(change.path);
+                    if (!file.open(QIODevice::ReadOnly)) {
+                        change.failed = true;
+                        continue;
+                    }
+                    change.oldData = file.readAll();
+                    file.close();
+                }
+                
+                QJsonParseError error;
+                QJsonDocument doc = QJsonDocument::fromJson(change.oldData, &error);
+                if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+                    change.failed = true;
+                    continue;
+                }
+                
+                QJsonObject yim = doc.object();
+                change.changed = edit.apply(yim, change.before, change.after);
+                if (change.changed) {
+                    change.newData = QJsonDocument(yim).toJson(QJsonDocument::Indented);
+                    change.outfit = outfitDataFromYim(yim);
+                } else {
+                    change.oldData.clear();
+                }
+            }
+        });
+    }
+    pool.waitForDone();
+}
+
+// Reads and edits the named library outfits on all cores. Nothing is written.
+QVector<BulkEditChange> prepareBulkEdit(const QString& libraryPath, const QStringList& names, const BulkEdit& edit) {
+    QVector<BulkEditChange> changes(names.size());
+    for (int i = 0; i < names.size(); ++i) {
+        changes[i].name = names[i];
+        changes[i].path = libraryPath + "/" + names[i] + ".json";
+    }
+    editBulkChanges(changes, edit);
+    return changes;
+}
+
+// Undo journal for bulk edits: one JSON file per committed edit under
+// .journal/bulk, holding the previous contents of every file it changed and
+// a hash of what the edit wrote. Undo restores only files still holding
+// that content, so later edits to an outfit are never silently reverted.
+class BulkEditJournal {
+public:
+    static QString directory() {
+        return JobJournal::journalDirectory() + "/bulk";
+    }
+    
+    // Newest journal that has not been undone; empty when there is none.
+    static QString latest() {
+        QStringList journals = QDir(directory()).entryList(QStringList() << "*.json", QDir::Files, QDir::Name);
+        return journals.isEmpty() ? QString() : directory() + "/" + journals.last();
+    }
+    
+    // Journals the edit, then writes all changed files as one batch.
+    // Returns the paths that could not be written; the journal path is
+    // empty if nothing was written at all.
+    static QStringList commit(const QString& description, const QVector<BulkEditChange>& changes,
+                              QString& journalPath) {
+        QJsonArray files;
+        for (const BulkEditChange& change : changes) {
+            if (!change.changed) continue;
+            QJsonObject entry;
+            entry["path"] = change.path;
+            entry["before"] = QString::fromLatin1(change.oldData.toBase64());
+            entry["after_hash"] = hashToHex(contentHash64(change.newData));
+            files.append(entry);
+        }
+        
+        QJsonObject journal;
+        journal["edit"] = description;
+        journal["time"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+        journal["files"] = files;
+        
+        QDir().mkpath(directory());
+        journalPath = directory() + "/" + QString::number(QDateTime::currentMSecsSinceEpoch()) + ".json";
+        if (!OutputWriter::instance().write(journalPath, QJsonDocument(journal).toJson(QJsonDocument::Compact))) {
+            journalPath.clear();
+            return QStringList() << directory();
+        }
+        
+        OutputWriter::Group writes;
+        for (const BulkEditChange& change : changes) {
+            if (change.changed) OutputWriter::instance().enqueue(writes, change.path, change.newData);
+        }
+        return OutputWriter::instance().flush(writes);
+    }
+    
+    static QString description(const QString& journalPath) {
+        QFile file(journalPath);
+        if (!file.open(QIODevice::ReadOnly)) return QString();
+        return QJsonDocument::fromJson(file.readAll()).object().value("edit").toString();
+    }
+    
+    // Restores the files a journal recorded and removes it. Files changed
+    // since the edit are listed in skipped and left as they are.
+    static bool undo(const QString& journalPath, QStringList& restored, QStringList& skipped) {
+        QFile file(journalPath);
+        if (!file.open(QIODevice::ReadOnly)) return false;
+        QJsonObject journal = QJsonDocument::fromJson(file.readAll()).object();
+        file.close();
+        
+        OutputWriter::Group writes;
+        const QJsonArray files = journal.value("files").toArray();
+        for (const QJsonValue& value : files) {
+            QJsonObject entry = value.toObject();
+            QString path = entry.value("path").toString();
+            
+            QFile current(path);
+            if (!current.open(QIODevice::ReadOnly) ||
+                hashToHex(contentHash64(current.readAll())) != entry.value("after_hash").toString()) {
+                skipped.append(path);
+                continue;
+            }
+            current.close();
+            
+            OutputWriter::instance().enqueue(writes, path,
+                                             QByteArray::fromBase64(entry.value("before").toString().toLatin1()));
+            restored.append(path);
+        }
+        
+        const QStringList failures = OutputWriter::instance().flush(writes);
+        if (!failures.isEmpty()) {
+            for (const QString& path : failures) restored.removeAll(path);
+            return false;
+        }
+        return QFile::remove(journalPath);
+    }
+};
+
+// Edit History
+// Undo/redo for the outfit editor. A step records one slot's value before
+// and after, so even tens of thousands of steps stay within a few hundred
+// kilobytes. Changes to the same slot in quick succession (spinning a
+// value up and down) coalesce into one step. Steps live in a ring of
+// kMaxSteps, so forgetting the oldest one moves nothing.
+struct SlotEdit {
+    bool isProp = false;
+    qint8 slot = 0;
+    bool wasPresent = true;     // false when the edit added the slot; undo removes it again
+    OutfitSlot before{0, 0};
+    OutfitSlot after{0, 0};
+};
+
+class EditHistory {
+public:
+    static constexpr int kMaxSteps = 10000;
+    static constexpr qint64 kCoalesceMs = 1000;
+    
+    void record(const SlotEdit& edit) {
+        count = position;
+        
+        qint64 now = QDateTime::currentMSecsSinceEpoch();
+        if (count > 0 && now - lastRecorded < kCoalesceMs &&
+            step(count - 1).isProp == edit.isProp && step(count - 1).slot == edit.slot) {
+            SlotEdit& last = step(count - 1);
+            last.after = edit.after;
+            if (last.wasPresent && last.after.drawable == last.before.drawable &&
+                last.after.texture == last.before.texture) {
+                count--;
+            }
+        } else {
+            if (count == kMaxSteps) {
+                head = (head + 1) % kMaxSteps;
+                count--;
+            }
+            // The ring only grows until it first fills; head stays 0 until then.
+            int index = (head + count) % kMaxSteps;
+            if (index == ring.size()) ring.append(edit);
+            else ring[index] = edit;
+            count++;
+        }
+        position = count;
+        lastRecorded = now;
+    }
+    
+    bool canUndo() const { return position > 0; }
+    bool canRedo() const { return position < count; }
+    
+    // The step to revert; apply its before value.
+    SlotEdit undo() {
+        lastRecorded = 0;
+        return step(--position);
+    }
+    
+    // The step to reapply; apply its after value.
+    SlotEdit redo() {
+        lastRecorded = 0;
+        return step(position++);
+    }
+    
+    void clear() {
+        ring.clear();
+        head = 0;
+        count = 0;
+        position = 0;
+        lastRecorded = 0;
+    }
+    
+private:
+    SlotEdit& step(int i) { return ring[(head + i) % kMaxSteps]; }
+    
+    QVector<SlotEdit> ring;
+    int head = 0;      // oldest step
+    int count = 0;     // steps kept, the redo tail included
+    int position = 0;  // steps applied
+    qint64 lastRecorded = 0;
+};
+
+#ifdef OUTFIT_SQL_LIBRARY
+// Library Store
+// Optional SQLite home for the outfit library (configure with
+// -DOUTFIT_SQL_LIBRARY=ON). Every outfit keeps its YimMenu JSON as written;
+// its slots are mirrored into typed components/props tables with value
+// indices, so listing, structured search and bulk edits are single queries
+// and a rename is one transaction instead of a file move. WAL mode lets
+// lookups run while the editor saves. importDirectory() and exportDirectory()
+// move a library between the store and the usual file layout.
+class LibraryStore {
+public:
+    static QString defaultPath() {
+        return outputRootPath() + "/library.sqlite";
+    }
+    
+    // Each store is its own connection; use one store per thread.
+    LibraryStore() {
+        static std::atomic<int> connections{0};
+        db = QSqlDatabase::addDatabase("QSQLITE", QString("outfit-library-%1").arg(connections++));
+    }
+    
+    ~LibraryStore() {
+        QString connection = db.connectionName();
+        statements.reset();
+        db.close();
+        db = QSqlDatabase();
+        QSqlDatabase::removeDatabase(connection);
+    }
+    
+    LibraryStore(const LibraryStore&) = delete;
+    LibraryStore& operator=(const LibraryStore&) = delete;
+    
+    bool open(const QString& path, QString* error = nullptr) {
+        static const char* const schema[] = {
+            "PRAGMA journal_mode=WAL",
+            "PRAGMA synchronous=NORMAL",
+            "PRAGMA foreign_keys=ON",
+            "CREATE TABLE IF NOT EXISTS outfits ("
+            " id INTEGER PRIMARY KEY,"
+            " name TEXT NOT NULL UNIQUE COLLATE NOCASE,"
+            " model INTEGER,"
+            " data BLOB NOT NULL,"
+            " modified INTEGER NOT NULL)",
+            "CREATE TABLE IF NOT EXISTS components ("
+            " outfit INTEGER NOT NULL REFERENCES outfits(id) ON DELETE CASCADE,"
+            " slot INTEGER NOT NULL,"
+            " drawable INTEGER NOT NULL,"
+            " texture INTEGER NOT NULL,"
+            " PRIMARY KEY (outfit, slot)) WITHOUT ROWID",
+            "CREATE TABLE IF NOT EXISTS props ("
+            " outfit INTEGER NOT NULL REFERENCES outfits(id) ON DELETE CASCADE,"
+            " slot INTEGER NOT NULL,"
+            " drawable INTEGER NOT NULL,"
+            " texture INTEGER NOT NULL,"
+            " PRIMARY KEY (outfit, slot)) WITHOUT ROWID",
+            "CREATE INDEX IF NOT EXISTS outfits_model ON outfits(model)",
+            "CREATE INDEX IF NOT EXISTS components_value ON components(slot, drawable, texture)",
+            "CREATE INDEX IF NOT EXISTS props_value ON props(slot, drawable, texture)"};
+        
+        QDir().mkpath(QFileInfo(path).absolutePath());
+        db.setDatabaseName(path);
+        if (!db.open()) {
+            if (error) *error = db.lastError().text();
+            return false;
+        }
+        
+        QSqlQuery query(db);
+        for (const char* statement : schema) {
+            if (!query.exec(statement)) {
+                if (error) *error = query.lastError().text();
+                db.close();
+                return false;
+            }
+        }
+        
+        statements = std::make_unique<Statements>(db);
+        if (!statements->prepare()) {
+            if (error) *error = statements->error;
+            statements.reset();
+            db.close();
+            return false;
+        }
+        return true;
+    }
+    
+    bool isOpen() const { return statements != nullptr; }
+    
+    QStringList names() const {
+        QStringList result;
+        QSqlQuery query(db);
+        query.setForwardOnly(true);
+        if (!query.exec("SELECT name FROM outfits ORDER BY name COLLATE NOCASE")) return result;
+        while (query.next()) result.append(query.value(0).toString());
+        return result;
+    }
+    
+    // The same matches as OutfitIndex::query(), as one SQL statement.
+    QStringList find(const OutfitQuery& outfitQuery, int limit = -1) const {
+        QStringList where;
+        QVariantList values;
+        if (outfitQuery.hasModel) {
+            where.append("o.model = ?");
+            values.append(outfitQuery.model);
+        }
+        for (const OutfitQuery::SlotTerm& term : outfitQuery.slotTerms) {
+            QString slotRows = QString("SELECT 1 FROM %1 s WHERE s.outfit = o.id AND s.slot = %2")
+                                   .arg(term.isProp ? "props" : "components").arg(term.slot);
+            switch (term.match) {
+                case OutfitQuery::Match::Set:
+                    where.append("EXISTS (" + slotRows + " AND s.drawable >= 0)");
+                    break;
+                case OutfitQuery::Match::Unset:
+                    where.append("NOT EXISTS (" + slotRows + " AND s.drawable >= 0)");
+                    break;
+                case OutfitQuery::Match::Value:
+                    if (term.anyTexture) {
+                        where.append("EXISTS (" + slotRows + " AND s.drawable = ?)");
+                        values.append(term.drawable);
+                    } else {
+                        where.append("EXISTS (" + slotRows + " AND s.drawable = ? AND s.texture = ?)");
+                        values.append(term.drawable);
+                        values.append(term.texture);
+                    }
+                    break;
+            }
+        }
+        for (const QString& word : outfitQuery.nameTerms) {
+            where.append("instr(lower(o.name), lower(?)) > 0");
+            values.append(word);
+        }
+        
+        QString sql = "SELECT o.name FROM outfits o";
+        if (!where.isEmpty()) sql += " WHERE " + where.join(" AND ");
+        sql += " ORDER BY o.name COLLATE NOCASE";
+        if (limit >= 0) sql += QString(" LIMIT %1").arg(limit);
+        
+        QStringList result;
+        QSqlQuery query(db);
+        query.setForwardOnly(true);
+        if (!query.prepare(sql)) return result;
+        for (const QVariant& value : values) query.addBindValue(value);
+        if (!query.exec()) return result;
+        while (query.next()) result.append(query.value(0).toString());
+        return result;
+    }
+    
+    bool load(const QString& name, QByteArray& data) const {
+        if (!isOpen()) return false;
+        QSqlQuery& query = statements->select;
+        query.bindValue(0, name);
+        bool found = query.exec() && query.next();
+        if (found) data = query.value(0).toByteArray();
+        query.finish();
+        return found;
+    }
+    
+    bool save(const QString& name, const QByteArray& data) {
+        if (!isOpen() || !db.transaction()) return false;
+        if (!writeRow(name, data)) {
+            db.rollback();
+            return false;
+        }
+        return db.commit();
+    }
+    
+    // Fails without changing anything when to is taken (names compare
+    // case-insensitively, like the files on Windows).
+    bool rename(const QString& from, const QString& to, QString* error = nullptr) {
+        if (!isOpen() || !db.transaction()) {
+            if (error) *error = "The library database is not open";
+            return false;
+        }
+        
+        QSqlQuery query(db);
+        query.prepare("SELECT 1 FROM outfits WHERE name = ? AND name <> ? COLLATE BINARY");
+        query.addBindValue(to);
+        query.addBindValue(from);
+        if (!query.exec() || query.next()) {
+            if (error) *error = "An outfit with this name already exists";
+            db.rollback();
+            return false;
+        }
+        
+        query.prepare("UPDATE outfits SET name = ?, modified = ? WHERE name = ?");
+        query.addBindValue(to);
+        query.addBindValue(QDateTime::currentMSecsSinceEpoch());
+        query.addBindValue(from);
+        if (!query.exec() || query.numRowsAffected() != 1) {
+            if (error) *error = "The outfit is no longer in the library";
+            db.rollback();
+            return false;
+        }
+        if (!db.commit()) {
+            if (error) *error = db.lastError().text();
+            db.rollback();
+            return false;
+        }
+        return true;
+    }
+    
+    // Calls visit with every outfit's name and data, in no particular order.
+    bool forEach(const std::function<void(const QString&, const QByteArray&)>& visit) const {
+        QSqlQuery query(db);
+        query.setForwardOnly(true);
+        if (!query.exec("SELECT name, data FROM outfits")) return false;
+        while (query.next()) visit(query.value(0).toString(), query.value(1).toByteArray());
+        return true;
+    }
+    
+    // Loads the named outfits for editBulkChanges(); missing ones are marked failed.
+    QVector<BulkEditChange> loadForEdit(const QStringList& names) const {
+        QVector<BulkEditChange> changes(names.size());
+        for (int i = 0; i < names.size(); ++i) {
+            changes[i].name = names[i];
+            changes[i].failed = !load(names[i], changes[i].oldData) || changes[i].oldData.isEmpty();
+        }
+        return changes;
+    }
+    
+    // Writes every changed outfit in one transaction: all or nothing.
+    bool commit(const QVector<BulkEditChange>& changes) {
+        if (!isOpen() || !db.transaction()) return false;
+        for (const BulkEditChange& change : changes) {
+            if (change.changed && !writeRow(change.name, change.newData, &change.outfit)) {
+                db.rollback();
+                return false;
+            }
+        }
+        return db.commit();
+    }
+    
+    // Adds or replaces the store's copy of every outfit file in directory
+    // that is newer than its row, in one transaction; the rest are skipped
+    // unread. prune also drops the rows whose file is gone, for when the files
+    // were the library until now. Returns the number imported, or -1 when
+    // nothing was.
+    int importDirectory(const QString& directory, QString* error = nullptr, bool prune = false) {
+        if (!isOpen() || !db.transaction()) return -1;
+        
+        // Names compare case-insensitively, like the files on Windows.
+        QHash<QString, std::pair<QString, qint64>> rows = modifiedTimes();
+        QSet<QString> seen;
+        int imported = 0;
+        QStringList unreadable;
+        QDirIterator it(directory, QStringList() << "*.json", QDir::Files);
+        while (it.hasNext()) {
+            QString path = it.next();
+            QString name = it.fileInfo().completeBaseName();
+            qint64 mtime = it.fileInfo().lastModified().toMSecsSinceEpoch();
+            seen.insert(name.toLower());
+            auto row = rows.constFind(name.toLower());
+            if (row != rows.constEnd() && mtime <= row->second) continue;
+            
+            QFile file(path);
+            if (!file.open(QIODevice::ReadOnly)) {
+                unreadable.append(path);
+                continue;
+            }
+            QByteArray data = file.readAll();
+            file.close();
+            
+            // Exported files are newer than their rows but hold the same
+            // bytes; they only take the file's time, so they are skipped next time.
+            QByteArray stored;
+            if (row != rows.constEnd() && load(row->first, stored) && stored == data) {
+                setModified(row->first, mtime);
+                continue;
+            }
+            if (!writeRow(name, data, nullptr, mtime)) {
+                unreadable.append(path);
+                continue;
+            }
+            imported++;
+        }
+        
+        if (prune && QDir(directory).exists()) {
+            QSqlQuery remove(db);
+            remove.prepare("DELETE FROM outfits WHERE name = ?");
+            for (auto row = rows.constBegin(); row != rows.constEnd(); ++row) {
+                if (seen.contains(row.key())) continue;
+                remove.addBindValue(row->first);
+                if (!remove.exec()) {
+                    if (error) *error = remove.lastError().text();
+                    db.rollback();
+                    return -1;
+                }
+            }
+        }
+        
+        if (!db.commit()) {
+            if (error) *error = db.lastError().text();
+            db.rollback();
+            return -1;
+        }
+        if (error && !unreadable.isEmpty()) {
+            *error = QString("%1 files could not be imported").arg(unreadable.size());
+        }
+        return imported;
+    }
+    
+    // Writes every stored outfit that is newer than its file to directory as
+    // <name>.json through the OutputWriter. Returns the number written, or -1
+    // on a failed write.
+    int exportDirectory(const QString& directory) const {
+        QDir().mkpath(directory);
+        QSqlQuery query(db);
+        query.setForwardOnly(true);
+        if (!query.exec("SELECT name, modified, data FROM outfits")) return -1;
+        
+        OutputWriter::Group writes;
+        int exported = 0;
+        while (query.next()) {
+            QFileInfo file(directory + "/" + query.value(0).toString() + ".json");
+            if (file.exists() && file.lastModified().toMSecsSinceEpoch() >= query.value(1).toLongLong()) continue;
+            OutputWriter::instance().enqueue(writes, file.filePath(), query.value(2).toByteArray());
+            exported++;
+        }
+        return OutputWriter::instance().flush(writes).isEmpty() ? exported : -1;
+    }
+    
+private:
+    // Statements run once per outfit, prepared when the store opens.
+    struct Statements {
+        explicit Statements(const QSqlDatabase& db)
+            : select(db), upsert(db), clearComponents(db), clearProps(db), insertComponent(db), insertProp(db) {}
+        
+        bool prepare() {
+            const std::pair<QSqlQuery*, const char*> sql[] = {
+                {&select, "SELECT data FROM outfits WHERE name = ?"},
+                {&upsert, "INSERT INTO outfits (name, model, data, modified) VALUES (?, ?, ?, ?)"
+                          " ON CONFLICT(name) DO UPDATE SET model = excluded.model,"
+                          " data = excluded.data, modified = excluded.modified RETURNING id"},
+                {&clearComponents, "DELETE FROM components WHERE outfit = ?"},
+                {&clearProps, "DELETE FROM props WHERE outfit = ?"},
+                {&insertComponent, "INSERT INTO components VALUES (?, ?, ?, ?)"},
+                {&insertProp, "INSERT INTO props VALUES (?, ?, ?, ?)"}};
+            for (const auto& [query, text] : sql) {
+                if (!query->prepare(text)) {
+                    error = query->lastError().text();
+                    return false;
+                }
+            }
+            return true;
+        }
+        
+        QSqlQuery select;
+        QSqlQuery upsert;
+        QSqlQuery clearComponents;
+        QSqlQuery clearProps;
+        QSqlQuery insertComponent;
+        QSqlQuery insertProp;
+        QString error;
+    };
+    
+    // Row name and modified time of every outfit, keyed by lower-case name.
+    QHash<QString, std::pair<QString, qint64>> modifiedTimes() const {
+        QHash<QString, std::pair<QString, qint64>> rows;
+        QSqlQuery query(db);
+        query.setForwardOnly(true);
+        if (!query.exec("SELECT name, modified FROM outfits")) return rows;
+        while (query.next()) {
+            QString name = query.value(0).toString();
+            rows.insert(name.toLower(), {name, query.value(1).toLongLong()});
+        }
+        return rows;
+    }
+    
+    bool setModified(const QString& name, qint64 modified) {
+        QSqlQuery query(db);
+        query.prepare("UPDATE outfits SET modified = ? WHERE name = ?");
+        query.addBindValue(modified);
+        query.addBindValue(name);
+        return query.exec();
+    }
+    
+    // Stores data under name and rebuilds its slot rows. The caller holds
+    // a transaction. outfit saves decoding data again when already known;
+    // modified defaults to now.
+    bool writeRow(const QString& name, const QByteArray& data, const OutfitData* outfit = nullptr,
+                  qint64 modified = -1) {
+        OutfitData decodedOutfit;
+        if (!outfit) {
+            arena.reset();
+            DecodedOutfit decoded(arena.resource());
+            if (decodeOutfitJson(data, decoded, OutfitFormat::YimMenu)) {
+                decodedOutfit = decoded.outfit;
+            } else {
+                QJsonDocument doc = QJsonDocument::fromJson(data);
+                if (!doc.isObject()) return false;
+                decodedOutfit = outfitDataFromYim(doc.object());
+            }
+            outfit = &decodedOutfit;
+        }
+        
+        QSqlQuery& upsert = statements->upsert;
+        upsert.bindValue(0, name);
+        upsert.bindValue(1, outfit->hasModel ? QVariant(outfit->model) : QVariant());
+        upsert.bindValue(2, data);
+        upsert.bindValue(3, modified >= 0 ? modified : QDateTime::currentMSecsSinceEpoch());
+        if (!upsert.exec() || !upsert.next()) return false;
+        qint64 id = upsert.value(0).toLongLong();
+        upsert.finish();
+        
+        statements->clearComponents.bindValue(0, id);
+        statements->clearProps.bindValue(0, id);
+        if (!statements->clearComponents.exec() || !statements->clearProps.exec()) return false;
+        
+        for (int isProp = 0; isProp < 2; ++isProp) {
+            QSqlQuery& insert = isProp ? statements->insertProp : statements->insertComponent;
+            int slotCount = isProp ? kPropSlotCount : kComponentSlotCount;
+            for (int slot = 0; slot < slotCount; ++slot) {
+                if (!outfit->hasSlot(isProp, slot)) continue;
+                const OutfitSlot& value = outfit->slot(isProp, slot);
+                insert.bindValue(0, id);
+                insert.bindValue(1, slot);
+                insert.bindValue(2, value.drawable);
+                insert.bindValue(3, value.texture);
+                if (!insert.exec()) return false;
+            }
+        }
+        return true;
+    }
+    
+    QSqlDatabase db;
+    std::unique_ptr<Statements> statements;
+    ConversionArena arena;
+};
+
+// validateLibrary() for a store. Rows are read on this thread, which owns
+// the connection, and validated on all cores through a bounded queue.
+QVector<LibraryValidation> validateLibraryStore(const LibraryStore& store, const SlotLimits& limits) {
+    BoundedQueue<QPair<QString, QByteArray>> queue(1024, 16 * 1024 * 1024);
+    QVector<LibraryValidation> invalid;
+    QMutex invalidMutex;
+    
+    QThreadPool pool;
+    int workers = qMax(1, QThread::idealThreadCount());
+    for (int i = 0; i < workers; ++i) {
+        pool.start([&]() {
+            ConversionArena arena;
+            QPair<QString, QByteArray> outfit;
+            while (queue.pop(outfit)) {
+                LibraryValidation result;
+                validateLibraryOutfit(outfit.first, outfit.second, limits, arena, result);
+                if (result.name.isEmpty()) continue;
+                QMutexLocker locker(&invalidMutex);
+                invalid.append(std::move(result));
+            }
+        });
+    }
+    store.forEach([&](const QString& name, const QByteArray& data) {
+        queue.push(qMakePair(name, data), data.size());
+    });
+    queue.close();
+    pool.waitForDone();
+    
+    sortValidationsByName(invalid);
+    return invalid;
+}
+#endif
+
+// Inbox Watcher
+// Converts outfits dropped into watched folders to YimMenu as soon as the
+// writer has finished with them. Linux uses inotify so only the touched
+// file names are delivered; elsewhere QFileSystemWatcher directory
+// notifications are diffed against the last known size/mtime per file.
+// Files are read, converted and written on a small pool; results come back
+// to the watcher's thread through fileConverted/fileFailed.
+class InboxWatcher : public QObject {
+    Q_OBJECT
+public:
+    explicit InboxWatcher(QObject* parent = nullptr) : QObject(parent) {
+        clock.start();
+        // Outputs of earlier sessions, so a file changed after a restart
+        // still replaces what it was converted to.
+        journal.open(kJournalId);
+        pool.setMaxThreadCount(2);
+        debounceTimer.setInterval(kPollIntervalMs);
+        connect(&debounceTimer, &QTimer::timeout, this, &InboxWatcher::processPending);
+        connect(&fsWatcher, &QFileSystemWatcher::directoryChanged, this, &InboxWatcher::onDirectoryChanged);
+        
+#ifdef Q_OS_LINUX
+        inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotifyFd >= 0) {
+            notifier = new QSocketNotifier(inotifyFd, QSocketNotifier::Read, this);
+            connect(notifier, &QSocketNotifier::activated, this, &InboxWatcher::onInotifyReadable);
+        }
+#endif
+    }
+    
+    ~InboxWatcher() override {
+        // Running conversions use the journal and the claimed names.
+        pool.waitForDone();
+#ifdef Q_OS_LINUX
+        if (inotifyFd >= 0) ::close(inotifyFd);
+#endif
+    }
+    
+    // Where converted files land inside the YimMenu output folder.
+    void setPathTemplate(const PathTemplate& pathTemplate) {
+        if (pathTemplate.isValid()) layout = pathTemplate;
+    }
+    
+    // Starts watching a folder. Files already present are remembered, not
+    // converted; only files created or changed afterwards are picked up.
+    bool addDirectory(const QString& path) {
+        QString dirPath = QDir(path).absolutePath();
+        if (watchedDirs.contains(dirPath)) return true;
+        if (!QDir(dirPath).exists()) return false;
+        
+        // Never watch our own output folder or the watcher would feed itself.
+        if (QDir::cleanPath(dirPath) == QDir::cleanPath(outputRootPath() + "/YimMenu")) return false;
+        
+        bool watching = false;
+#ifdef Q_OS_LINUX
+        if (inotifyFd >= 0) {
+            int wd = inotify_add_watch(inotifyFd, QFile::encodeName(dirPath).constData(),
+                                       IN_CLOSE_WRITE | IN_MOVED_TO | IN_MODIFY | IN_CREATE);
+            if (wd >= 0) {
+                inotifyDirs.insert(wd, dirPath);
+                watching = true;
+            }
+        }
+#endif
+        if (!watching && !fsWatcher.addPath(dirPath)) return false;
+        
+        watchedDirs.append(dirPath);
+        const QFileInfoList files = QDir(dirPath).entryInfoList(QStringList() << "*.json" << "*.txt", QDir::Files);
+        for (const QFileInfo& info : files) {
+            FileState& state = known[info.absoluteFilePath()];
+            state.size = info.size();
+            state.mtime = info.lastModified().toMSecsSinceEpoch();
+        }
+        return true;
+    }
+    
+    void removeDirectory(const QString& path) {
+        QString dirPath = QDir(path).absolutePath();
+        if (!watchedDirs.removeOne(dirPath)) return;
+        
+#ifdef Q_OS_LINUX
+        for (auto it = inotifyDirs.begin(); it != inotifyDirs.end(); ++it) {
+            if (it.value() == dirPath) {
+                inotify_rm_watch(inotifyFd, it.key());
+                inotifyDirs.erase(it);
+                break;
+            }
+        }
+#endif
+        fsWatcher.removePath(dirPath);
+        
+        QString prefix = dirPath + "/";
+        for (auto it = known.begin(); it != known.end();) {
+            if (it.key().startsWith(prefix)) it = known.erase(it);
+            else ++it;
+        }
+        for (auto it = pending.begin(); it != pending.end();) {
+            if (it.key().startsWith(prefix)) it = pending.erase(it);
+            else ++it;
+        }
+    }
+    
+    void clear() {
+        const QStringList dirs = watchedDirs;
+        for (const QString& dir : dirs) removeDirectory(dir);
+    }
+    
+    QStringList directories() const { return watchedDirs; }
+    
+signals:
+    void fileConverted(const QString& inputPath, const QString& outputPath);
+    void fileFailed(const QString& inputPath, const QString& reason);
+    
+private slots:
+    void onDirectoryChanged(const QString& dirPath) {
+        const QFileInfoList files = QDir(dirPath).entryInfoList(QStringList() << "*.json" << "*.txt", QDir::Files);
+        for (const QFileInfo& info : files) {
+            auto it = known.constFind(info.absoluteFilePath());
+            if (it == known.constEnd() || it->size != info.size() ||
+                it->mtime != info.lastModified().toMSecsSinceEpoch()) {
+                schedule(info.absoluteFilePath());
+            }
+        }
+    }
+    
+#ifdef Q_OS_LINUX
+    void onInotifyReadable() {
+        alignas(struct inotify_event) char buffer[4096];
+        ssize_t length;
+        
+        while ((length = ::read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+            for (char* ptr = buffer; ptr < buffer + length;) {
+                const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(ptr);
+                ptr += sizeof(struct inotify_event) + event->len;
+                
+                if (event->len == 0 || (event->mask & IN_ISDIR)) continue;
+                auto it = inotifyDirs.constFind(event->wd);
+                if (it == inotifyDirs.constEnd()) continue;
+                
+                schedule(it.value() + "/" + QFile::decodeName(event->name));
+            }
+        }
+    }
+#endif
+    
+    // A file is converted once it has been quiet for kQuietMs and its size
+    // and mtime held steady across two consecutive checks.
+    void processPending() {
+        qint64 now = clock.elapsed();
+        
+        for (auto it = pending.begin(); it != pending.end();) {
+            if (now - it->lastEventMs < kQuietMs) {
+                ++it;
+                continue;
+            }
+            
+            QFileInfo info(it.key());
+            if (!info.exists()) {
+                it = pending.erase(it);
+                continue;
+            }
+            
+            qint64 mtime = info.lastModified().toMSecsSinceEpoch();
+            if (!it->checked || it->size != info.size() || it->mtime != mtime) {
+                it->checked = true;
+                it->size = info.size();
+                it->mtime = mtime;
+                it->lastEventMs = now - kQuietMs + kPollIntervalMs;
+                ++it;
+                continue;
+            }
+            
+            QString path = it.key();
+            it = pending.erase(it);
+            convertFile(path, info.size(), mtime);
+        }
+        
+        if (pending.isEmpty()) debounceTimer.stop();
+    }
+    
+private:
+    struct FileState {
+        qint64 size = -1;
+        qint64 mtime = -1;
+        QString outputPath;
+    };
+    
+    struct PendingFile {
+        qint64 lastEventMs = 0;
+        qint64 size = -1;
+        qint64 mtime = -1;
+        bool checked = false;
+    };
+    
+    static constexpr int kQuietMs = 200;
+    static constexpr int kPollIntervalMs = 100;
+    static constexpr const char* kJournalId = "watch";
+    
+    void schedule(const QString& path) {
+        if (!isOutfitFileName(path)) return;
+        
+        PendingFile& entry = pending[path];
+        entry.lastEventMs = clock.elapsed();
+        entry.checked = false;
+        if (!debounceTimer.isActive()) debounceTimer.start();
+    }
+    
+    void convertFile(const QString& path, qint64 size, qint64 mtime) {
+        // A file still being converted gets another look once that is done.
+        if (converting.contains(path)) {
+            schedule(path);
+            return;
+        }
+        const FileState state = known.value(path);
+        if (state.size == size && state.mtime == mtime) return;
+        
+        converting.insert(path);
+        QPointer<InboxWatcher> self(this);
+        pool.start([this, self, path, size, mtime, previousOutput = state.outputPath, pathLayout = layout]() {
+            // The destructor waits for the pool, so this outlives the task.
+            QString outputPath;
+            QString error = convertOnPool(path, size, mtime, previousOutput, pathLayout, outputPath);
+            QMetaObject::invokeMethod(qApp, [self, path, size, mtime, outputPath, error]() {
+                if (self) self->onFileDone(path, size, mtime, outputPath, error);
+            }, Qt::QueuedConnection);
+        });
+    }
+    
+    // Runs on the pool. Returns why the file could not be converted, or an
+    // empty string with outputPath set once it has been written.
+    QString convertOnPool(const QString& path, qint64 size, qint64 mtime, const QString& previousOutput,
+                          const PathTemplate& pathLayout, QString& outputPath) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) return "Could not open file";
+        QByteArray data = file.readAll();
+        file.close();
+        
+        OutfitFormat fmt = detectFormatFromData(data, path);
+        if (fmt == OutfitFormat::Unknown) return "Unknown outfit format";
+        
+        QByteArray yimJson = convertDataToYimUtf8(data, fmt, conversionScratch().writer);
+        if (yimJson.isEmpty()) return "Conversion failed";
+        
+        PathContext context = pathContextFor(path);
+        context.format = fmt;
+        context.hash = contentHash64(data);
+        if (pathLayout.usesModel()) {
+            DecodedOutfit decoded;
+            if (decodeOutfitJson(yimJson, decoded, OutfitFormat::YimMenu)) {
+                context.hasModel = decoded.outfit.hasModel;
+                context.model = decoded.outfit.model;
+            }
+        }
+        QString relativePath;
+        pathLayout.resolve(context, relativePath);
+        QString candidate = outputRootPath() + "/YimMenu/" + relativePath;
+        
+        // A changed input replaces its earlier output instead of piling up
+        // more _N copies. The name is claimed until it exists on disk, so two
+        // files converting at once cannot pick the same one.
+        {
+            QMutexLocker locker(&outputMutex);
+            outputPath = previousOutput.isEmpty() ? journal.outputFor(path) : previousOutput;
+            if (outputPath.isEmpty() || !isOutputPathFor(outputPath, candidate)) {
+                outputPath = uniqueOutputPath(candidate, &claimedOutputs);
+            }
+            claimedOutputs.insert(outputPath);
+        }
+        QDir().mkpath(QFileInfo(outputPath).absolutePath());
+        bool written = OutputWriter::instance().write(outputPath, yimJson);
+        {
+            QMutexLocker locker(&outputMutex);
+            claimedOutputs.remove(outputPath);
+        }
+        
+        if (!written) return "Could not write " + outputPath;
+        journal.record(path, size, mtime, context.hash, outputPath);
+        return QString();
+    }
+    
+    // The file's size and mtime are only remembered once it converted, so a
+    // file that was locked, half written or failed to write is tried again
+    // on its next change or directory scan.
+    void onFileDone(const QString& path, qint64 size, qint64 mtime, const QString& outputPath, const QString& error) {
+        converting.remove(path);
+        FileState& state = known[path];
+        if (!error.isEmpty()) {
+            state.size = -1;
+            state.mtime = -1;
+            emit fileFailed(path, error);
+            return;
+        }
+        
+        state.size = size;
+        state.mtime = mtime;
+        state.outputPath = outputPath;
+        emit fileConverted(path, outputPath);
+    }
+    
+    QStringList watchedDirs;
+    PathTemplate layout = PathTemplate::compile(kDefaultPathTemplate);
+    JobJournal journal;
+    QHash<QString, FileState> known;
+    QSet<QString> converting;              // paths with a conversion on the pool
+    QMutex outputMutex;
+    QSet<QString> claimedOutputs;          // output names picked but not yet written
+    QHash<QString, PendingFile> pending;
+    QFileSystemWatcher fsWatcher;
+    QTimer debounceTimer;
+    QElapsedTimer clock;
+    QThreadPool pool;
+    
+#ifdef Q_OS_LINUX
+    int inotifyFd = -1;
+    QSocketNotifier* notifier = nullptr;
+    QHash<int, QString> inotifyDirs;
+#endif
+};
+
+#ifdef OUTFIT_CONVERSION_SERVER
+// Conversion Server
+// Keeps a converter warm for other programs on the same machine, so a bot
+// or launcher does not start the binary once per outfit. Clients connect to
+// a local socket (or a localhost TCP port) and exchange frames:
+//
+//   request:  u32 length | u8 kind | u8 from | u8 to     | u8 0 | u32 id | payload
+//   response: u32 length | u8 kind | u8 status | u8 format | u8 0 | u32 id | payload
+//
+// Integers are little-endian and length counts the bytes after itself.
+// Formats are numbered as in outfit_converter.h. A convert request carries
+// a file's bytes (from 0 = detect) and is answered with the converted bytes
+// and the source format; a stats request is answered with a JSON object.
+// Requests may be pipelined: they run on a pool whose threads keep their
+// conversion scratch between requests, and each response goes out as soon
+// as it is ready, so clients match them up by id.
+class ConversionServer : public QObject {
+    Q_OBJECT
+public:
+    enum Kind : quint8 { Convert = 1, Stats = 2 };
+    enum Status : quint8 { Ok = 0, BadRequest = 1, Unrecognized = 2, Failed = 3, TooLarge = 4 };
+    
+    static constexpr int kHeaderBytes = 12;
+    static constexpr quint32 kMaxFrameBytes = 16 * 1024 * 1024;
+    // Requests a connection may have queued before the server stops reading
+    // from it, which pushes back on the client through the socket.
+    static constexpr int kMaxInFlight = 256;
+    // Bytes Qt buffers per socket ahead of readFrames(); past this it stops
+    // reading and the kernel's socket buffer fills up instead.
+    static constexpr qint64 kReadBufferBytes = 1024 * 1024;
+    
+    explicit ConversionServer(int threads, QObject* parent = nullptr)
+        : QObject(parent), buffers(kMaxInFlight) {
+        pool.setMaxThreadCount(threads > 0 ? threads : qMax(1, QThread::idealThreadCount()));
+        // Idle threads would otherwise exit and take their warm scratch along.
+        pool.setExpiryTimeout(-1);
+        uptime.start();
+    }
+    
+    ~ConversionServer() override {
+        pool.waitForDone();
+    }
+    
+    static QByteArray frame(quint8 kind, quint8 a, quint8 b, quint32 id, const QByteArray& payload) {
+        QByteArray bytes(kHeaderBytes, '\0');
+        qToLittleEndian<quint32>(quint32(kHeaderBytes - 4 + payload.size()), bytes.data());
+        bytes[4] = char(kind);
+        bytes[5] = char(a);
+        bytes[6] = char(b);
+        qToLittleEndian<quint32>(id, bytes.data() + 8);
+        bytes.append(payload);
+        return bytes;
+    }
+    
+    // "tcp:<port>" listens on localhost only (port 0 picks a free one);
+    // anything else names a local socket, a named pipe on Windows.
+    bool listen(const QString& address, QString* error) {
+        if (address.startsWith("tcp:")) {
+            bool ok = false;
+            quint16 port = address.mid(4).toUShort(&ok);
+            tcpServer = new QTcpServer(this);
+            if (!ok || !tcpServer->listen(QHostAddress::LocalHost, port)) {
+                if (error) *error = ok ? tcpServer->errorString() : "invalid port in " + address;
+                return false;
+            }
+            connect(tcpServer, &QTcpServer::newConnection, this, [this]() {
+                while (QTcpSocket* socket = tcpServer->nextPendingConnection()) {
+                    socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+                    socket->setReadBufferSize(kReadBufferBytes);
+                    connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+                    addConnection(socket);
+                }
+            });
+            listenAddress = QString("tcp:%1").arg(tcpServer->serverPort());
+            return true;
+        }
+        
+        // A socket file left behind by a crashed server would block listen(),
+        // but one that still answers belongs to a running server.
+        QLocalSocket probe;
+        probe.connectToServer(address);
+        if (probe.waitForConnected(1000)) {
+            if (error) *error = "another server is already listening there";
+            return false;
+        }
+        QLocalServer::removeServer(address);
+        
+        localServer = new QLocalServer(this);
+        if (!localServer->listen(address)) {
+            if (error) *error = localServer->errorString();
+            return false;
+        }
+        connect(localServer, &QLocalServer::newConnection, this, [this]() {
+            while (QLocalSocket* socket = localServer->nextPendingConnection()) {
+                socket->setReadBufferSize(kReadBufferBytes);
+                connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+                addConnection(socket);
+            }
+        });
+        listenAddress = localServer->fullServerName();
+        return true;
+    }
+    
+    QString address() const { return listenAddress; }
+    
+private:
+    struct Connection {
+        QIODevice* socket = nullptr;
+        QByteArray inbox;
+        int inFlight = 0;
+    };
+    
+    struct Counters {
+        qint64 connections = 0;
+        qint64 requests = 0;
+        qint64 converted = 0;
+        qint64 unrecognized = 0;
+        qint64 failed = 0;
+        qint64 rejected = 0;
+        qint64 inFlight = 0;
+        qint64 bytesIn = 0;
+        qint64 bytesOut = 0;
+        qint64 convertMicros = 0;
+        qint64 bySource[5] = {};
+    };
+    
+    void addConnection(QIODevice* socket) {
+        quint64 id = nextConnectionId++;
+        connections.insert(id, Connection{socket, QByteArray(), 0});
+        counters.connections++;
+        connect(socket, &QIODevice::readyRead, this, [this, id]() { readFrames(id); });
+        connect(socket, &QObject::destroyed, this, [this, id]() { connections.remove(id); });
+    }
+    
+    void readFrames(quint64 connectionId) {
+        auto it = connections.find(connectionId);
+        if (it == connections.end()) return;
+        Connection& connection = *it;
+        
+        qsizetype consumed = 0;
+        while (connection.inFlight < kMaxInFlight) {
+            if (connection.inbox.size() - consumed < 4) {
+                // Read only while there is room. The socket's read buffer is
+                // bounded, so what stays unread backs up into the kernel.
+                if (consumed > 0) {
+                    connection.inbox.remove(0, consumed);
+                    consumed = 0;
+                }
+                QByteArray incoming = connection.socket->readAll();
+                if (incoming.isEmpty()) break;
+                counters.bytesIn += incoming.size();
+                connection.inbox.append(incoming);
+                continue;
+            }
+            
+            const char* header = connection.inbox.constData() + consumed;
+            quint32 length = qFromLittleEndian<quint32>(header);
+            if (length < kHeaderBytes - 4 || length > kMaxFrameBytes) {
+                // The stream cannot be resynchronized after a bad length.
+                counters.rejected++;
+                send(connection, 0, length > kMaxFrameBytes ? TooLarge : BadRequest, 0, 0, QByteArray());
+                connection.socket->close();
+                return;
+            }
+            if (connection.inbox.size() - consumed < qsizetype(4 + length)) {
+                QByteArray incoming = connection.socket->readAll();
+                if (incoming.isEmpty()) break;
+                counters.bytesIn += incoming.size();
+                connection.inbox.append(incoming);
+                continue;
+            }
+            
+            quint8 kind = quint8(header[4]);
+            quint8 from = quint8(header[5]);
+            quint8 to = quint8(header[6]);
+            quint32 id = qFromLittleEndian<quint32>(header + 8);
+            QByteArray payload = buffers.acquire();
+            payload.append(header + kHeaderBytes, length - (kHeaderBytes - 4));
+            consumed += 4 + length;
+            handle(connectionId, connection, kind, from, to, id, std::move(payload));
+        }
+        if (consumed > 0) connection.inbox.remove(0, consumed);
+    }
+    
+    void handle(quint64 connectionId, Connection& connection, quint8 kind, quint8 from, quint8 to, quint32 id,
+                QByteArray payload) {
+        counters.requests++;
+        if (kind == Stats) {
+            buffers.release(payload);
+            send(connection, Stats, Ok, 0, id, QJsonDocument(stats()).toJson(QJsonDocument::Compact));
+            return;
+        }
+        
+        auto isFormat = [](quint8 format) { return format <= quint8(OutfitFormat::Stand); };
+        if (kind != Convert || !isFormat(from) || !isFormat(to) || to == quint8(OutfitFormat::Unknown)) {
+            buffers.release(payload);
+            counters.rejected++;
+            send(connection, kind, BadRequest, 0, id, QByteArray());
+            return;
+        }
+        
+        connection.inFlight++;
+        counters.inFlight++;
+        pool.start([this, connectionId, id, from, to, payload = std::move(payload)]() mutable {
+            QElapsedTimer timer;
+            timer.start();
+            QByteArray result;
+            OutfitFormat source = OutfitFormat::Unknown;
+            ConvertResult outcome = convertOutfitBytes(payload, OutfitFormat(from), OutfitFormat(to),
+                                                       conversionScratch(), result, &source);
+            qint64 micros = timer.nsecsElapsed() / 1000;
+            
+            QMetaObject::invokeMethod(this, [this, connectionId, id, outcome, source, micros,
+                                             payload = std::move(payload), result = std::move(result)]() mutable {
+                finish(connectionId, id, outcome, source, result, payload, micros);
+            }, Qt::QueuedConnection);
+        });
+    }
+    
+    void finish(quint64 connectionId, quint32 id, ConvertResult outcome, OutfitFormat source, const QByteArray& result,
+                QByteArray& payload, qint64 micros) {
+        counters.inFlight--;
+        counters.convertMicros += micros;
+        counters.bySource[int(source)]++;
+        if (outcome == ConvertResult::Ok) counters.converted++;
+        else if (outcome == ConvertResult::Unrecognized) counters.unrecognized++;
+        else counters.failed++;
+        
+        auto it = connections.find(connectionId);
+        if (it == connections.end()) {
+            buffers.release(payload);
+            return;
+        }
+        
+        Status status = outcome == ConvertResult::Ok ? Ok
+                      : outcome == ConvertResult::Unrecognized ? Unrecognized : Failed;
+        send(*it, Convert, status, quint8(source), id, status == Ok ? result : QByteArray());
+        // A same-format result shares the payload, so it goes back only now.
+        buffers.release(payload);
+        
+        // Picks up frames left unread while the connection was at its limit;
+        // no readyRead comes for data that was already buffered.
+        it->inFlight--;
+        if (it->inFlight == kMaxInFlight - 1 && (!it->inbox.isEmpty() || it->socket->bytesAvailable() > 0)) {
+            readFrames(connectionId);
+        }
+    }
+    
+    void send(Connection& connection, quint8 kind, quint8 status, quint8 format, quint32 id, const QByteArray& payload) {
+        QByteArray bytes = frame(kind, status, format, id, payload);
+        counters.bytesOut += bytes.size();
+        connection.socket->write(bytes);
+    }
+    
+    QJsonObject stats() const {
+        QJsonObject json;
+        json["address"] = listenAddress;
+        json["uptimeMs"] = uptime.elapsed();
+        json["threads"] = pool.maxThreadCount();
+        json["connections"] = connections.size();
+        json["connectionsTotal"] = counters.connections;
+        json["requests"] = counters.requests;
+        json["converted"] = counters.converted;
+        json["unrecognized"] = counters.unrecognized;
+        json["failed"] = counters.failed;
+        json["rejected"] = counters.rejected;
+        json["inFlight"] = counters.inFlight;
+        json["bytesIn"] = counters.bytesIn;
+        json["bytesOut"] = counters.bytesOut;
+        
+        qint64 finished = counters.converted + counters.unrecognized + counters.failed;
+        json["convertMicros"] = counters.convertMicros;
+        json["averageConvertMicros"] = finished > 0 ? double(counters.convertMicros) / finished : 0.0;
+        
+        QJsonObject bySource;
+        for (OutfitFormat format : {OutfitFormat::Cherax, OutfitFormat::YimMenu, OutfitFormat::Lexis, OutfitFormat::Stand}) {
+            bySource[formatName(format)] = counters.bySource[int(format)];
+        }
+        json["bySource"] = bySource;
+        return json;
+    }
+    
+    QThreadPool pool;
+    BufferPool buffers;
+    QLocalServer* localServer = nullptr;
+    QTcpServer* tcpServer = nullptr;
+    QString listenAddress;
+    QHash<quint64, Connection> connections;
+    quint64 nextConnectionId = 1;
+    Counters counters;
+    QElapsedTimer uptime;
+};
+#endif
+
+// Startup Trace
+// Set OUTFIT_TRACE_STARTUP=1 or pass --trace-startup to print the time from
+// entering main() to each startup milestone on stderr.
+class StartupTrace {
+public:
+    static StartupTrace& instance() {
+        static StartupTrace trace;
+        return trace;
+    }
+    
+    void enable() { enabled = true; }
+    bool isEnabled() const { return enabled; }
+    
+    void mark(const QString& milestone) {
+        if (!enabled) return;
+        std::fprintf(stderr, "[startup] %8.1f ms  %s\n", timer.nsecsElapsed() / 1e6, qPrintable(milestone));
+        std::fflush(stderr);
+    }
+    
+private:
+    StartupTrace() { timer.start(); }
+    
+    QElapsedTimer timer;
+    bool enabled = false;
+};
+
+// Tab page that builds its contents the first time it is shown, so startup
+// only pays for the tab the user actually sees.
+class LazyTab : public QWidget {
+    Q_OBJECT
+public:
+    using Factory = std::function<QWidget*(QWidget* parent)>;
+    
+    LazyTab(const QString& name, Factory factory, QWidget* parent = nullptr)
+        : QWidget(parent), name(name), factory(std::move(factory)) {}
+    
+protected:
+    void showEvent(QShowEvent* event) override {
+        if (factory) {
+            Factory build = std::move(factory);
+            factory = nullptr;
+            
+            QVBoxLayout* layout = new QVBoxLayout(this);
+            layout->setContentsMargins(0, 0, 0, 0);
+            layout->addWidget(build(this));
+            StartupTrace::instance().mark(name + " tab built");
+        }
+        QWidget::showEvent(event);
+    }
+    
+private:
+    QString name;
+    Factory factory;
+};
+
+// Batch Preview
+// Table of the files loaded for a batch. Rows start out as bare paths; the
+// format, model and slot count are sniffed on background threads, rows the
+// view asks for first and the rest in a sweep behind them, so a 100k-file
+// batch opens instantly and stays scrollable. Excluded rows and per-row
+// format overrides feed the conversion.
+class BatchPreviewModel : public QAbstractTableModel {
+    Q_OBJECT
+public:
+    enum Column { FileColumn, FormatColumn, ModelColumn, SlotsColumn, ColumnCount };
+    
+    explicit BatchPreviewModel(QObject* parent = nullptr) : QAbstractTableModel(parent) {
+        sniffPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+        dispatchTimer.setSingleShot(true);
+        dispatchTimer.setInterval(0);
+        connect(&dispatchTimer, &QTimer::timeout, this, &BatchPreviewModel::dispatch);
+    }
+    
+    ~BatchPreviewModel() override {
+        generation++;
+        sniffPool.clear();
+        sniffPool.waitForDone();
+    }
+    
+    void setFiles(const QStringList& paths) {
+        beginResetModel();
+        generation++;
+        rows.clear();
+        rows.resize(paths.size());
+        for (int i = 0; i < paths.size(); ++i) {
+            rows[i].path = paths[i];
+        }
+        viewRequests.clear();
+        sweepCursor = 0;
+        sniffedCount = 0;
+        unknownCount = 0;
+        excludedRows = 0;
+        endResetModel();
+        emit summaryChanged();
+        dispatchTimer.start();
+    }
+    
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override {
+        return parent.isValid() ? 0 : rows.size();
+    }
+    
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override {
+        return parent.isValid() ? 0 : ColumnCount;
+    }
+    
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override {
+        if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+        switch (section) {
+            case FileColumn: return "File";
+            case FormatColumn: return "Format";
+            case ModelColumn: return "Model";
+            case SlotsColumn: return "Slots";
+            default: return QVariant();
+        }
+    }
+    
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override {
+        if (!index.isValid() || index.row() >= rows.size()) return QVariant();
+        const Row& row = rows[index.row()];
+        
+        if (role == Qt::CheckStateRole && index.column() == FileColumn) {
+            return row.excluded ? Qt::Unchecked : Qt::Checked;
+        }
+        if (role == Qt::ToolTipRole && index.column() == FileColumn) {
+            return row.path;
+        }
+        if (role == Qt::ForegroundRole) {
+            if (row.excluded) return QColor("#666");
+            if (row.state == Row::Sniffed && row.format == OutfitFormat::Unknown) return QColor("#ff6b6b");
+            return QVariant();
+        }
+        if (role != Qt::DisplayRole) return QVariant();
+        
+        switch (index.column()) {
+            case FileColumn:
+                return QFileInfo(row.path).fileName();
+            case FormatColumn:
+                if (row.state != Row::Sniffed && !row.overridden) return "…";
+                if (row.overridden) return formatName(row.format) + " (manual)";
+                return row.readable ? formatName(row.format) : "Unreadable";
+            case ModelColumn:
+                if (row.state != Row::Sniffed || !row.hasModel) return QVariant();
+                return ModelRegistry::label(row.model);
+            case SlotsColumn:
+                if (row.state != Row::Sniffed || row.format == OutfitFormat::Unknown) return QVariant();
+                return row.slotCount;
+            default:
+                return QVariant();
+        }
+    }
+    
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override {
+        if (!index.isValid() || role != Qt::CheckStateRole || index.column() != FileColumn) return false;
+        setRowExcluded(rows[index.row()], value.toInt() != Qt::Checked);
+        emit dataChanged(index.siblingAtColumn(0), index.siblingAtColumn(ColumnCount - 1));
+        emit summaryChanged();
+        return true;
+    }
+    
+    Qt::ItemFlags flags(const QModelIndex& index) const override {
+        Qt::ItemFlags result = QAbstractTableModel::flags(index);
+        if (index.column() == FileColumn) result |= Qt::ItemIsUserCheckable;
+        return result;
+    }
+    
+    void setExcluded(const QModelIndexList& indexes, bool excluded) {
+        for (const QModelIndex& index : indexes) {
+            setRowExcluded(rows[index.row()], excluded);
+        }
+        emitAllChanged();
+    }
+    
+    // Excludes every row already known to be unconvertible.
+    int excludeUnknown() {
+        int count = 0;
+        for (Row& row : rows) {
+            if (row.state == Row::Sniffed && row.format == OutfitFormat::Unknown && !row.overridden && !row.excluded) {
+                setRowExcluded(row, true);
+                count++;
+            }
+        }
+        emitAllChanged();
+        return count;
+    }
+    
+    // Forces a format on rows detection got wrong; Unknown restores detection.
+    void setFormatOverride(const QModelIndexList& indexes, OutfitFormat format) {
+        for (const QModelIndex& index : indexes) {
+            Row& row = rows[index.row()];
+            row.overridden = format != OutfitFormat::Unknown;
+            if (row.overridden) {
+                row.format = format;
+            } else if (row.state == Row::Sniffed) {
+                row.format = row.detectedFormat;
+            }
+        }
+        emitAllChanged();
+    }
+    
+    QStringList includedFiles() const {
+        QStringList paths;
+        for (const Row& row : rows) {
+            if (!row.excluded) paths.append(row.path);
+        }
+        return paths;
+    }
+    
+    QHash<QString, OutfitFormat> formatOverrides() const {
+        QHash<QString, OutfitFormat> overrides;
+        for (const Row& row : rows) {
+            if (row.overridden && !row.excluded) {
+                overrides.insert(QFileInfo(row.path).absoluteFilePath(), row.format);
+            }
+        }
+        return overrides;
+    }
+    
+    // Sniffs rows first..last ahead of the background sweep; the view calls
+    // this with the rows it shows.
+    void requestRows(int first, int last) {
+        first = qMax(first, 0);
+        last = qMin(last, int(rows.size()) - 1);
+        // Queued last to first, as dispatch() takes the newest request first.
+        for (int row = last; row >= first; --row) {
+            if (rows[row].state == Row::Pending) requestSniff(row);
+        }
+    }
+    
+    int totalCount() const { return rows.size(); }
+    int sniffed() const { return sniffedCount; }
+    int unknown() const { return unknownCount; }
+    
+    int excludedCount() const { return excludedRows; }
+    
+signals:
+    void summaryChanged();
+    
+private:
+    struct Row {
+        enum State : quint8 { Pending, Queued, Sniffed };
+        
+        QString path;
+        qint64 model = 0;
+        OutfitFormat format = OutfitFormat::Unknown;
+        OutfitFormat detectedFormat = OutfitFormat::Unknown;
+        quint8 slotCount = 0;
+        State state = Pending;
+        bool hasModel = false;
+        bool readable = true;
+        bool excluded = false;
+        bool overridden = false;
+    };
+    
+    struct SniffResult {
+        int row = 0;
+        OutfitFormat format = OutfitFormat::Unknown;
+        bool readable = false;
+        bool hasModel = false;
+        qint64 model = 0;
+        int slotCount = 0;
+    };
+    
+    static constexpr int kChunkRows = 32;
+    
+    static SniffResult sniff(int rowIndex, const QString& path, ConversionArena& arena) {
+        SniffResult result;
+        result.row = rowIndex;
+        
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) return result;
+        QByteArray data = file.readAll();
+        file.close();
+        result.readable = true;
+        
+        arena.reset();
+        OutfitData outfit;
+        DecodedOutfit decoded(arena.resource());
+        if (!path.endsWith(".txt", Qt::CaseInsensitive) && decodeOutfitJson(data, decoded)) {
+            result.format = decoded.format;
+            outfit = decoded.outfit;
+        } else {
+            result.format = detectFormatFromData(data, path, arena.resource());
+            if (result.format == OutfitFormat::Unknown) return result;
+            outfit = outfitDataFromYim(QJsonDocument::fromJson(convertDataToYim(data, result.format).toUtf8()).object());
+        }
+        
+        result.hasModel = outfit.hasModel;
+        result.model = outfit.model;
+        result.slotCount = qPopulationCount(outfit.componentMask) + qPopulationCount(outfit.propMask);
+        return result;
+    }
+    
+    void setRowExcluded(Row& row, bool excluded) {
+        if (row.excluded == excluded) return;
+        row.excluded = excluded;
+        excludedRows += excluded ? 1 : -1;
+    }
+    
+    void requestSniff(int row) {
+        rows[row].state = Row::Queued;
+        viewRequests.append(row);
+        if (!dispatchTimer.isActive()) dispatchTimer.start();
+    }
+    
+    // Keeps every sniff thread busy with a chunk: the most recently viewed
+    // rows first, then the next rows of the background sweep.
+    void dispatch() {
+        int maxInFlight = sniffPool.maxThreadCount() * 2;
+        while (inFlight < maxInFlight) {
+            QVector<QPair<int, QString>> chunk;
+            while (chunk.size() < kChunkRows && !viewRequests.isEmpty()) {
+                int row = viewRequests.takeLast();
+                chunk.append(qMakePair(row, rows[row].path));
+            }
+            while (chunk.size() < kChunkRows && sweepCursor < rows.size()) {
+                Row& row = rows[sweepCursor];
+                if (row.state == Row::Pending) {
+                    row.state = Row::Queued;
+                    chunk.append(qMakePair(sweepCursor, row.path));
+                }
+                sweepCursor++;
+            }
+            if (chunk.isEmpty()) return;
+            
+            inFlight++;
+            quint64 chunkGeneration = generation;
+            QPointer<BatchPreviewModel> self(this);
+            sniffPool.start([this, self, chunk, chunkGeneration]() {
+                // The destructor waits for the pool, so generation outlives us.
+                ConversionArena arena;
+                QVector<SniffResult> results;
+                results.reserve(chunk.size());
+                for (const auto& entry : chunk) {
+                    if (generation.load() != chunkGeneration) break;
+                    results.append(sniff(entry.first, entry.second, arena));
+                }
+                QMetaObject::invokeMethod(qApp, [self, results, chunkGeneration]() {
+                    if (self) self->applyResults(results, chunkGeneration);
+                }, Qt::QueuedConnection);
+            });
+        }
+    }
+    
+    void applyResults(const QVector<SniffResult>& results, quint64 resultGeneration) {
+        inFlight--;
+        if (resultGeneration == generation) {
+            int first = rows.size();
+            int last = -1;
+            for (const SniffResult& result : results) {
+                Row& row = rows[result.row];
+                row.state = Row::Sniffed;
+                row.readable = result.readable;
+                row.detectedFormat = result.format;
+                if (!row.overridden) row.format = result.format;
+                row.hasModel = result.hasModel;
+                row.model = result.model;
+                row.slotCount = quint8(result.slotCount);
+                sniffedCount++;
+                if (result.format == OutfitFormat::Unknown) unknownCount++;
+                first = qMin(first, result.row);
+                last = qMax(last, result.row);
+            }
+            if (last >= 0) {
+                emit dataChanged(index(first, 0), index(last, ColumnCount - 1));
+                emit summaryChanged();
+            }
+        }
+        dispatch();
+    }
+    
+    void emitAllChanged() {
+        if (rows.isEmpty()) return;
+        emit dataChanged(index(0, 0), index(rows.size() - 1, ColumnCount - 1));
+        emit summaryChanged();
+    }
+    
+    QVector<Row> rows;
+    QVector<int> viewRequests;
+    int sweepCursor = 0;
+    int inFlight = 0;
+    int sniffedCount = 0;
+    int unknownCount = 0;
+    int excludedRows = 0;
+    std::atomic<quint64> generation{0};
+    QThreadPool sniffPool;
+    QTimer dispatchTimer;
+};
+
+class DropZone : public QWidget {
+    Q_OBJECT
+public:
+    explicit DropZone(QWidget* parent = nullptr) : QWidget(parent), batchMode(false) {
+        setAcceptDrops(true);
+        setMinimumHeight(200);
+        
+        QVBoxLayout* layout = new QVBoxLayout(this);
+        layout->setAlignment(Qt::AlignCenter);
+        
+        iconLabel = new QLabel("📁", this);
+        iconLabel->setAlignment(Qt::AlignCenter);
+        iconLabel->setStyleSheet("font-size: 48px;");
+        
+        textLabel = new QLabel("Drop file(s) here or click to browse\nSupports: .json (Cherax/YimMenu/Lexis) and .txt (Stand)", this);
+        textLabel->setAlignment(Qt::AlignCenter);
+        textLabel->setStyleSheet("color: #888; font-size: 13px;");
+        
+        layout->addWidget(iconLabel);
+        layout->addWidget(textLabel);
+        
+        updateStyle(false);
+    }
+    
+    void setBatchMode(bool batch) {
+        batchMode = batch;
+        if (batch) {
+            iconLabel->setText("📂");
+            textLabel->setText("Drop multiple files here or click to browse\nBatch conversion enabled");
+        } else {
+            iconLabel->setText("📁");
+            textLabel->setText("Drop file(s) here or click to browse\nSupports: .json (Cherax/YimMenu/Lexis) and .txt (Stand)");
+        }
+    }
+    
+signals:
+    void filesDropped(const QStringList& filePaths);
+    
+protected:
+    void dragEnterEvent(QDragEnterEvent* event) override {
+        if (event->mimeData()->hasUrls()) {
+            event->acceptProposedAction();updateStyle(true);
+        }
+    }
+    
+    void dragLeaveEvent(QDragLeaveEvent* event) override {
+        updateStyle(false);
+    }
+    
+    void dropEvent(QDropEvent* event) override {
+        const QMimeData* mimeData = event->mimeData();
+        if (mimeData->hasUrls()) {
+            QStringList filePaths;
+            QList<QUrl> urls = mimeData->urls();
+            for (const QUrl& url : urls) {
+                QString filePath = url.toLocalFile();
+                if (filePath.endsWith(".json", Qt::CaseInsensitive) || 
+                    filePath.endsWith(".txt", Qt::CaseInsensitive)) {
+                    filePaths.append(filePath);
+                }
+            }
+            if (!filePaths.isEmpty()) {
+                emit filesDropped(filePaths);
+            }
+        }
+        updateStyle(false);
+    }
+    
+    void mousePressEvent(QMouseEvent* event) override {
+        if (batchMode) {
+            QStringList filePaths = QFileDialog::getOpenFileNames(this, "Select Files", "", 
+                "Outfit Files (*.json *.txt);;JSON Files (*.json);;Text Files (*.txt)");
+            if (!filePaths.isEmpty()) {
+                emit filesDropped(filePaths);
+            }
+        } else {
+            QString filePath = QFileDialog::getOpenFileName(this, "Select File", "", 
+                "Outfit Files (*.json *.txt);;JSON Files (*.json);;Text Files (*.txt)");
+            if (!filePath.isEmpty()) {
+                emit filesDropped(QStringList() << filePath);
+            }
+        }
+    }
+    
+private:
+    void updateStyle(bool dragging) {
+        if (dragging) {
+            setStyleSheet("DropZone { background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #667eea, stop:1 #764ba2); border: 3px dashed #fff; border-radius: 16px; }");
+        } else {
+            setStyleSheet("DropZone { background: #2a2a2a; border: 2px dashed #555; border-radius: 16px; }");
+        }
+    }
+    
+    QLabel* iconLabel;
+    QLabel* textLabel;
+    bool batchMode;
+};
+
+// Library list row: the outfit name as usual, then its summary signature
+// dimmed on the right, painted from the item's data alone.
+class OutfitRowDelegate : public QStyledItemDelegate {
+public:
+    static constexpr int SignatureRole = Qt::UserRole + 1;
+    
+    using QStyledItemDelegate::QStyledItemDelegate;
+    
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override {
+        QStyledItemDelegate::paint(painter, option, index);
+        
+        QString signature = index.data(SignatureRole).toString();
+        if (signature.isEmpty()) return;
+        
+        QRect area = option.rect.adjusted(8, 0, -8, 0);
+        area.setLeft(area.left() + option.fontMetrics.horizontalAdvance(index.data(Qt::DisplayRole).toString()) + 24);
+        if (area.width() < 60) return;
+        
+        painter->save();
+        painter->setPen(QColor("#888"));
+        painter->drawText(area, Qt::AlignRight | Qt::AlignVCenter,
+                          option.fontMetrics.elidedText(signature, Qt::ElideRight, area.width()));
+        painter->restore();
+    }
+};
+
+// Outfit Editor Tab
+class OutfitEditorTab : public QWidget {
+    Q_OBJECT
+public:
+    explicit OutfitEditorTab(QWidget* parent = nullptr) : QWidget(parent) {
+        setupUI();
+        // The library is listed off the GUI thread once the tab is on screen.
+        QTimer::singleShot(0, this, &OutfitEditorTab::loadPlayerData);
+    }
+    
+    ~OutfitEditorTab() override {
+        flushPendingSave();
+        if (libraryIndex.isDirty() && indexReady) {
+            libraryIndex.save(OutfitIndex::cachePathFor(defaultLibraryPath()));
+        }
+    }
+    
+private slots:
+    void loadPlayerData() {
+#ifdef OUTFIT_SQL_LIBRARY
+        if (storeCheck->isChecked() && !libraryStore) openLibraryStore(false);
+        if (libraryStore) {
+            // Batch and watch outputs still land as files; take in the new ones.
+            libraryStore->importDirectory(defaultLibraryPath());
+            playerNameLabel->setText("Player: " + qgetenv("USERNAME"));
+            ++libraryScanGeneration;
+            onLibraryScanned(libraryStore->names());
+            return;
+        }
+#endif
+        
+        QString yimPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/OutfitConverter/YimMenu";
+        QDir dir(yimPath);
+        
+        if (!dir.exists()) {
+            playerNameLabel->setText("Player: Unknown");
+            return;
+        }
+        
+        playerNameLabel->setText("Player: " + qgetenv("USERNAME"));
+        
+        // Only the newest scan is applied when Refresh is clicked repeatedly.
+        int generation = ++libraryScanGeneration;
+        QPointer<OutfitEditorTab> self(this);
+        QThreadPool::globalInstance()->start([self, yimPath, generation]() {
+            QStringList names;
+            QDirIterator it(yimPath, QStringList() << "*.json", QDir::Files);
+            while (it.hasNext()) {
+                names.append(QFileInfo(it.next()).completeBaseName());
+            }
+            names.sort(Qt::CaseInsensitive);
+            
+            QMetaObject::invokeMethod(qApp, [self, names, generation]() {
+                if (self && generation == self->libraryScanGeneration) self->onLibraryScanned(names);
+            }, Qt::QueuedConnection);
+        });
+    }
+    
+    // Every outfit gets a row once per scan; searching only hides rows, so
+    // summaries are set here and when the index changes, not per keystroke.
+    void onLibraryScanned(const QStringList& names) {
+        StartupTrace::instance().mark(QString("library listed (%1 outfits)").arg(names.size()));
+        
+        outfitList->clear();
+        outfitList->addItems(names);
+        showSummaries();
+        applySearch();
+        if (!usingStore()) startIndexRefresh();
+    }
+    
+    void startIndexRefresh() {
+        if (indexRefreshRunning) {
+            indexRefreshPending = true;
+            return;
+        }
+        indexRefreshRunning = true;
+        
+        QString libraryPath = defaultLibraryPath();
+        QPointer<OutfitEditorTab> self(this);
+        QThreadPool::globalInstance()->start([self, libraryPath]() {
+            auto fresh = std::make_shared<OutfitIndex>();
+            QString cachePath = OutfitIndex::cachePathFor(libraryPath);
+            fresh->load(cachePath);
+            fresh->refreshFromDirectory(libraryPath);
+            if (fresh->isDirty()) fresh->save(cachePath);
+            
+            QMetaObject::invokeMethod(qApp, [self, fresh]() {
+                if (self) self->onIndexRefreshed(fresh);
+            }, Qt::QueuedConnection);
+        });
+    }
+    
+    void onIndexRefreshed(const std::shared_ptr<OutfitIndex>& fresh) {
+        libraryIndex = std::move(*fresh);
+        indexReady = true;
+        StartupTrace::instance().mark("library index ready");
+        indexRefreshRunning = false;
+        
+        if (indexRefreshPending) {
+            indexRefreshPending = false;
+            startIndexRefresh();
+        }
+        
+        showSummaries();
+        if (OutfitQuery::parse(searchEdit->text()).isStructured()) applySearch();
+    }
+    
+    void applySearch() {
+        OutfitQuery query = OutfitQuery::parse(searchEdit->text());
+        QSet<QString> matches;
+        
+        if (query.isStructured() && !indexReady && !usingStore()) {
+            statusLabel->setText("⏳ Indexing outfit library...");
+            statusLabel->setStyleSheet("color: #888; font-size: 12px;");
+        } else if (query.isStructured()) {
+            QElapsedTimer timer;
+            timer.start();
+#ifdef OUTFIT_SQL_LIBRARY
+            const QStringList names = libraryStore ? libraryStore->find(query) : libraryIndex.query(query);
+#else
+            const QStringList names = libraryIndex.query(query);
+#endif
+            matches = QSet<QString>(names.begin(), names.end());
+            statusLabel->setText(QString("🔍 %1 outfits matched in %2 ms").arg(names.size()).arg(timer.elapsed()));
+            statusLabel->setStyleSheet("color: #667eea; font-size: 12px;");
+        }
+        
+        if (!query.error.isEmpty()) {
+            statusLabel->setText("⚠ " + query.error);
+            statusLabel->setStyleSheet("color: #ff6b6b; font-size: 12px;");
+        }
+        
+        for (int i = 0; i < outfitList->count(); ++i) {
+            QListWidgetItem* item = outfitList->item(i);
+            bool match = !query.isStructured() || matches.contains(item->text());
+            if (!query.isStructured()) {
+                for (const QString& word : query.nameTerms) {
+                    if (!item->text().contains(word, Qt::CaseInsensitive)) {
+                        match = false;
+                        break;
+                    }
+                }
+            }
+            if (match == !item->isHidden()) continue;
+            // A hidden row must not stay in a bulk edit's selection.
+            if (!match) item->setSelected(false);
+            item->setHidden(!match);
+        }
+    }
+    
+    // Row signatures and hover tooltips come from the index, so skimming the
+    // library never opens an outfit file.
+    void showSummaries() {
+        if (!indexReady) return;
+        for (int i = 0; i < outfitList->count(); ++i) {
+            showSummary(outfitList->item(i));
+        }
+    }
+    
+    void showSummary(QListWidgetItem* item) {
+        const OutfitSummary* summary = libraryIndex.summary(item->text());
+        item->setData(OutfitRowDelegate::SignatureRole, summary ? summary->signature : QString());
+        item->setToolTip(summary ? summary->toolTip : QString());
+    }
+    
+    void updateIndexEntry(const QString& name) {
+        updateIndexEntry(name, outfitDataFromYim(currentOutfit));
+    }
+    
+    void updateIndexEntry(const QString& name, const OutfitData& outfit) {
+        if (!indexReady) return;
+        
+        // The store has no file to stamp the entry with; an unknown stamp makes
+        // the next scan of the files read the outfit again.
+        qint64 mtime = -1;
+        qint64 size = -1;
+        if (!usingStore()) {
+            QFileInfo info(defaultLibraryPath() + "/" + name + ".json");
+            mtime = info.lastModified().toMSecsSinceEpoch();
+            size = info.size();
+        }
+        libraryIndex.update(name, outfit, mtime, size);
+        for (QListWidgetItem* item : outfitList->findItems(name, Qt::MatchExactly)) showSummary(item);
+    }
+    
+    void onOutfitSelected(QListWidgetItem* item) {
+        if (!item) return;
+        
+        flushPendingSave();
+        currentOutfitName = item->text();
+        
+        QByteArray data;
+        if (!readLibraryOutfit(currentOutfitName, data)) {
+            QMessageBox::warning(this, "Error", "Failed to load outfit");
+            return;
+        }
+        
+        QJsonDocument doc = QJsonDocument::fromJson(data);
+        currentOutfit = doc.object();
+        markPersisted(data);
+        history.clear();
+        updateHistoryButtons();
+        
+        outfitNameEdit->setText(currentOutfitName);
+        loadOutfitToEditor();
+    }
+    
+    // Takes currentOutfit, stored as bytes, as the snapshot edits are
+    // compared against.
+    void markPersisted(const QByteArray& bytes) {
+        persistedOutfit = outfitDataFromYim(currentOutfit);
+        persistedHash = contentHash64(bytes);
+        dirtySlots = 0;
+    }
+    
+    void loadOutfitToEditor() {
+        QLayoutItem* item;
+        while ((item = componentsLayout->takeAt(0)) != nullptr) {
+            delete item->widget();
+            delete item;
+        }
+        componentSpinBoxes.clear();
+        textureSpinBoxes.clear();
+        componentLabels.clear();
+        propLabels.clear();
+        
+        OutfitData outfit = outfitDataFromYim(currentOutfit);
+        const ModelSlotLimits* limits = outfit.hasModel ? slotLimits.find(outfit.model) : nullptr;
+        
+        if (currentOutfit.contains("components")) {
+            QJsonObject comps = currentOutfit["components"].toObject();
+            
+            const QStringList& compNames = kComponentSlotNames;
+            
+            for (int i = 0; i < 12; ++i) {
+                QString key = QString::number(i);
+                QJsonObject comp = comps.value(key).toObject();
+                
+                QLabel* label = new QLabel(compNames[i] + ":", this);
+                label->setObjectName("fieldLabel");
+                
+                QSpinBox* drawableSpin = new QSpinBox(this);
+                QSpinBox* textureSpin = new QSpinBox(this);
+                setSlotRanges(drawableSpin, textureSpin, limits ? &limits->components[i] : nullptr,
+                              {comp.value("drawable_id").toInt(), comp.value("texture_id").toInt()});
+                
+                connect(drawableSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, [this, i]() { onSlotEdited(false, i); });
+                connect(textureSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, [this, i]() { onSlotEdited(false, i); });
+                
+                componentSpinBoxes[i] = drawableSpin;
+                textureSpinBoxes[i] = textureSpin;
+                componentLabels[i] = label;
+                
+                QHBoxLayout* rowLayout = new QHBoxLayout();
+                rowLayout->addWidget(label, 1);
+                rowLayout->addWidget(new QLabel("Drawable:", this));
+                rowLayout->addWidget(drawableSpin, 1);
+                rowLayout->addWidget(new QLabel("Texture:", this));
+                rowLayout->addWidget(textureSpin, 1);
+                
+                componentsLayout->addLayout(rowLayout);
+            }
+        }
+        
+        if (currentOutfit.contains("props")) {
+            QJsonObject props = currentOutfit["props"].toObject();
+            
+            const QStringList& propNames = kPropSlotNames;
+            
+            for (int i = 0; i < 9; ++i) {
+                QString key = QString::number(i);
+                QJsonObject prop = props.value(key).toObject();
+                
+                QLabel* label = new QLabel(propNames[i] + ":", this);
+                label->setObjectName("fieldLabel");
+                
+                QSpinBox* drawableSpin = new QSpinBox(this);
+                QSpinBox* textureSpin = new QSpinBox(this);
+                setSlotRanges(drawableSpin, textureSpin, limits ? &limits->props[i] : nullptr,
+                              {prop.value("drawable_id").toInt(), prop.value("texture_id").toInt()});
+                
+                connect(drawableSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, [this, i]() { onSlotEdited(true, i); });
+                connect(textureSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, [this, i]() { onSlotEdited(true, i); });
+                
+                propDrawableSpinBoxes[i] = drawableSpin;
+                propTextureSpinBoxes[i] = textureSpin;
+                propLabels[i] = label;
+                
+                QHBoxLayout* rowLayout = new QHBoxLayout();
+                rowLayout->addWidget(label, 1);
+                rowLayout->addWidget(new QLabel("Drawable:", this));
+                rowLayout->addWidget(drawableSpin, 1);
+                rowLayout->addWidget(new QLabel("Texture:", this));
+                rowLayout->addWidget(textureSpin, 1);
+                
+                propsLayout->addLayout(rowLayout);
+            }
+        }
+        updateSlotWarnings();
+    }
+    
+    // Ranges from the game's slot limits for the outfit's model (a blanket
+    // -1..500 for models without a table). A value already past the limit
+    // stays reachable so loading an outfit never changes it.
+    static void setSlotRanges(QSpinBox* drawableSpin, QSpinBox* textureSpin, const SlotLimit* limit, const OutfitSlot& value) {
+        int maxDrawable = limit ? qMax(limit->drawables - 1, value.drawable) : 500;
+        int maxTexture = limit ? qMax(limit->textures - 1, value.texture) : 500;
+        drawableSpin->setRange(qMin(-1, value.drawable), qMax(0, maxDrawable));
+        textureSpin->setRange(qMin(-1, value.texture), qMax(0, maxTexture));
+        drawableSpin->setValue(value.drawable);
+        textureSpin->setValue(value.texture);
+    }
+    
+    // Marks the slots that break the game's limits in red, with the reason
+    // as a tooltip.
+    void updateSlotWarnings() {
+        SlotIssues issues;
+        validateOutfit(outfitDataFromYim(currentOutfit), slotLimits, &issues);
+        
+        for (int isProp = 0; isProp < 2; ++isProp) {
+            const QMap<int, QLabel*>& labels = isProp ? propLabels : componentLabels;
+            for (auto it = labels.begin(); it != labels.end(); ++it) {
+                QString reason;
+                for (const SlotIssue& issue : issues) {
+                    if (issue.isProp == bool(isProp) && issue.slot == it.key()) reason = issue.describe();
+                }
+                it.value()->setStyleSheet(reason.isEmpty() ? QString() : "color: #ff6b6b;");
+                it.value()->setToolTip(reason);
+            }
+        }
+    }
+    
+    bool hasSlotValue(bool isProp, int slot) const {
+        return currentOutfit.value(isProp ? "props" : "components").toObject().contains(QString::number(slot));
+    }
+    
+    // An absent slot reads as 0/0, which is also what the editor shows for it.
+    OutfitSlot slotValue(bool isProp, int slot) const {
+        QJsonObject slotObject = currentOutfit.value(isProp ? "props" : "components").toObject()
+                                     .value(QString::number(slot)).toObject();
+        return {slotObject.value("drawable_id").toInt(), slotObject.value("texture_id").toInt()};
+    }
+    
+    void setSlotValue(bool isProp, int slot, const OutfitSlot& value) {
+        const char* group = isProp ? "props" : "components";
+        QString key = QString::number(slot);
+        QJsonObject slotObjects = currentOutfit.value(group).toObject();
+        QJsonObject slotObject = slotObjects.value(key).toObject();
+        slotObject["drawable_id"] = value.drawable;
+        slotObject["texture_id"] = value.texture;
+        slotObjects[key] = slotObject;
+        currentOutfit[group] = slotObjects;
+        
+        const OutfitSlot& stored = persistedOutfit.slot(isProp, slot);
+        markSlotDirty(isProp, slot, !persistedOutfit.hasSlot(isProp, slot) ||
+                                    stored.drawable != value.drawable || stored.texture != value.texture);
+    }
+    
+    void removeSlotValue(bool isProp, int slot) {
+        const char* group = isProp ? "props" : "components";
+        QJsonObject slotObjects = currentOutfit.value(group).toObject();
+        slotObjects.remove(QString::number(slot));
+        currentOutfit[group] = slotObjects;
+        markSlotDirty(isProp, slot, persistedOutfit.hasSlot(isProp, slot));
+    }
+    
+    // A slot set back to its stored state is clean again.
+    void markSlotDirty(bool isProp, int slot, bool changed) {
+        quint32 bit = 1u << (isProp ? kComponentSlotCount + slot : slot);
+        dirtySlots = changed ? dirtySlots | bit : dirtySlots & ~bit;
+    }
+    
+    void onSlotEdited(bool isProp, int slot) {
+        if (currentOutfit.isEmpty()) return;
+        
+        QSpinBox* drawableSpin = (isProp ? propDrawableSpinBoxes : componentSpinBoxes).value(slot);
+        QSpinBox* textureSpin = (isProp ? propTextureSpinBoxes : textureSpinBoxes).value(slot);
+        
+        SlotEdit edit;
+        edit.isProp = isProp;
+        edit.slot = qint8(slot);
+        edit.wasPresent = hasSlotValue(isProp, slot);
+        edit.before = slotValue(isProp, slot);
+        edit.after = {drawableSpin->value(), textureSpin->value()};
+        setSlotValue(isProp, slot, edit.after);
+        history.record(edit);
+        updateSlotWarnings();
+        scheduleSave();
+    }
+    
+    // Puts a slot back to value, or removes it when it was not present,
+    // without recording a new step.
+    void restoreSlot(bool isProp, int slot, const OutfitSlot& value, bool present = true) {
+        if (present) setSlotValue(isProp, slot, value);
+        else removeSlotValue(isProp, slot);
+        
+        QSpinBox* drawableSpin = (isProp ? propDrawableSpinBoxes : componentSpinBoxes).value(slot);
+        QSpinBox* textureSpin = (isProp ? propTextureSpinBoxes : textureSpinBoxes).value(slot);
+        if (drawableSpin && textureSpin) {
+            QSignalBlocker drawableBlocker(drawableSpin);
+            QSignalBlocker textureBlocker(textureSpin);
+            drawableSpin->setValue(value.drawable);
+            textureSpin->setValue(value.texture);
+        }
+        updateSlotWarnings();
+        scheduleSave();
+    }
+    
+    void undoEdit() {
+        if (currentOutfit.isEmpty() || !history.canUndo()) return;
+        SlotEdit edit = history.undo();
+        restoreSlot(edit.isProp, edit.slot, edit.before, edit.wasPresent);
+    }
+    
+    void redoEdit() {
+        if (currentOutfit.isEmpty() || !history.canRedo()) return;
+        SlotEdit edit = history.redo();
+        restoreSlot(edit.isProp, edit.slot, edit.after);
+    }
+    
+    // Edits and undo/redo steps land in memory right away; the file is
+    // written once the editor has been idle for a moment.
+    void scheduleSave() {
+        savePending = true;
+        saveTimer->start();
+        updateHistoryButtons();
+    }
+    
+    void flushPendingSave() {
+        if (!savePending) return;
+        savePending = false;
+        saveTimer->stop();
+        saveCurrentOutfit();
+    }
+    
+    void updateHistoryButtons() {
+        undoBtn->setEnabled(history.canUndo());
+        redoBtn->setEnabled(history.canRedo());
+    }
+    
+    // Skips the write when every slot matches what was last stored, or when
+    // the serialized outfit is byte for byte what is already on disk.
+    void saveCurrentOutfit() {
+        if (dirtySlots == 0) return;
+        
+        QByteArray data = QJsonDocument(currentOutfit).toJson(QJsonDocument::Indented);
+        if (contentHash64(data) == persistedHash) {
+            markPersisted(data);
+            return;
+        }
+        if (!writeLibraryOutfit(currentOutfitName, data)) {
+            return;
+        }
+        markPersisted(data);
+        updateIndexEntry(currentOutfitName);
+        
+        statusLabel->setText("✓ Auto-saved at " + QTime::currentTime().toString("hh:mm:ss"));
+        statusLabel->setStyleSheet("color: #4CAF50; font-size: 12px;");
+    }
+    
+    void renameOutfit() {
+        if (currentOutfitName.isEmpty()) {
+            QMessageBox::warning(this, "Warning", "No outfit selected");
+            return;
+        }
+        
+        QString newName = outfitNameEdit->text().trimmed();
+        if (newName.isEmpty() || newName == currentOutfitName) {
+            return;
+        }
+        flushPendingSave();
+        
+        QString error;
+        if (!renameLibraryOutfit(currentOutfitName, newName, error)) {
+            QMessageBox::warning(this, "Warning", error);
+            return;
+        }
+        
+        libraryIndex.rename(currentOutfitName, newName);
+        currentOutfitName = newName;
+        updateIndexEntry(newName);
+        loadPlayerData();
+        statusLabel->setText("✓ Outfit renamed successfully");
+        statusLabel->setStyleSheet("color: #4CAF50; font-size: 12px;");
+    }
+    
+    // Library access, from the SQLite store while it is enabled and from
+    // the outfit files otherwise.
+    bool usingStore() const {
+#ifdef OUTFIT_SQL_LIBRARY
+        return libraryStore != nullptr;
+#else
+        return false;
+#endif
+    }
+    
+    bool readLibraryOutfit(const QString& name, QByteArray& data) {
+#ifdef OUTFIT_SQL_LIBRARY
+        if (libraryStore) return libraryStore->load(name, data);
+#endif
+        QFile file(defaultLibraryPath() + "/" + name + ".json");
+        if (!file.open(QIODevice::ReadOnly)) return false;
+        data = file.readAll();
+        return true;
+    }
+    
+    bool writeLibraryOutfit(const QString& name, const QByteArray& data) {
+#ifdef OUTFIT_SQL_LIBRARY
+        if (libraryStore) return libraryStore->save(name, data);
+#endif
+        return OutputWriter::instance().write(defaultLibraryPath() + "/" + name + ".json", data);
+    }
+    
+    bool renameLibraryOutfit(const QString& from, const QString& to, QString& error) {
+#ifdef OUTFIT_SQL_LIBRARY
+        if (libraryStore) return libraryStore->rename(from, to, &error);
+#endif
+        QString newPath = defaultLibraryPath() + "/" + to + ".json";
+        if (QFile::exists(newPath)) {
+            error = "An outfit with this name already exists";
+            return false;
+        }
+        if (!QFile::rename(defaultLibraryPath() + "/" + from + ".json", newPath)) {
+            error = "Failed to rename outfit";
+            return false;
+        }
+        return true;
+    }
+    
+#ifdef OUTFIT_SQL_LIBRARY
+    // Opens the library database; importFiles first copies the outfit files
+    // into it, since they may have changed while the store was off.
+    bool openLibraryStore(bool importFiles) {
+        auto store = std::make_unique<LibraryStore>();
+        QString error;
+        bool ok = store->open(LibraryStore::defaultPath(), &error);
+        if (ok && importFiles) {
+            QApplication::setOverrideCursor(Qt::WaitCursor);
+            ok = store->importDirectory(defaultLibraryPath(), &error, true) >= 0;
+            QApplication::restoreOverrideCursor();
+        }
+        
+        if (!ok) {
+            QSignalBlocker blocker(storeCheck);
+            storeCheck->setChecked(false);
+            statusLabel->setText("⚠ Cannot use the library database: " + error);
+            statusLabel->setStyleSheet("color: #ff6b6b; font-size: 12px;");
+            return false;
+        }
+        libraryStore = std::move(store);
+        return true;
+    }
+    
+    void setLibraryStoreEnabled(bool enabled) {
+        flushPendingSave();
+        if (enabled == usingStore()) return;
+        
+        if (enabled) {
+            if (!openLibraryStore(true)) return;
+        } else {
+            // The files become the library again, so they get the store's edits.
+            QApplication::setOverrideCursor(Qt::WaitCursor);
+            int exported = libraryStore->exportDirectory(defaultLibraryPath());
+            QApplication::restoreOverrideCursor();
+            if (exported < 0) {
+                QSignalBlocker blocker(storeCheck);
+                storeCheck->setChecked(true);
+                QMessageBox::critical(this, "Error", "Failed to write the library back to files; the database stays in use");
+                return;
+            }
+            libraryStore.reset();
+        }
+        
+        QSettings().setValue("library/useStore", enabled);
+        loadPlayerData();
+        updateBulkEditControls();
+        statusLabel->setText(enabled ? "✓ Library moved into " + LibraryStore::defaultPath()
+                                     : "✓ Library written back to " + defaultLibraryPath());
+        statusLabel->setStyleSheet("color: #4CAF50; font-size: 12px;");
+    }
+#endif
+    
+    void exportOutfit() {
+        if (currentOutfit.isEmpty()) {
+            QMessageBox::warning(this, "Warning", "No outfit selected");
+            return;
+        }
+        
         QString format = exportFormatCombo->currentText();
-        QString yimPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/OutfitConverter";
-        QString outputPath;
         QString content;
         
-        if (format == "Cherax") {
-            QJsonObject cherax = yimToCherax(currentOutfit);
-            QJsonDocument doc(cherax);
-            content = doc.toJson(QJsonDocument::Indented);
-            outputPath = yimPath + "/Cherax/" + currentOutfitName + "_exported.json";
-        } else if (format == "Lexis") {
-            QJsonObject lexis = yimToLexis(currentOutfit);
-            QJsonDocument doc(lexis);
-            content = doc.toJson(QJsonDocument::Indented);
-            outputPath = yimPath + "/Lexis/" + currentOutfitName + "_exported.json";
-        } else if (format == "Stand") {
-            content = yimToStand(currentOutfit);
-            outputPath = yimPath + "/Stand/" + currentOutfitName + "_exported.txt";
+        if (format == "Cherax") {
+            QJsonObject cherax = yimToCherax(currentOutfit);
+            QJsonDocument doc(cherax);
+            content = doc.toJson(QJsonDocument::Indented);
+        } else if (format == "Lexis") {
+            QJsonObject lexis = yimToLexis(currentOutfit);
+            QJsonDocument doc(lexis);
+            content = doc.toJson(QJsonDocument::Indented);
+        } else if (format == "Stand") {
+            content = yimToStand(currentOutfit);
+        } else {
+            QJsonDocument doc(currentOutfit);
+            content = doc.toJson(QJsonDocument::Indented);
+        }
+        QByteArray data = content.toUtf8();
+        
+        // Exports follow the same output layout as the converter tab.
+        PathTemplate layout = PathTemplate::compile(
+            QSettings().value("output/pathTemplate", kDefaultPathTemplate).toString());
+        if (!layout.isValid()) layout = PathTemplate::compile(kDefaultPathTemplate);
+        
+        PathContext context;
+        context.name = currentOutfitName;
+        context.format = OutfitFormat::YimMenu;
+        context.target = formatFromName(format);
+        context.hash = contentHash64(data);
+        context.hasModel = currentOutfit.contains("model");
+        context.model = currentOutfit["model"].toInteger();
+        QString relativePath;
+        layout.resolve(context, relativePath);
+        // A layout with a fixed .json suffix would otherwise label Stand's
+        // text output as JSON.
+        if (context.target == OutfitFormat::Stand && relativePath.endsWith(".json", Qt::CaseInsensitive)) {
+            relativePath.chop(5);
+            relativePath.append(".txt");
+        }
+        QString outputPath = outputRootPath() + "/" + format + "/" + relativePath;
+        QDir().mkpath(QFileInfo(outputPath).absolutePath());
+        
+        if (OutputWriter::instance().write(outputPath, data)) {
+            QMessageBox::information(this, "Success", "Outfit exported to:\n" + outputPath);
+        } else {
+            QMessageBox::critical(this, "Error", "Failed to export outfit");
+        }
+    }
+    
+    void validateLibraryOutfits() {
+        flushPendingSave();
+        
+        QApplication::setOverrideCursor(Qt::WaitCursor);
+        QVector<LibraryValidation> invalid;
+#ifdef OUTFIT_SQL_LIBRARY
+        if (libraryStore) invalid = validateLibraryStore(*libraryStore, slotLimits);
+#endif
+        if (!usingStore()) invalid = validateLibrary(defaultLibraryPath(), slotLimits);
+        QApplication::restoreOverrideCursor();
+        
+        if (invalid.isEmpty()) {
+            statusLabel->setText("✓ Every outfit is within the game's limits");
+            statusLabel->setStyleSheet("color: #4CAF50; font-size: 12px;");
+            return;
+        }
+        
+        // Select them so a bulk edit can fix them in one go.
+        QSet<QString> names;
+        QStringList lines;
+        for (const LibraryValidation& result : invalid) {
+            names.insert(result.name);
+            lines.append(result.name + ": " + (result.unreadable ? QString("could not be read") : describeIssues(result.issues)));
+        }
+        outfitList->clearSelection();
+        for (int i = 0; i < outfitList->count(); ++i) {
+            QListWidgetItem* item = outfitList->item(i);
+            if (!item->isHidden() && names.contains(item->text())) item->setSelected(true);
+        }
+        
+        QMessageBox report(QMessageBox::Warning, "Game Limits",
+                           QString("%1 outfits break the game's slot limits and may fail in a session.").arg(invalid.size()),
+                           QMessageBox::Ok, this);
+        report.setInformativeText("They are selected in the outfit list. Limits can be adjusted in " + SlotLimits::overridePath());
+        report.setDetailedText(lines.join("\n"));
+        report.exec();
+    }
+    
+    void updateBulkEditControls() {
+        bool replace = bulkOperationCombo->currentIndex() == int(BulkEdit::Operation::Replace);
+        bool offset = bulkOperationCombo->currentIndex() == int(BulkEdit::Operation::Offset);
+        bulkMatchDrawable->setEnabled(replace);
+        bulkMatchTexture->setEnabled(replace);
+        bulkDrawable->setRange(offset ? -500 : -1, 500);
+        bulkTexture->setRange(offset ? -500 : -1, 500);
+        
+        int selected = 0;
+        const QList<QListWidgetItem*> selectedItems = outfitList->selectedItems();
+        for (QListWidgetItem* item : selectedItems) {
+            if (!item->isHidden()) selected++;
+        }
+        bulkApplyBtn->setText(QString("Apply to %1 selected").arg(selected));
+        bulkApplyBtn->setEnabled(selected > 0);
+        bulkUndoBtn->setEnabled(!usingStore() && !BulkEditJournal::latest().isEmpty());
+    }
+    
+    void applyBulkEdit() {
+        QStringList names;
+        // Select All also takes rows the search has hidden; leave those out.
+        const QList<QListWidgetItem*> items = outfitList->selectedItems();
+        for (QListWidgetItem* item : items) {
+            if (!item->isHidden()) names.append(item->text());
+        }
+        if (names.isEmpty()) {
+            QMessageBox::warning(this, "Warning", "No outfits selected");
+            return;
+        }
+        flushPendingSave();
+        
+        QString slotKey = bulkSlotCombo->currentData().toString();
+        BulkEdit edit;
+        edit.operation = BulkEdit::Operation(bulkOperationCombo->currentIndex());
+        edit.isProp = slotKey.startsWith('p');
+        edit.slot = slotKey.mid(1).toInt();
+        edit.match = {bulkMatchDrawable->value(), bulkMatchTexture->value()};
+        edit.value = {bulkDrawable->value(), bulkTexture->value()};
+        
+        QApplication::setOverrideCursor(Qt::WaitCursor);
+        QVector<BulkEditChange> changes;
+#ifdef OUTFIT_SQL_LIBRARY
+        if (libraryStore) {
+            changes = libraryStore->loadForEdit(names);
+            editBulkChanges(changes, edit);
+        }
+#endif
+        if (!usingStore()) changes = prepareBulkEdit(defaultLibraryPath(), names, edit);
+        QApplication::restoreOverrideCursor();
+        
+        QStringList diff;
+        QStringList unreadable;
+        int outsideLimits = 0;
+        SlotIssues issues;
+        for (const BulkEditChange& change : changes) {
+            if (change.failed) unreadable.append(change.name);
+            if (!change.changed) continue;
+            QString line = QString("%1: %2/%3 -> %4/%5").arg(change.name)
+                               .arg(change.before.drawable).arg(change.before.texture)
+                               .arg(change.after.drawable).arg(change.after.texture);
+            
+            // Only what the edit itself breaks; other slots are not its doing.
+            issues.clear();
+            validateOutfit(change.outfit, slotLimits, &issues);
+            for (const SlotIssue& issue : issues) {
+                if (issue.isProp != edit.isProp || issue.slot != edit.slot) continue;
+                line += "  ⚠ " + issue.describe();
+                outsideLimits++;
+                break;
+            }
+            diff.append(line);
+        }
+        
+        if (diff.isEmpty()) {
+            statusLabel->setText("No selected outfit matched the bulk edit");
+            statusLabel->setStyleSheet("color: #888; font-size: 12px;");
+            return;
+        }
+        
+        QString description = QString("%1 %2 on %3 outfits").arg(bulkOperationCombo->currentText(), edit.slotName()).arg(diff.size());
+        QMessageBox preview(QMessageBox::Question, "Bulk Edit",
+                            QString("%1 of %2 selected outfits will change %3.").arg(diff.size()).arg(names.size()).arg(edit.slotName()),
+                            QMessageBox::Apply | QMessageBox::Cancel, this);
+        QStringList notes;
+        if (outsideLimits > 0) {
+            notes.append(QString("%1 outfits would end up outside the game's limits (marked ⚠ in the details).").arg(outsideLimits));
+        }
+        if (!unreadable.isEmpty()) {
+            notes.append(QString("%1 outfits could not be read and will be skipped.").arg(unreadable.size()));
+        }
+        preview.setInformativeText(notes.join("\n"));
+        preview.setDetailedText(diff.join("\n"));
+        if (preview.exec() != QMessageBox::Apply) return;
+        
+        QStringList failures;
+#ifdef OUTFIT_SQL_LIBRARY
+        // The store commits the whole edit in one transaction; there is no
+        // file journal to undo it from.
+        if (libraryStore && !libraryStore->commit(changes)) {
+            QMessageBox::critical(this, "Error", "Failed to write the bulk edit; nothing was changed");
+            return;
+        }
+#endif
+        if (!usingStore()) {
+            QString journalPath;
+            failures = BulkEditJournal::commit(description, changes, journalPath);
+            if (journalPath.isEmpty()) {
+                QMessageBox::critical(this, "Error", "Failed to write the undo journal; nothing was changed");
+                return;
+            }
+        }
+        
+        for (const BulkEditChange& change : changes) {
+            if (!change.changed || failures.contains(change.path)) continue;
+            updateIndexEntry(change.name, change.outfit);
+            if (change.name == currentOutfitName) {
+                currentOutfit = QJsonDocument::fromJson(change.newData).object();
+                markPersisted(change.newData);
+                history.clear();
+                loadOutfitToEditor();
+                updateHistoryButtons();
+            }
+        }
+        
+        if (!failures.isEmpty()) {
+            QMessageBox::warning(this, "Warning", QString("%1 outfits could not be written").arg(failures.size()));
+        }
+        statusLabel->setText(QString("✓ Bulk edit changed %1 outfits").arg(diff.size() - failures.size()));
+        statusLabel->setStyleSheet("color: #4CAF50; font-size: 12px;");
+        updateBulkEditControls();
+    }
+    
+    void undoBulkEdit() {
+        QString journalPath = BulkEditJournal::latest();
+        if (journalPath.isEmpty()) return;
+        
+        if (QMessageBox::question(this, "Undo Bulk Edit",
+                "Undo \"" + BulkEditJournal::description(journalPath) + "\"?") != QMessageBox::Yes) {
+            return;
+        }
+        
+        flushPendingSave();
+        QStringList restored;
+        QStringList skipped;
+        bool ok = BulkEditJournal::undo(journalPath, restored, skipped);
+        
+        for (const QString& path : restored) {
+            QString name = QFileInfo(path).completeBaseName();
+            QFile file(path);
+            if (!file.open(QIODevice::ReadOnly)) continue;
+            QByteArray bytes = file.readAll();
+            QJsonObject yim = QJsonDocument::fromJson(bytes).object();
+            updateIndexEntry(name, outfitDataFromYim(yim));
+            if (name == currentOutfitName) {
+                currentOutfit = yim;
+                markPersisted(bytes);
+                history.clear();
+                loadOutfitToEditor();
+                updateHistoryButtons();
+            }
+        }
+        
+        if (!ok) {
+            QMessageBox::warning(this, "Warning", "Some outfits could not be restored; the undo journal was kept");
+        } else if (!skipped.isEmpty()) {
+            QMessageBox::information(this, "Undo Bulk Edit",
+                QString("%1 outfits were changed after the bulk edit and were left as they are.").arg(skipped.size()));
+        }
+        statusLabel->setText(QString("↶ Restored %1 outfits").arg(restored.size()));
+        statusLabel->setStyleSheet("color: #4CAF50; font-size: 12px;");
+        updateBulkEditControls();
+    }
+    
+    void setupUI() {
+        QHBoxLayout* mainLayout = new QHBoxLayout(this);
+        
+        QWidget* leftPanel = new QWidget(this);
+        leftPanel->setMaximumWidth(300);
+        QVBoxLayout* leftLayout = new QVBoxLayout(leftPanel);
+        
+        playerNameLabel = new QLabel("Player: Loading...", this);
+        playerNameLabel->setStyleSheet("color: #667eea; font-size: 16px; font-weight: bold; padding: 10px;");
+        leftLayout->addWidget(playerNameLabel);
+        
+        QLabel* outfitsLabel = new QLabel("Saved Outfits:", this);
+        outfitsLabel->setStyleSheet("color: #fff; font-size: 14px; font-weight: bold; padding: 5px;");
+        leftLayout->addWidget(outfitsLabel);
+        
+        searchEdit = new QLineEdit(this);
+        searchEdit->setPlaceholderText("Search: name or top=178/3 hat=* model=female");
+        searchEdit->setClearButtonEnabled(true);
+        connect(searchEdit, &QLineEdit::textChanged, this, &OutfitEditorTab::applySearch);
+        leftLayout->addWidget(searchEdit);
+        
+        outfitList = new QListWidget(this);
+        outfitList->setUniformItemSizes(true);
+        outfitList->setSelectionMode(QAbstractItemView::ExtendedSelection);
+        outfitList->setItemDelegate(new OutfitRowDelegate(outfitList));
+        outfitList->setStyleSheet(
+            "QListWidget { background: #2a2a2a; color: #fff; border: 2px solid #444; border-radius: 8px; padding: 5px; }"
+            "QListWidget::item { padding: 8px; border-radius: 4px; }"
+            "QListWidget::item:selected { background: #667eea; }"
+            "QListWidget::item:hover { background: #3a3a3a; }"
+        );
+        connect(outfitList, &QListWidget::itemClicked, this, &OutfitEditorTab::onOutfitSelected);
+        leftLayout->addWidget(outfitList);
+        
+        QPushButton* refreshBtn = new QPushButton("🔄 Refresh List", this);
+        refreshBtn->setStyleSheet(
+            "QPushButton { background: #667eea; color: white; border: none; border-radius: 8px; padding: 10px; font-weight: bold; }"
+            "QPushButton:hover { background: #7e8ef5; }"
+        );
+        connect(refreshBtn, &QPushButton::clicked, this, &OutfitEditorTab::loadPlayerData);
+        leftLayout->addWidget(refreshBtn);
+        
+        QPushButton* validateBtn = new QPushButton("✔ Check Game Limits", this);
+        validateBtn->setToolTip("Find outfits with drawables or textures past the game's counts, or props on slots the model has none for");
+        validateBtn->setStyleSheet(
+            "QPushButton { background: #3a3a3a; color: white; border: none; border-radius: 8px; padding: 8px; font-weight: bold; }"
+            "QPushButton:hover { background: #4a4a4a; }"
+        );
+        connect(validateBtn, &QPushButton::clicked, this, &OutfitEditorTab::validateLibraryOutfits);
+        leftLayout->addWidget(validateBtn);
+        
+#ifdef OUTFIT_SQL_LIBRARY
+        storeCheck = new QCheckBox("Keep library in a database", this);
+        storeCheck->setToolTip("Store outfits in " + LibraryStore::defaultPath() + " for fast search, renames and bulk edits.\n"
+                               "Turning this off writes every outfit back to the library folder.");
+        storeCheck->setStyleSheet("QCheckBox { color: #aaa; font-size: 12px; spacing: 8px; }");
+        storeCheck->setChecked(QSettings().value("library/useStore", false).toBool());
+        connect(storeCheck, &QCheckBox::toggled, this, &OutfitEditorTab::setLibraryStoreEnabled);
+        leftLayout->addWidget(storeCheck);
+#endif
+        
+        mainLayout->addWidget(leftPanel);
+        
+        QWidget* rightPanel = new QWidget(this);
+        QVBoxLayout* rightLayout = new QVBoxLayout(rightPanel);
+        
+        QLabel* editorTitle = new QLabel("Outfit Editor", this);
+        editorTitle->setStyleSheet("color: #fff; font-size: 18px; font-weight: bold; padding: 10px;");
+        rightLayout->addWidget(editorTitle);
+        
+        QHBoxLayout* nameLayout = new QHBoxLayout();
+        QLabel* nameLabel = new QLabel("Outfit Name:", this);
+        nameLabel->setObjectName("fieldLabel");
+        outfitNameEdit = new QLineEdit(this);
+        QPushButton* renameBtn = new QPushButton("✏️ Rename", this);
+        renameBtn->setStyleSheet(
+            "QPushButton { background: #764ba2; color: white; border: none; border-radius: 6px; padding: 8px 15px; font-weight: bold; }"
+            "QPushButton:hover { background: #8e5bb8; }"
+        );
+        connect(renameBtn, &QPushButton::clicked, this, &OutfitEditorTab::renameOutfit);
+        
+        QString historyButtonStyle =
+            "QPushButton { background: #2a2a2a; color: white; border: 2px solid #444; border-radius: 6px; padding: 6px 12px; font-weight: bold; }"
+            "QPushButton:hover { background: #3a3a3a; }"
+            "QPushButton:disabled { color: #555; }";
+        undoBtn = new QPushButton("↶ Undo", this);
+        undoBtn->setToolTip("Undo the last slot change (Ctrl+Z)");
+        undoBtn->setStyleSheet(historyButtonStyle);
+        redoBtn = new QPushButton("↷ Redo", this);
+        redoBtn->setToolTip("Redo (Ctrl+Y)");
+        redoBtn->setStyleSheet(historyButtonStyle);
+        connect(undoBtn, &QPushButton::clicked, this, &OutfitEditorTab::undoEdit);
+        connect(redoBtn, &QPushButton::clicked, this, &OutfitEditorTab::redoEdit);
+        
+        QShortcut* undoShortcut = new QShortcut(QKeySequence::Undo, this);
+        undoShortcut->setContext(Qt::WidgetWithChildrenShortcut);
+        connect(undoShortcut, &QShortcut::activated, this, &OutfitEditorTab::undoEdit);
+        QShortcut* redoShortcut = new QShortcut(QKeySequence::Redo, this);
+        redoShortcut->setContext(Qt::WidgetWithChildrenShortcut);
+        connect(redoShortcut, &QShortcut::activated, this, &OutfitEditorTab::redoEdit);
+        
+        saveTimer = new QTimer(this);
+        saveTimer->setSingleShot(true);
+        saveTimer->setInterval(400);
+        connect(saveTimer, &QTimer::timeout, this, &OutfitEditorTab::flushPendingSave);
+        
+        nameLayout->addWidget(nameLabel);
+        nameLayout->addWidget(outfitNameEdit, 1);
+        nameLayout->addWidget(renameBtn);
+        nameLayout->addWidget(undoBtn);
+        nameLayout->addWidget(redoBtn);
+        rightLayout->addLayout(nameLayout);
+        updateHistoryButtons();
+        
+        QScrollArea* scrollArea = new QScrollArea(this);
+        scrollArea->setWidgetResizable(true);
+        
+        QWidget* scrollWidget = new QWidget();
+        QVBoxLayout* scrollLayout = new QVBoxLayout(scrollWidget);
+        
+        QLabel* compLabel = new QLabel("Components:", this);
+        compLabel->setStyleSheet("color: #667eea; font-size: 16px; font-weight: bold; margin-top: 10px;");
+        scrollLayout->addWidget(compLabel);
+        
+        componentsLayout = new QVBoxLayout();
+        scrollLayout->addLayout(componentsLayout);
+        
+        QLabel* propsLabel = new QLabel("Props:", this);
+        propsLabel->setStyleSheet("color: #764ba2; font-size: 16px; font-weight: bold; margin-top: 20px;");
+        scrollLayout->addWidget(propsLabel);
+        
+        propsLayout = new QVBoxLayout();
+        scrollLayout->addLayout(propsLayout);
+        
+        scrollLayout->addStretch();
+        scrollArea->setWidget(scrollWidget);
+        rightLayout->addWidget(scrollArea);
+        
+        QGroupBox* bulkGroup = new QGroupBox("Bulk Edit (Ctrl/Shift-click outfits to select)", this);
+        bulkGroup->setStyleSheet(
+            "QGroupBox { color: #fff; font-weight: bold; border: 2px solid #444; border-radius: 8px; margin-top: 10px; padding-top: 10px; }"
+            "QGroupBox::title { subcontrol-origin: margin; left: 10px; }"
+            "QLabel { color: #fff; font-weight: normal; }"
+        );
+        QGridLayout* bulkLayout = new QGridLayout(bulkGroup);
+        
+        bulkSlotCombo = new QComboBox(this);
+        for (int i = 0; i < kComponentSlotCount; ++i) {
+            bulkSlotCombo->addItem(kComponentSlotNames[i], QString("c%1").arg(i));
+        }
+        for (int i = 0; i < kPropSlotCount; ++i) {
+            bulkSlotCombo->addItem(kPropSlotNames[i] + " (prop)", QString("p%1").arg(i));
+        }
+        bulkOperationCombo = new QComboBox(this);
+        bulkOperationCombo->addItems({"Set", "Replace", "Offset"});
+        
+        auto bulkSpin = [this]() {
+            QSpinBox* spin = new QSpinBox(this);
+            spin->setRange(-1, 500);
+            return spin;
+        };
+        bulkMatchDrawable = bulkSpin();
+        bulkMatchTexture = bulkSpin();
+        bulkDrawable = bulkSpin();
+        bulkTexture = bulkSpin();
+        
+        bulkApplyBtn = new QPushButton("Apply to 0 selected", this);
+        bulkApplyBtn->setStyleSheet(
+            "QPushButton { background: #667eea; color: white; border: none; border-radius: 6px; padding: 8px 15px; font-weight: bold; }"
+            "QPushButton:hover { background: #7e8ef5; }"
+            "QPushButton:disabled { background: #444; color: #888; }"
+        );
+        bulkUndoBtn = new QPushButton("↶ Undo Last Bulk Edit", this);
+        bulkUndoBtn->setStyleSheet(
+            "QPushButton { background: #764ba2; color: white; border: none; border-radius: 6px; padding: 8px 15px; font-weight: bold; }"
+            "QPushButton:hover { background: #8e5bb8; }"
+            "QPushButton:disabled { background: #444; color: #888; }"
+        );
+        
+        bulkLayout->addWidget(new QLabel("Slot:", this), 0, 0);
+        bulkLayout->addWidget(bulkSlotCombo, 0, 1, 1, 2);
+        bulkLayout->addWidget(bulkOperationCombo, 0, 3, 1, 2);
+        bulkLayout->addWidget(new QLabel("Match:", this), 1, 0);
+        bulkLayout->addWidget(bulkMatchDrawable, 1, 1);
+        bulkLayout->addWidget(bulkMatchTexture, 1, 2);
+        bulkLayout->addWidget(new QLabel("Value:", this), 1, 3);
+        bulkLayout->addWidget(bulkDrawable, 1, 4);
+        bulkLayout->addWidget(bulkTexture, 1, 5);
+        bulkLayout->addWidget(bulkApplyBtn, 2, 0, 1, 3);
+        bulkLayout->addWidget(bulkUndoBtn, 2, 3, 1, 3);
+        rightLayout->addWidget(bulkGroup);
+        
+        connect(bulkOperationCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &OutfitEditorTab::updateBulkEditControls);
+        connect(outfitList, &QListWidget::itemSelectionChanged, this, &OutfitEditorTab::updateBulkEditControls);
+        connect(bulkApplyBtn, &QPushButton::clicked, this, &OutfitEditorTab::applyBulkEdit);
+        connect(bulkUndoBtn, &QPushButton::clicked, this, &OutfitEditorTab::undoBulkEdit);
+        updateBulkEditControls();
+        
+        QHBoxLayout* exportLayout = new QHBoxLayout();
+        QLabel* exportLabel = new QLabel("Export to:", this);
+        exportLabel->setObjectName("fieldLabel");
+        exportFormatCombo = new QComboBox(this);
+        exportFormatCombo->addItems({"YimMenu", "Cherax", "Lexis", "Stand"});
+        QPushButton* exportBtn = new QPushButton("📤 Export Outfit", this);
+        exportBtn->setStyleSheet(
+            "QPushButton { background: #4CAF50; color: white; border: none; border-radius: 6px; padding: 10px 20px; font-weight: bold; }"
+            "QPushButton:hover { background: #5dbf60; }"
+        );
+        connect(exportBtn, &QPushButton::clicked, this, &OutfitEditorTab::exportOutfit);
+        exportLayout->addWidget(exportLabel);
+        exportLayout->addWidget(exportFormatCombo, 1);
+        exportLayout->addWidget(exportBtn);
+        rightLayout->addLayout(exportLayout);
+        
+        statusLabel = new QLabel("Select an outfit to begin editing", this);
+        statusLabel->setStyleSheet("color: #888; font-size: 12px; padding: 5px;");
+        statusLabel->setAlignment(Qt::AlignCenter);
+        rightLayout->addWidget(statusLabel);
+        
+        mainLayout->addWidget(rightPanel, 1);
+    }
+    
+private:
+    QLabel* playerNameLabel;
+    QLineEdit* searchEdit;
+    QListWidget* outfitList;
+    QLineEdit* outfitNameEdit;
+    QComboBox* exportFormatCombo;
+    QVBoxLayout* componentsLayout;
+    QVBoxLayout* propsLayout;
+    QLabel* statusLabel;
+    
+    QComboBox* bulkSlotCombo;
+    QComboBox* bulkOperationCombo;
+    QSpinBox* bulkMatchDrawable;
+    QSpinBox* bulkMatchTexture;
+    QSpinBox* bulkDrawable;
+    QSpinBox* bulkTexture;
+    QPushButton* bulkApplyBtn;
+    QPushButton* bulkUndoBtn;
+    QPushButton* undoBtn;
+    QPushButton* redoBtn;
+    QTimer* saveTimer;
+    
+    QMap<int, QSpinBox*> componentSpinBoxes;
+    QMap<int, QSpinBox*> textureSpinBoxes;
+    QMap<int, QSpinBox*> propDrawableSpinBoxes;
+    QMap<int, QSpinBox*> propTextureSpinBoxes;
+    QMap<int, QLabel*> componentLabels;
+    QMap<int, QLabel*> propLabels;
+    SlotLimits slotLimits = SlotLimits::load(SlotLimits::overridePath());
+    
+    QString currentOutfitName;
+    QJsonObject currentOutfit;
+    EditHistory history;
+    bool savePending = false;
+    
+    // Last stored state of currentOutfit: its slots and its file's hash.
+    OutfitData persistedOutfit;
+    quint64 persistedHash = 0;
+    quint32 dirtySlots = 0;  // bit per slot, components then props, that differs from persistedOutfit
+    
+    int libraryScanGeneration = 0;
+    OutfitIndex libraryIndex;
+    bool indexReady = false;
+    bool indexRefreshRunning = false;
+    bool indexRefreshPending = false;
+    
+#ifdef OUTFIT_SQL_LIBRARY
+    QCheckBox* storeCheck;
+    std::unique_ptr<LibraryStore> libraryStore;
+#endif
+};
+
+class VehicleConverterTab : public QWidget {
+    Q_OBJECT
+public:
+    explicit VehicleConverterTab(QWidget* parent = nullptr) : QWidget(parent) {
+        QVBoxLayout* layout = new QVBoxLayout(this);
+        layout->setAlignment(Qt::AlignCenter);
+        
+        QLabel* lockIcon = new QLabel("🔒", this);
+        lockIcon->setAlignment(Qt::AlignCenter);
+        lockIcon->setStyleSheet("font-size: 64px;");
+        layout->addWidget(lockIcon);
+        
+        QLabel* title = new QLabel("Vehicle Converter", this);
+        title->setAlignment(Qt::AlignCenter);
+        title->setStyleSheet("color: #fff; font-size: 28px; font-weight: bold; margin-top: 20px;");
+        layout->addWidget(title);
+        
+        QLabel* message = new QLabel("Coming Soon", this);
+        message->setAlignment(Qt::AlignCenter);
+        message->setStyleSheet("color: #667eea; font-size: 20px; font-weight: bold; margin-top: 10px;");
+        layout->addWidget(message);
+        
+        QLabel* description = new QLabel(
+            "This feature is currently under development.\n"
+            "Vehicle conversion will be available in a future update.\n\n"
+            "Stay tuned!",
+            this
+        );
+        description->setAlignment(Qt::AlignCenter);
+        description->setStyleSheet("color: #aaa; font-size: 14px; margin-top: 20px;");
+        layout->addWidget(description);
+        
+        layout->addStretch();
+    }
+};
+
+class ConverterTab : public QWidget {
+    Q_OBJECT
+public:
+    explicit ConverterTab(QWidget* parent = nullptr) : QWidget(parent) {
+        documentsPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+        setupUI();
+    }
+    
+    // Closing mid-batch stops it where it is; the journal resumes it later.
+    ~ConverterTab() override {
+        if (conversionThread) {
+            batchProgress->cancelRequested.store(true);
+            conversionThread->wait();
+        }
+    }
+    
+private slots:
+    void handleFilesLoad(const QStringList& filePaths) {
+        currentFiles = filePaths;
+        
+        if (filePaths.isEmpty()) return;
+        
+        if (filePaths.size() == 1) {
+            OutfitFormat fmt = detectFormat(filePaths[0]);
+            QString formatStr = getFormatName(fmt);
+            QString icon = getFormatIcon(fmt);
+            QString color = getFormatColor(fmt);
+            
+            detectedFormatLabel->setText(QString("%1 <b>%2</b> format detected").arg(icon, formatStr));
+            detectedFormatLabel->setStyleSheet(QString("color: %1; font-size: 14px; font-weight: normal; padding: 5px;").arg(color));
+            statusLabel->setText("✓ Loaded: " + QFileInfo(filePaths[0]).fileName());
+            statusLabel->setStyleSheet("color: #4CAF50; font-size: 13px; padding: 10px;");
+            
+            convertBtn->setEnabled(fmt != OutfitFormat::Unknown);
         } else {
-            QJsonDocument doc(currentOutfit);
-            content = doc.toJson(QJsonDocument::Indented);
-            outputPath = yimPath + "/YimMenu/" + currentOutfitName + "_exported.json";
+            statusLabel->setText(QString("✓ Loaded %1 files").arg(filePaths.size()));
+            statusLabel->setStyleSheet("color: #4CAF50; font-size: 13px; padding: 10px;");
+            convertBtn->setEnabled(true);
+        }
+        
+        bool showPreview = filePaths.size() > 1;
+        previewModel->setFiles(showPreview ? filePaths : QStringList());
+        previewBox->setVisible(showPreview);
+    }
+    
+    // Has the rows on screen sniffed before the sweep reaches them.
+    void requestVisiblePreviewRows() {
+        int height = previewTable->viewport()->height();
+        int first = previewTable->rowAt(0);
+        if (height <= 0 || first < 0) return;
+        int last = previewTable->rowAt(height - 1);
+        if (last < 0) last = previewModel->rowCount() - 1;
+        previewModel->requestRows(first, last);
+    }
+    
+    void updatePreviewSummary() {
+        int total = previewModel->totalCount();
+        if (total == 0) return;
+        
+        int excluded = previewModel->excludedCount();
+        QString text = QString("📦 <b>%1 files</b> loaded for batch conversion").arg(total);
+        if (previewModel->sniffed() < total) {
+            text += QString(" - checking %1 of %2...").arg(previewModel->sniffed()).arg(total);
+        } else if (previewModel->unknown() > 0) {
+            text += QString(" - <span style='color: #ff6b6b;'>%1 not recognized</span>").arg(previewModel->unknown());
+        }
+        if (excluded > 0) {
+            text += QString(", %1 excluded").arg(excluded);
+        }
+        detectedFormatLabel->setText(text);
+        detectedFormatLabel->setStyleSheet("color: #667eea; font-size: 14px; font-weight: normal; padding: 5px;");
+        convertBtn->setEnabled(excluded < total);
+    }
+    
+    void setPreviewExcluded(bool excluded) {
+        previewModel->setExcluded(previewTable->selectionModel()->selectedRows(), excluded);
+    }
+    
+    void excludeUnknownFiles() {
+        int count = previewModel->excludeUnknown();
+        statusLabel->setText(QString("Excluded %1 unrecognized files").arg(count));
+        statusLabel->setStyleSheet("color: #888; font-size: 13px; padding: 10px;");
+    }
+    
+    void applyPreviewFormat() {
+        OutfitFormat format = formatFromName(previewFormatCombo->currentText());
+        previewModel->setFormatOverride(previewTable->selectionModel()->selectedRows(), format);
+    }
+    
+    void updateMode() {
+        bool isBatch = batchModeRadio->isChecked();
+        dropZone->setBatchMode(isBatch);
+        
+        if (isBatch) {
+            convertBtn->setText("🔄 Batch Convert All to YimMenu");
+        } else {
+            convertBtn->setText("🔄 Convert to YimMenu");
+        }
+    }
+    
+    void addWatchFolder() {
+        QString dirPath = QFileDialog::getExistingDirectory(this, "Select Folder to Watch");
+        if (dirPath.isEmpty()) return;
+        
+        if (watchFolderList->findItems(dirPath, Qt::MatchExactly).isEmpty()) {
+            watchFolderList->addItem(dirPath);
+        }
+        applyWatchState();
+    }
+    
+    void removeWatchFolder() {
+        QListWidgetItem* item = watchFolderList->currentItem();
+        if (!item) return;
+        
+        delete watchFolderList->takeItem(watchFolderList->row(item));
+        applyWatchState();
+    }
+    
+    void applyWatchState() {
+        QStringList folders;
+        for (int i = 0; i < watchFolderList->count(); ++i) {
+            folders.append(watchFolderList->item(i)->text());
+        }
+        
+        QSettings settings;
+        settings.setValue("watch/folders", folders);
+        settings.setValue("watch/enabled", watchEnabledCheck->isChecked());
+        
+        inboxWatcher->clear();
+        if (!watchEnabledCheck->isChecked()) {
+            watchStatusLabel->setText("Watch mode off");
+            watchStatusLabel->setStyleSheet("color: #888; font-size: 12px; font-weight: normal;");
+            return;
+        }
+        
+        QStringList failed;
+        for (const QString& folder : folders) {
+            if (!inboxWatcher->addDirectory(folder)) failed.append(folder);
+        }
+        
+        if (failed.isEmpty()) {
+            watchStatusLabel->setText(QString("👁 Watching %1 folder(s)").arg(inboxWatcher->directories().size()));
+            watchStatusLabel->setStyleSheet("color: #4CAF50; font-size: 12px; font-weight: normal;");
+        } else {
+            watchStatusLabel->setText("⚠ Cannot watch: " + failed.join(", "));
+            watchStatusLabel->setStyleSheet("color: #ff6b6b; font-size: 12px; font-weight: normal;");
+        }
+    }
+    
+    void onWatchConverted(const QString& inputPath, const QString& outputPath) {
+        watchStatusLabel->setText(QString("✓ %1 → %2 at %3")
+            .arg(QFileInfo(inputPath).fileName(), QFileInfo(outputPath).fileName(),
+                 QTime::currentTime().toString("hh:mm:ss")));
+        watchStatusLabel->setStyleSheet("color: #4CAF50; font-size: 12px; font-weight: normal;");
+    }
+    
+    void onWatchFailed(const QString& inputPath, const QString& reason) {
+        watchStatusLabel->setText(QString("✗ %1: %2").arg(QFileInfo(inputPath).fileName(), reason));
+        watchStatusLabel->setStyleSheet("color: #ff6b6b; font-size: 12px; font-weight: normal;");
+    }
+    
+    void applyPathTemplate() {
+        QString pattern = layoutEdit->text().trimmed();
+        if (pattern.isEmpty()) pattern = kDefaultPathTemplate;
+        if (pattern == pathTemplate.pattern()) {
+            showPathTemplateError(QString());
+            return;
         }
         
-        QFile file(outputPath);
-        if (file.open(QIODevice::WriteOnly)) {
-            file.write(content.toUtf8());
-            file.close();
-            QMessageBox::information(this, "Success", "Outfit exported to:\n" + outputPath);
+        QString error;
+        PathTemplate compiled = PathTemplate::compile(pattern, &error);
+        if (!compiled.isValid()) {
+            showPathTemplateError(error + "; still using " + pathTemplate.pattern());
+            statusLabel->setText("⚠ " + error);
+            return;
+        }
+        
+        showPathTemplateError(QString());
+        pathTemplate = compiled;
+        inboxWatcher->setPathTemplate(pathTemplate);
+        QSettings().setValue("output/pathTemplate", pattern);
+        statusLabel->setText("✓ Output layout: " + pattern);
+    }
+    
+    // Marks the layout field red with error as its tooltip; an empty error
+    // restores the normal look.
+    void showPathTemplateError(const QString& error) {
+        if (error.isEmpty()) {
+            layoutEdit->setStyleSheet(QString());
+            layoutEdit->setToolTip(kPathTemplateHelp);
         } else {
-            QMessageBox::critical(this, "Error", "Failed to export outfit");
+            layoutEdit->setStyleSheet("QLineEdit { border: 2px solid #ff6b6b; }");
+            layoutEdit->setToolTip("⚠ " + error + "\n\n" + kPathTemplateHelp);
         }
     }
     
-    void setupUI() {
-        QHBoxLayout* mainLayout = new QHBoxLayout(this);
+    void onManualModeChanged(bool isManual) {
+        if (isManual) {
+            detectedFormatLabel->setText("📝 Manual format selection enabled");
+            detectedFormatLabel->setStyleSheet("color: #f093fb; font-size: 14px; font-weight: normal; padding: 5px;");
+        }
+    }
+    
+    void performConversion() {
+        if (currentFiles.isEmpty() || conversionThread) return;
+        
+        QStringList files = currentFiles;
+        QHash<QString, OutfitFormat> formatOverrides;
+        if (previewModel->totalCount() > 0) {
+            files = previewModel->includedFiles();
+            formatOverrides = previewModel->formatOverrides();
+            if (files.isEmpty()) return;
+        }
         
-        QWidget* leftPanel = new QWidget(this);
-        leftPanel->setMaximumWidth(300);
-        QVBoxLayout* leftLayout = new QVBoxLayout(leftPanel);
+        BatchOptions options;
+        options.outputDir = documentsPath + "/OutfitConverter/YimMenu";
+        options.pathTemplate = pathTemplate.pattern();
+        options.resume = resumeCheck->isChecked();
+        if (manualSelector->isManualMode()) {
+            options.manualSourceFormat = formatFromName(manualSelector->getSourceFormat());
+        }
+        options.formatOverrides = formatOverrides;
+        
+        auto progress = std::make_shared<BatchProgress>();
+        progress->total.store(files.size());
+        batchProgress = progress;
+        
+        // The batch runs off the UI thread, so the window stays usable; the
+        // progress panel samples its counters on a timer.
+        QThread* thread = QThread::create([this, files, options, progress]() mutable {
+            SlotLimits slotLimits = SlotLimits::load(SlotLimits::overridePath());
+            options.slotLimits = &slotLimits;
+            options.progress = progress.get();
+            BatchReport report = runBatchConversion(files, options, nullptr);
+            QMetaObject::invokeMethod(this, [this, report]() { finishConversion(report); }, Qt::QueuedConnection);
+        });
+        connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+        conversionThread = thread;
+        
+        sampledMs = 0;
+        sampledDone = 0;
+        smoothedRate = 0.0;
+        batchClock.start();
+        cancelBtn->setEnabled(true);
+        cancelBtn->setText("Cancel");
+        convertBtn->hide();
+        progressPanel->show();
+        updateBatchProgress();
+        progressTimer->start();
+        thread->start();
+    }
+    
+    void cancelConversion() {
+        if (!batchProgress) return;
+        batchProgress->cancelRequested.store(true);
+        cancelBtn->setEnabled(false);
+        cancelBtn->setText("Stopping...");
+    }
+    
+    // Runs at about 30 Hz while a batch is converting; reads the counters
+    // only, so the workers never wait on the UI.
+    void updateBatchProgress() {
+        if (!batchProgress) return;
+        const BatchProgress& live = *batchProgress;
+        int total = live.total.load();
+        int done = live.finished();
+        
+        // Rate smoothed over roughly the last second, so the ETA does not jump.
+        qint64 elapsed = batchClock.elapsed();
+        if (elapsed > sampledMs) {
+            double instant = (done - sampledDone) * 1000.0 / double(elapsed - sampledMs);
+            smoothedRate = sampledMs == 0 ? instant : smoothedRate * 0.9 + instant * 0.1;
+            sampledMs = elapsed;
+            sampledDone = done;
+        }
         
-        playerNameLabel = new QLabel("Player: Loading...", this);
-        playerNameLabel->setStyleSheet("color: #667eea; font-size: 16px; font-weight: bold; padding: 10px;");
-        leftLayout->addWidget(playerNameLabel);
+        progressBar->setMaximum(qMax(total, 1));
+        progressBar->setValue(qMin(done, qMax(total, 1)));
         
-        QLabel* outfitsLabel = new QLabel("Saved Outfits:", this);
-        outfitsLabel->setStyleSheet("color: #fff; font-size: 14px; font-weight: bold; padding: 5px;");
-        leftLayout->addWidget(outfitsLabel);
+        QStringList parts;
+        parts << QString("%1 of %2 files").arg(done).arg(total);
+        if (smoothedRate >= 1.0) parts << QString("%1 files/s").arg(qRound(smoothedRate));
+        if (total > done && smoothedRate >= 1.0) {
+            int seconds = int(std::ceil((total - done) / smoothedRate));
+            parts << QTime(0, 0).addSecs(seconds).toString(seconds >= 3600 ? "h:mm:ss" : "m:ss") + " left";
+        }
+        QStringList formats;
+        for (OutfitFormat format : {OutfitFormat::Cherax, OutfitFormat::YimMenu, OutfitFormat::Lexis, OutfitFormat::Stand}) {
+            int count = live.convertedByFormat[int(format)].load();
+            if (count > 0) formats << QString("%1 %2").arg(formatName(format)).arg(count);
+        }
+        if (!formats.isEmpty()) parts << formats.join(", ");
+        if (live.resumed.load() > 0) parts << QString("↻ %1 already done").arg(live.resumed.load());
+        if (live.failed.load() > 0) parts << QString("✗ %1 failed").arg(live.failed.load());
+        if (live.invalid.load() > 0) parts << QString("⚠ %1 outside slot limits").arg(live.invalid.load());
+        progressLabel->setText(parts.join("  ·  "));
+    }
+    
+    void finishConversion(const BatchReport& report) {
+        progressTimer->stop();
+        progressPanel->hide();
+        convertBtn->show();
+        conversionThread = nullptr;
+        batchProgress.reset();
+        
+        QString title = report.cancelled ? "Conversion Cancelled" : "Conversion Complete";
+        QString message = QString("%1!\n\n"
+                                 "✓ Successfully converted: %2\n"
+                                 "✗ Failed: %3\n")
+                        .arg(title).arg(report.succeeded).arg(report.failed);
+        
+        if (report.resumed > 0) {
+            message += QString("↻ Already converted by an earlier run: %1\n").arg(report.resumed);
+        }
+        if (report.cancelled) {
+            message += QString("⏸ Not converted yet: %1 (convert the same files again to resume)\n")
+                           .arg(report.remaining());
+        }
+        message += QString("\nFiles saved to:\n%1").arg(documentsPath);
         
-        outfitList = new QListWidget(this);
-        outfitList->setStyleSheet(
-            "QListWidget { background: #2a2a2a; color: #fff; border: 2px solid #444; border-radius: 8px; padding: 5px; }"
-            "QListWidget::item { padding: 8px; border-radius: 4px; }"
-            "QListWidget::item:selected { background: #667eea; }"
-            "QListWidget::item:hover { background: #3a3a3a; }"
-        );
-        connect(outfitList, &QListWidget::itemClicked, this, &OutfitEditorTab::onOutfitSelected);
-        leftLayout->addWidget(outfitList);
+        if (!report.failedFiles.isEmpty()) {
+            message += "\n\nFailed files:\n" + report.failedFiles.join("\n");
+        }
         
-        QPushButton* refreshBtn = new QPushButton("🔄 Refresh List", this);
-        refreshBtn->setStyleSheet(
-            "QPushButton { background: #667eea; color: white; border: none; border-radius: 8px; padding: 10px; font-weight: bold; }"
-            "QPushButton:hover { background: #7e8ef5; }"
-        );
-        connect(refreshBtn, &QPushButton::clicked, this, &OutfitEditorTab::loadPlayerData);
-        leftLayout->addWidget(refreshBtn);
+        // Not modal either: the user may be busy in another tab by now.
+        QMessageBox* summary = new QMessageBox(report.invalidFiles.isEmpty() ? QMessageBox::Information : QMessageBox::Warning,
+                                               title, message, QMessageBox::Ok, this);
+        summary->setAttribute(Qt::WA_DeleteOnClose);
+        summary->setModal(false);
+        if (!report.invalidFiles.isEmpty()) {
+            summary->setInformativeText(QString("⚠ %1 converted outfits break the game's slot limits and may fail in a session.")
+                                            .arg(report.invalidFiles.size()));
+            summary->setDetailedText(report.invalidFiles.join("\n"));
+        }
+        summary->show();
         
-        mainLayout->addWidget(leftPanel);
+        statusLabel->setText(QString("✓ Converted %1 files to YimMenu format").arg(report.succeeded));
+        statusLabel->setStyleSheet("color: #4CAF50; font-size: 13px; padding: 10px;");
+    }
+    
+    QString getFormatName(OutfitFormat fmt) {
+        switch (fmt) {
+            case OutfitFormat::Cherax: return "Cherax";
+            case OutfitFormat::YimMenu: return "YimMenu";
+            case OutfitFormat::Lexis: return "Lexis";
+            case OutfitFormat::Stand: return "Stand";
+            default: return "Unknown";
+        }
+    }
+    
+    QString getFormatIcon(OutfitFormat fmt) {
+        switch (fmt) {
+            case OutfitFormat::Cherax: return "🔷";
+            case OutfitFormat::YimMenu: return "🟣";
+            case OutfitFormat::Lexis: return "🔶";
+            case OutfitFormat::Stand: return "📝";
+            default: return "❓";
+        }
+    }
+    
+    QString getFormatColor(OutfitFormat fmt) {
+        switch (fmt) {
+            case OutfitFormat::Cherax: return "#667eea";
+            case OutfitFormat::YimMenu: return "#764ba2";
+            case OutfitFormat::Lexis: return "#f093fb";
+            case OutfitFormat::Stand: return "#4facfe";
+            default: return "#ff6b6b";
+        }
+    }
+    
+    QPushButton* createStyledButton(const QString& text, const QString& color) {
+        QPushButton* btn = new QPushButton(text, this);
+        btn->setMinimumHeight(50);
+        btn->setCursor(Qt::PointingHandCursor);
+        btn->setStyleSheet(QString(
+            "QPushButton {"
+            "  background: %1;"
+            "  color: white;"
+            "  border: none;"
+            "  border-radius: 8px;"
+            "  font-size: 15px;"
+            "  font-weight: bold;"
+            "  padding: 15px;"
+            "}"
+            "QPushButton:hover {"
+            "  background: qlineargradient(x1:0, y1:0, x2:1, y2:0, stop:0 %1, stop:1 %2);"
+            "}"
+            "QPushButton:pressed {"
+            "  background: #555;"
+            "}"
+            "QPushButton:disabled {"
+            "  background: #333;"
+            "  color: #666;"
+            "}"
+        ).arg(color).arg(color));
         
-        QWidget* rightPanel = new QWidget(this);
-        QVBoxLayout* rightLayout = new QVBoxLayout(rightPanel);
+        return btn;
+    }
+    
+    void setupUI() {
+        QVBoxLayout* mainLayout = new QVBoxLayout(this);
+        mainLayout->setSpacing(20);
+        mainLayout->setContentsMargins(30, 30, 30, 30);
         
-        QLabel* editorTitle = new QLabel("Outfit Editor", this);
-        editorTitle->setStyleSheet("color: #fff; font-size: 18px; font-weight: bold; padding: 10px;");
-        rightLayout->addWidget(editorTitle);
+        dropZone = new DropZone(this);
+        connect(dropZone, &DropZone::filesDropped, this, &ConverterTab::handleFilesLoad);
+        mainLayout->addWidget(dropZone);
         
-        QHBoxLayout* nameLayout = new QHBoxLayout();
-        QLabel* nameLabel = new QLabel("Outfit Name:", this);
-        nameLabel->setStyleSheet("color: #fff; font-weight: bold;");
-        outfitNameEdit = new QLineEdit(this);
-        outfitNameEdit->setStyleSheet("QLineEdit { background: #2a2a2a; color: #fff; border: 2px solid #444; padding: 8px; border-radius: 6px; }");
-        QPushButton* renameBtn = new QPushButton("✏️ Rename", this);
-        renameBtn->setStyleSheet(
-            "QPushButton { background: #764ba2; color: white; border: none; border-radius: 6px; padding: 8px 15px; font-weight: bold; }"
-            "QPushButton:hover { background: #8e5bb8; }"
+        QGroupBox* detectionBox = new QGroupBox("Auto-Detection", this);
+        
+        QVBoxLayout* detectionLayout = new QVBoxLayout(detectionBox);
+        detectedFormatLabel = new QLabel("No files loaded", this);
+        detectedFormatLabel->setAlignment(Qt::AlignCenter);
+        detectedFormatLabel->setStyleSheet("color: #888; font-size: 13px; font-weight: normal; padding: 5px;");
+        detectionLayout->addWidget(detectedFormatLabel);
+        mainLayout->addWidget(detectionBox);
+        
+        previewBox = new QGroupBox("Batch Preview", this);
+        previewBox->setStyleSheet(
+            "QTableView { background: #1a1a1a; color: #fff; border: 2px solid #555; border-radius: 6px; "
+            "font-weight: normal; gridline-color: #333; selection-background-color: #667eea; }"
+            "QHeaderView::section { background: #2a2a2a; color: #aaa; border: none; padding: 4px; }"
+            "QPushButton { background: #3a3a3a; color: white; border: none; border-radius: 6px; padding: 6px 12px; font-weight: bold; }"
+            "QPushButton:hover { background: #4a4a4a; }"
+            "QComboBox { background: #1a1a1a; color: #fff; border: 2px solid #555; padding: 4px; border-radius: 6px; font-weight: normal; }"
+            "QComboBox QAbstractItemView { background: #2a2a2a; color: #fff; selection-background-color: #667eea; }"
         );
-        connect(renameBtn, &QPushButton::clicked, this, &OutfitEditorTab::renameOutfit);
-        nameLayout->addWidget(nameLabel);
-        nameLayout->addWidget(outfitNameEdit, 1);
-        nameLayout->addWidget(renameBtn);
-        rightLayout->addLayout(nameLayout);
+        QVBoxLayout* previewLayout = new QVBoxLayout(previewBox);
+        
+        previewModel = new BatchPreviewModel(this);
+        connect(previewModel, &BatchPreviewModel::summaryChanged, this, &ConverterTab::updatePreviewSummary);
+        
+        // Fixed row heights keep the view from measuring rows it does not show.
+        previewTable = new QTableView(this);
+        previewTable->setModel(previewModel);
+        previewTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+        previewTable->setSelectionMode(QAbstractItemView::ExtendedSelection);
+        previewTable->setShowGrid(false);
+        previewTable->setWordWrap(false);
+        previewTable->verticalHeader()->setVisible(false);
+        previewTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+        previewTable->verticalHeader()->setDefaultSectionSize(22);
+        previewTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+        previewTable->horizontalHeader()->setStretchLastSection(true);
+        previewTable->setColumnWidth(BatchPreviewModel::FileColumn, 320);
+        previewTable->setColumnWidth(BatchPreviewModel::FormatColumn, 130);
+        previewTable->setColumnWidth(BatchPreviewModel::ModelColumn, 110);
+        previewTable->setMinimumHeight(180);
+        // Scrolling, resizing and new files all change which rows are on screen.
+        connect(previewTable->verticalScrollBar(), &QScrollBar::valueChanged,
+                this, &ConverterTab::requestVisiblePreviewRows);
+        connect(previewTable->verticalScrollBar(), &QScrollBar::rangeChanged,
+                this, &ConverterTab::requestVisiblePreviewRows);
+        connect(previewModel, &QAbstractItemModel::modelReset, this, &ConverterTab::requestVisiblePreviewRows);
+        previewLayout->addWidget(previewTable);
+        
+        QHBoxLayout* previewButtonLayout = new QHBoxLayout();
+        QPushButton* excludeBtn = new QPushButton("Exclude Selected", this);
+        connect(excludeBtn, &QPushButton::clicked, this, [this]() { setPreviewExcluded(true); });
+        QPushButton* includeBtn = new QPushButton("Include Selected", this);
+        connect(includeBtn, &QPushButton::clicked, this, [this]() { setPreviewExcluded(false); });
+        QPushButton* excludeUnknownBtn = new QPushButton("Exclude Unrecognized", this);
+        connect(excludeUnknownBtn, &QPushButton::clicked, this, &ConverterTab::excludeUnknownFiles);
+        previewFormatCombo = new QComboBox(this);
+        previewFormatCombo->addItems({"Auto-detect", "Cherax", "YimMenu", "Lexis", "Stand"});
+        QPushButton* formatBtn = new QPushButton("Set Format", this);
+        formatBtn->setToolTip("Force the source format of the selected files");
+        connect(formatBtn, &QPushButton::clicked, this, &ConverterTab::applyPreviewFormat);
+        previewButtonLayout->addWidget(excludeBtn);
+        previewButtonLayout->addWidget(includeBtn);
+        previewButtonLayout->addWidget(excludeUnknownBtn);
+        previewButtonLayout->addStretch();
+        previewButtonLayout->addWidget(previewFormatCombo);
+        previewButtonLayout->addWidget(formatBtn);
+        previewLayout->addLayout(previewButtonLayout);
+        
+        previewBox->setVisible(false);
+        mainLayout->addWidget(previewBox, 1);
         
-        QScrollArea* scrollArea = new QScrollArea(this);
-        scrollArea->setWidgetResizable(true);
-        scrollArea->setStyleSheet("QScrollArea { border: none; background: #1a1a1a; }");
+        // Add manual format selector
+        manualSelector = new ManualFormatSelector(this);
+        connect(manualSelector, &ManualFormatSelector::modeChanged, this, &ConverterTab::onManualModeChanged);
+        mainLayout->addWidget(manualSelector);
         
-        QWidget* scrollWidget = new QWidget();
-        QVBoxLayout* scrollLayout = new QVBoxLayout(scrollWidget);
+        QGroupBox* modeBox = new QGroupBox("Conversion Mode", this);
         
-        QLabel* compLabel = new QLabel("Components:", this);
-        compLabel->setStyleSheet("color: #667eea; font-size: 16px; font-weight: bold; margin-top: 10px;");
-        scrollLayout->addWidget(compLabel);
+        QVBoxLayout* modeLayout = new QVBoxLayout(modeBox);
+        singleModeRadio = new QRadioButton("Single File Mode - Convert one file at a time", this);
+        batchModeRadio = new QRadioButton("Batch Mode - Convert multiple files at once", this);
         
-        componentsLayout = new QVBoxLayout();
-        scrollLayout->addLayout(componentsLayout);
+        singleModeRadio->setChecked(true);
         
-        QLabel* propsLabel = new QLabel("Props:", this);
-        propsLabel->setStyleSheet("color: #764ba2; font-size: 16px; font-weight: bold; margin-top: 20px;");
-        scrollLayout->addWidget(propsLabel);
+        buttonGroup = new QButtonGroup(this);
+        buttonGroup->addButton(singleModeRadio);
+        buttonGroup->addButton(batchModeRadio);
         
-        propsLayout = new QVBoxLayout();
-        scrollLayout->addLayout(propsLayout);
+        connect(singleModeRadio, &QRadioButton::toggled, this, &ConverterTab::updateMode);
         
-        scrollLayout->addStretch();
-        scrollArea->setWidget(scrollWidget);
-        rightLayout->addWidget(scrollArea);
+        modeLayout->addWidget(singleModeRadio);
+        modeLayout->addWidget(batchModeRadio);
         
-        QHBoxLayout* exportLayout = new QHBoxLayout();
-        QLabel* exportLabel = new QLabel("Export to:", this);
-        exportLabel->setStyleSheet("color: #fff; font-weight: bold;");
-        exportFormatCombo = new QComboBox(this);
-        exportFormatCombo->addItems({"YimMenu", "Cherax", "Lexis", "Stand"});
-        exportFormatCombo->setStyleSheet(
-            "QComboBox { background: #2a2a2a; color: #fff; border: 2px solid #444; padding: 8px; border-radius: 6px; }"
-            "QComboBox::drop-down { border: none; }"
-            "QComboBox QAbstractItemView { background: #2a2a2a; color: #fff; selection-background-color: #667eea; }"
-        );
-        QPushButton* exportBtn = new QPushButton("📤 Export Outfit", this);
-        exportBtn->setStyleSheet(
-            "QPushButton { background: #4CAF50; color: white; border: none; border-radius: 6px; padding: 10px 20px; font-weight: bold; }"
-            "QPushButton:hover { background: #5dbf60; }"
+        durableCheck = new QCheckBox("Durable writes - flush every output to disk before reporting success", this);
+        durableCheck->setStyleSheet("QCheckBox { color: #aaa; font-size: 12px; font-weight: normal; spacing: 8px; }");
+        durableCheck->setChecked(QSettings().value("output/durable", false).toBool());
+        OutputWriter::instance().setDurable(durableCheck->isChecked());
+        connect(durableCheck, &QCheckBox::toggled, this, [](bool checked) {
+            OutputWriter::instance().setDurable(checked);
+            QSettings().setValue("output/durable", checked);
+        });
+        modeLayout->addWidget(durableCheck);
+        
+        resumeCheck = new QCheckBox("Resume unfinished batches - skip inputs an earlier run already converted", this);
+        resumeCheck->setStyleSheet("QCheckBox { color: #aaa; font-size: 12px; font-weight: normal; spacing: 8px; }");
+        resumeCheck->setChecked(QSettings().value("batch/resume", true).toBool());
+        connect(resumeCheck, &QCheckBox::toggled, this, [](bool checked) {
+            QSettings().setValue("batch/resume", checked);
+        });
+        modeLayout->addWidget(resumeCheck);
+        
+        QHBoxLayout* layoutRow = new QHBoxLayout();
+        QLabel* layoutLabel = new QLabel("Output layout:", this);
+        layoutLabel->setObjectName("fieldLabel");
+        layoutEdit = new QLineEdit(this);
+        layoutEdit->setPlaceholderText(kDefaultPathTemplate);
+        layoutEdit->setToolTip(kPathTemplateHelp);
+        layoutEdit->setText(QSettings().value("output/pathTemplate", kDefaultPathTemplate).toString());
+        QString layoutError;
+        pathTemplate = PathTemplate::compile(layoutEdit->text(), &layoutError);
+        if (!pathTemplate.isValid()) {
+            pathTemplate = PathTemplate::compile(kDefaultPathTemplate);
+            showPathTemplateError(layoutError + "; using " + kDefaultPathTemplate + " until it is fixed");
+        }
+        connect(layoutEdit, &QLineEdit::editingFinished, this, &ConverterTab::applyPathTemplate);
+        layoutRow->addWidget(layoutLabel);
+        layoutRow->addWidget(layoutEdit, 1);
+        modeLayout->addLayout(layoutRow);
+        mainLayout->addWidget(modeBox);
+        
+        QGroupBox* watchBox = new QGroupBox("Watch Folders", this);
+        watchBox->setStyleSheet(
+            "QCheckBox { color: #fff; font-size: 13px; font-weight: normal; spacing: 8px; }"
+            "QListWidget { background: #1a1a1a; color: #fff; border: 2px solid #555; border-radius: 6px; font-weight: normal; }"
+            "QListWidget::item:selected { background: #667eea; }"
+            "QPushButton { background: #3a3a3a; color: white; border: none; border-radius: 6px; padding: 6px 12px; font-weight: bold; }"
+            "QPushButton:hover { background: #4a4a4a; }"
         );
-        connect(exportBtn, &QPushButton::clicked, this, &OutfitEditorTab::exportOutfit);
-        exportLayout->addWidget(exportLabel);
-        exportLayout->addWidget(exportFormatCombo, 1);
-        exportLayout->addWidget(exportBtn);
-        rightLayout->addLayout(exportLayout);
         
-        statusLabel = new QLabel("Select an outfit to begin editing", this);
-        statusLabel->setStyleSheet("color: #888; font-size: 12px; padding: 5px;");
-        statusLabel->setAlignment(Qt::AlignCenter);
-        rightLayout->addWidget(statusLabel);
+        QVBoxLayout* watchLayout = new QVBoxLayout(watchBox);
+        QSettings settings;
+        
+        watchEnabledCheck = new QCheckBox("Auto-convert new files dropped into these folders to YimMenu", this);
+        watchEnabledCheck->setChecked(settings.value("watch/enabled", false).toBool());
+        connect(watchEnabledCheck, &QCheckBox::toggled, this, &ConverterTab::applyWatchState);
+        watchLayout->addWidget(watchEnabledCheck);
+        
+        watchFolderList = new QListWidget(this);
+        watchFolderList->setMaximumHeight(80);
+        watchFolderList->addItems(settings.value("watch/folders").toStringList());
+        watchLayout->addWidget(watchFolderList);
+        
+        QHBoxLayout* watchButtonLayout = new QHBoxLayout();
+        QPushButton* addWatchBtn = new QPushButton("➕ Add Folder", this);
+        connect(addWatchBtn, &QPushButton::clicked, this, &ConverterTab::addWatchFolder);
+        QPushButton* removeWatchBtn = new QPushButton("➖ Remove", this);
+        connect(removeWatchBtn, &QPushButton::clicked, this, &ConverterTab::removeWatchFolder);
+        watchStatusLabel = new QLabel(this);
+        watchStatusLabel->setStyleSheet("color: #888; font-size: 12px; font-weight: normal;");
+        watchButtonLayout->addWidget(addWatchBtn);
+        watchButtonLayout->addWidget(removeWatchBtn);
+        watchButtonLayout->addWidget(watchStatusLabel, 1);
+        watchLayout->addLayout(watchButtonLayout);
+        mainLayout->addWidget(watchBox);
+        
+        inboxWatcher = new InboxWatcher(this);
+        inboxWatcher->setPathTemplate(pathTemplate);
+        connect(inboxWatcher, &InboxWatcher::fileConverted, this, &ConverterTab::onWatchConverted);
+        connect(inboxWatcher, &InboxWatcher::fileFailed, this, &ConverterTab::onWatchFailed);
+        QTimer::singleShot(0, this, &ConverterTab::applyWatchState);
         
-        mainLayout->addWidget(rightPanel, 1);
+        convertBtn = createStyledButton("🔄 Convert to YimMenu", "#667eea");
+        connect(convertBtn, &QPushButton::clicked, this, &ConverterTab::performConversion);
+        convertBtn->setEnabled(false);
+        mainLayout->addWidget(convertBtn);
+        
+        // Takes the convert button's place while a batch runs.
+        progressPanel = new QWidget(this);
+        progressPanel->setStyleSheet(
+            "QProgressBar { background: #1a1a1a; border: 2px solid #444; border-radius: 6px; height: 14px; }"
+            "QProgressBar::chunk { background: #667eea; border-radius: 4px; }"
+            "QLabel { color: #aaa; font-size: 12px; font-weight: normal; }"
+            "QPushButton { background: #3a3a3a; color: white; border: none; border-radius: 6px; padding: 8px 16px; font-weight: bold; }"
+            "QPushButton:hover { background: #4a4a4a; }"
+            "QPushButton:disabled { background: #333; color: #666; }");
+        QHBoxLayout* progressLayout = new QHBoxLayout(progressPanel);
+        progressLayout->setContentsMargins(0, 0, 0, 0);
+        QVBoxLayout* progressTextLayout = new QVBoxLayout();
+        progressBar = new QProgressBar(progressPanel);
+        progressBar->setTextVisible(false);
+        progressLabel = new QLabel(progressPanel);
+        progressTextLayout->addWidget(progressBar);
+        progressTextLayout->addWidget(progressLabel);
+        progressLayout->addLayout(progressTextLayout, 1);
+        cancelBtn = new QPushButton("Cancel", progressPanel);
+        connect(cancelBtn, &QPushButton::clicked, this, &ConverterTab::cancelConversion);
+        progressLayout->addWidget(cancelBtn);
+        progressPanel->hide();
+        mainLayout->addWidget(progressPanel);
+        
+        progressTimer = new QTimer(this);
+        progressTimer->setInterval(33);
+        connect(progressTimer, &QTimer::timeout, this, &ConverterTab::updateBatchProgress);
+        
+        statusLabel = new QLabel("Load file(s) to begin", this);
+        statusLabel->setAlignment(Qt::AlignCenter);
+        statusLabel->setStyleSheet("color: #888; font-size: 13px; padding: 10px;");
+        mainLayout->addWidget(statusLabel);
     }
     
 private:
-    QLabel* playerNameLabel;
-    QListWidget* outfitList;
-    QLineEdit* outfitNameEdit;
-    QComboBox* exportFormatCombo;
-    QVBoxLayout* componentsLayout;
-    QVBoxLayout* propsLayout;
+    DropZone* dropZone;
+    QPushButton* convertBtn;
+    QWidget* progressPanel;
+    QProgressBar* progressBar;
+    QLabel* progressLabel;
+    QPushButton* cancelBtn;
+    QTimer* progressTimer;
+    QPointer<QThread> conversionThread;
+    std::shared_ptr<BatchProgress> batchProgress;
+    QElapsedTimer batchClock;
+    qint64 sampledMs = 0;
+    int sampledDone = 0;
+    double smoothedRate = 0.0;
     QLabel* statusLabel;
-    
-    QMap<int, QSpinBox*> componentSpinBoxes;
-    QMap<int, QSpinBox*> textureSpinBoxes;
-    QMap<int, QSpinBox*> propDrawableSpinBoxes;
-    QMap<int, QSpinBox*> propTextureSpinBoxes;
-    
-    QString currentOutfitName;
-    QJsonObject currentOutfit;
+    QLabel* detectedFormatLabel;
+    QRadioButton* singleModeRadio;
+    QRadioButton* batchModeRadio;
+    QButtonGroup* buttonGroup;
+    QStringList currentFiles;
+    QString documentsPath;
+    ManualFormatSelector* manualSelector;
+    QCheckBox* durableCheck;
+    QCheckBox* resumeCheck;
+    QLineEdit* layoutEdit;
+    PathTemplate pathTemplate;
+    QCheckBox* watchEnabledCheck;
+    QListWidget* watchFolderList;
+    QLabel* watchStatusLabel;
+    InboxWatcher* inboxWatcher;
+    QGroupBox* previewBox;
+    QTableView* previewTable;
+    QComboBox* previewFormatCombo;
+    BatchPreviewModel* previewModel;
 };
 
-class VehicleConverterTab : public QWidget {
+// Application Style Sheet
+// Styles shared by every widget of a type, parsed once for the whole app
+// instead of once per widget. Widgets only set a local sheet for accents of
+// their own.
+const char* const kAppStyleSheet =
+    "QMainWindow { background: qlineargradient(x1:0, y1:0, x2:0, y2:1, stop:0 #1a1a1a, stop:1 #0d0d0d); }"
+    "QTabWidget::pane { border: 2px solid #444; border-radius: 8px; background: #1a1a1a; }"
+    "QTabBar::tab { background: #2a2a2a; color: #aaa; padding: 12px 24px; border: 2px solid #444; "
+    "border-bottom:none; margin-right: 2px; border-top-left-radius: 8px; border-top-right-radius: 8px; }"
+    "QTabBar::tab:selected { background: #667eea; color: white; font-weight: bold; }"
+    "QTabBar::tab:hover { background: #3a3a3a; }"
+    "QGroupBox { background: #2a2a2a; border: 2px solid #444; border-radius: 12px; "
+    "margin-top: 10px; padding-top: 20px; color: #fff; font-size: 14px; font-weight: bold; }"
+    "QGroupBox::title { subcontrol-origin: margin; left: 15px; padding: 0 5px; }"
+    "QRadioButton { color: #fff; font-size: 13px; font-weight: normal; spacing: 8px; }"
+    "QRadioButton::indicator { width: 18px; height: 18px; }"
+    "QRadioButton::indicator::unchecked { border: 2px solid #666; border-radius: 9px; background: #1a1a1a; }"
+    "QRadioButton::indicator::checked { border: 2px solid #667eea; border-radius: 9px; background: qradialgradient(cx:0.5, cy:0.5, radius:0.5, fx:0.5, fy:0.5, stop:0 #667eea, stop:1 #667eea); }"
+    "QLabel#fieldLabel { color: #fff; font-weight: bold; }"
+    "QSpinBox { background: #2a2a2a; color: #fff; border: 1px solid #555; padding: 5px; }"
+    "QLineEdit { background: #2a2a2a; color: #fff; border: 2px solid #444; padding: 8px; border-radius: 6px; }"
+    "QComboBox { background: #2a2a2a; color: #fff; border: 2px solid #444; padding: 8px; border-radius: 6px; }"
+    "QComboBox::drop-down { border: none; }"
+    "QComboBox QAbstractItemView { background: #2a2a2a; color: #fff; selection-background-color: #667eea; }"
+    "QScrollArea { border: none; background: #1a1a1a; }";
+
+class MainWindow : public QMainWindow {
     Q_OBJECT
-public:
-    explicit VehicleConverterTab(QWidget* parent = nullptr) : QWidget(parent) {
-        QVBoxLayout* layout = new QVBoxLayout(this);
-        layout->setAlignment(Qt::AlignCenter);
+public:
+    MainWindow(QWidget* parent = nullptr) : QMainWindow(parent) {
+        setWindowTitle("Outfit Converter Pro - Multi-Format Support");
+        setMinimumSize(1100, 900);
         
-        QLabel* lockIcon = new QLabel("🔒", this);
-        lockIcon->setAlignment(Qt::AlignCenter);
-        lockIcon->setStyleSheet("font-size: 64px;");
-        layout->addWidget(lockIcon);
+        QWidget* central = new QWidget(this);
+        setCentralWidget(central);
         
-        QLabel* title = new QLabel("Vehicle Converter", this);
+        QVBoxLayout* mainLayout = new QVBoxLayout(central);
+        mainLayout->setSpacing(10);
+        mainLayout->setContentsMargins(20, 20, 20, 20);
+        
+        QLabel* title = new QLabel("Outfit Converter Pro", this);
         title->setAlignment(Qt::AlignCenter);
-        title->setStyleSheet("color: #fff; font-size: 28px; font-weight: bold; margin-top: 20px;");
-        layout->addWidget(title);
+        title->setStyleSheet("font-size: 28px; font-weight: bold; color: #fff; margin-bottom: 5px;");
+        mainLayout->addWidget(title);
         
-        QLabel* message = new QLabel("Coming Soon", this);
-        message->setAlignment(Qt::AlignCenter);
-        message->setStyleSheet("color: #667eea; font-size: 20px; font-weight: bold; margin-top: 10px;");
-        layout->addWidget(message);
+        QLabel* subtitle = new QLabel("Convert, Edit & Manage - Cherax, YimMenu, Lexis & Stand", this);
+        subtitle->setAlignment(Qt::AlignCenter);
+        subtitle->setStyleSheet("font-size: 14px; color: #aaa; margin-bottom: 5px;");
+        mainLayout->addWidget(subtitle);
         
-        QLabel* description = new QLabel(
-            "This feature is currently under development.\n"
-            "Vehicle conversion will be available in a future update.\n\n"
-            "Stay tuned!",
-            this
-        );
-        description->setAlignment(Qt::AlignCenter);
-        description->setStyleSheet("color: #aaa; font-size: 14px; margin-top: 20px;");
-        layout->addWidget(description);
+        QLabel* credits = new QLabel("Enhanced by @sizrox", this);
+        credits->setAlignment(Qt::AlignCenter);
+        credits->setStyleSheet("font-size: 11px; color: #667eea; margin-bottom: 15px; font-style: italic;");
+        mainLayout->addWidget(credits);
         
-        layout->addStretch();
+        QTabWidget* tabWidget = new QTabWidget(this);
+        tabWidget->addTab(new LazyTab("Converter", [](QWidget* parent) { return new ConverterTab(parent); }, this),
+                          "🔄 Converter");
+        tabWidget->addTab(new LazyTab("Outfit Editor", [](QWidget* parent) { return new OutfitEditorTab(parent); }, this),
+                          "✏️ Outfit Editor");
+        tabWidget->addTab(new LazyTab("Vehicle Converter", [](QWidget* parent) { return new VehicleConverterTab(parent); }, this),
+                          "🚗 Vehicle Converter");
+        
+        mainLayout->addWidget(tabWidget);
+        
+        // Creating the output folders and sweeping stale temp files from
+        // them does not have to hold up the first paint.
+        QThreadPool::globalInstance()->start(ensureOutputDirectories);
     }
 };
 
-class ConverterTab : public QWidget {
-    Q_OBJECT
+// Converter Self-Test
+// Randomized property checks for the conversion functions: round trips
+// through every format and back, longer conversion chains, sync idempotence,
+// and differential checks of the file-level paths against the per-format
+// functions. Failures print the seed and case index so they can be replayed.
+class ConverterSelfTest {
 public:
-    explicit ConverterTab(QWidget* parent = nullptr) : QWidget(parent) {
-        setupOutputDirectories();
-        setupUI();
+    explicit ConverterSelfTest(quint32 seed) : seed(seed), rng(seed) {}
+    
+    int run(int iterations, QTextStream& err) {
+        for (int i = 0; i < iterations; ++i) {
+            caseIndex = i;
+            QJsonObject yim = randomYim();
+            QJsonObject cherax = randomCherax();
+            
+            checkYimRoundTrips(yim);
+            checkCheraxRoundTrips(cherax);
+            checkDifferential(yim, cherax);
+        }
+        
+        for (const QString& message : failures.mid(0, 20)) {
+            err << message << Qt::endl;
+        }
+        if (failures.size() > 20) {
+            err << "... " << failures.size() - 20 << " more" << Qt::endl;
+        }
+        err << QString("%1 checks over %2 outfits, %3 failed (seed %4)")
+                   .arg(checks).arg(iterations).arg(failures.size()).arg(seed)
+            << Qt::endl;
+        return failures.size();
     }
     
-private slots:
-    void handleFilesLoad(const QStringList& filePaths) {
-        currentFiles = filePaths;
+private:
+    QJsonObject randomSlots(int count, double presence, int maxDrawable, int maxTexture) {
+        QJsonObject slotObjects;
+        for (int i = 0; i < count; ++i) {
+            if (rng.generateDouble() >= presence) continue;
+            QJsonObject slot;
+            slot["drawable_id"] = rng.bounded(-1, maxDrawable);
+            slot["texture_id"] = rng.bounded(0, maxTexture);
+            slotObjects[QString::number(i)] = slot;
+        }
+        return slotObjects;
+    }
+    
+    QJsonObject randomYim() {
+        QJsonObject yim;
+        int modelPick = rng.bounded(3);
+        yim["model"] = modelPick == 0 ? kFreemodeMaleModel
+                     : modelPick == 1 ? kFreemodeFemaleModel
+                                      : static_cast<qint64>(static_cast<qint32>(rng.generate()));
+        
+        // Quarter steps survive the JSON round trip exactly.
+        QJsonObject blendData;
+        blendData["is_parent"] = rng.bounded(2);
+        blendData["shape_first_id"] = rng.bounded(46);
+        blendData["shape_second_id"] = rng.bounded(46);
+        blendData["shape_third_id"] = rng.bounded(46);
+        blendData["skin_first_id"] = rng.bounded(46);
+        blendData["skin_second_id"] = rng.bounded(46);
+        blendData["skin_third_id"] = rng.bounded(46);
+        blendData["shape_mix"] = rng.bounded(5) / 4.0;
+        blendData["skin_mix"] = rng.bounded(5) / 4.0;
+        blendData["third_mix"] = rng.bounded(5) / 4.0;
+        yim["blend_data"] = blendData;
         
-        if (filePaths.isEmpty()) return;
+        if (rng.bounded(2) == 0) {
+            QJsonArray features;
+            for (int i = 0; i < kFaceFeatureCount; ++i) features.append((rng.bounded(9) - 4) / 4.0);
+            features[rng.bounded(kFaceFeatureCount)] = 0.5;  // never the default face
+            yim["face_features"] = features;
+        }
         
-        if (filePaths.size() == 1) {
-            OutfitFormat fmt = detectFormat(filePaths[0]);
-            QString formatStr = getFormatName(fmt);
-            QString icon = getFormatIcon(fmt);
-            QString color = getFormatColor(fmt);
-            
-            detectedFormatLabel->setText(QString("%1 <b>%2</b> format detected").arg(icon, formatStr));
-            detectedFormatLabel->setStyleSheet(QString("color: %1; font-size: 14px; font-weight: normal; padding: 5px;").arg(color));
-            statusLabel->setText("✓ Loaded: " + QFileInfo(filePaths[0]).fileName());
-            statusLabel->setStyleSheet("color: #4CAF50; font-size: 13px; padding: 10px;");
-            
-            convertBtn->setEnabled(fmt != OutfitFormat::Unknown);
-        } else {
-            detectedFormatLabel->setText(QString("📦 <b>%1 files</b> loaded for batch conversion").arg(filePaths.size()));
-            detectedFormatLabel->setStyleSheet("color: #667eea; font-size: 14px; font-weight: normal; padding: 5px;");
-            statusLabel->setText(QString("✓ Loaded %1 files").arg(filePaths.size()));
-            statusLabel->setStyleSheet("color: #4CAF50; font-size: 13px; padding: 10px;");
-            convertBtn->setEnabled(true);
+        yim["components"] = randomSlots(kComponentSlotCount, 0.7, 400, 26);
+        yim["props"] = randomSlots(kPropSlotCount, 0.5, 200, 16);
+        if (rng.bounded(4) == 0) {
+            yim["custom_note"] = QString("note %1").arg(rng.bounded(1000));
         }
+        return yim;
     }
     
-    void updateMode() {
-        bool isBatch = batchModeRadio->isChecked();
-        dropZone->setBatchMode(isBatch);
+    QJsonObject randomCherax() {
+        QJsonObject cherax = withoutExtensions(yimToCherax(randomYim()));
+        
+        cherax["baseFlags"] = static_cast<qint64>(rng.generate() & 0xFFFFF);
+        cherax["primary_hair_tint"] = rng.bounded(64);
+        cherax["secondary_hair_tint"] = rng.bounded(64);
+        
+        QJsonObject features = cherax.value("face_features").toObject();
+        for (const QString& key : features.keys()) {
+            // Mostly quarter steps, sometimes a value a float cannot hold.
+            features[key] = rng.bounded(4) == 0 ? rng.generateDouble() * 2.0 - 1.0
+                                                : (rng.bounded(9) - 4) / 4.0;
+        }
+        cherax["face_features"] = features;
         
-        if (isBatch) {
-            convertBtn->setText("🔄 Batch Convert All to YimMenu");
-        } else {
-            convertBtn->setText("🔄 Convert to YimMenu");
+        QJsonObject components = cherax.value("components").toObject();
+        for (const QString& key : components.keys()) {
+            QJsonObject comp = components[key].toObject();
+            comp["palette"] = rng.bounded(4);
+            components[key] = comp;
+        }
+        cherax["components"] = components;
+        
+        if (rng.bounded(3) == 0) {
+            QJsonObject attachment;
+            attachment["model"] = static_cast<qint64>(rng.generate() & 0x7FFFFFFF);
+            attachment["bone"] = rng.bounded(100);
+            cherax["attachments"] = QJsonArray({attachment});
         }
+        return cherax;
     }
     
-    void onManualModeChanged(bool isManual) {
-        if (isManual) {
-            detectedFormatLabel->setText("📝 Manual format selection enabled");
-            detectedFormatLabel->setStyleSheet("color: #f093fb; font-size: 14px; font-weight: normal; padding: 5px;");
+    static QJsonObject withoutExtensions(QJsonObject obj) {
+        obj.remove(kExtensionKey);
+        return obj;
+    }
+    
+    static QJsonObject parse(const QString& text) {
+        return QJsonDocument::fromJson(text.toUtf8()).object();
+    }
+    
+    static QByteArray serialize(const QJsonObject& obj) {
+        return QJsonDocument(obj).toJson(QJsonDocument::Indented);
+    }
+    
+    void expect(bool ok, const QString& check, const QJsonObject& expected = QJsonObject(),
+                const QJsonObject& actual = QJsonObject()) {
+        checks++;
+        if (ok) return;
+        
+        QString message = QString("FAIL seed %1 case %2: %3").arg(seed).arg(caseIndex).arg(check);
+        if (!expected.isEmpty() || !actual.isEmpty()) {
+            message += "\n  expected: " + QString(QJsonDocument(expected).toJson(QJsonDocument::Compact)) +
+                       "\n  actual:   " + QString(QJsonDocument(actual).toJson(QJsonDocument::Compact));
         }
+        failures.append(message);
     }
     
-    void performConversion() {
-        if (currentFiles.isEmpty()) return;
+    void expectSame(const QJsonObject& expected, const QJsonObject& actual, const QString& check) {
+        QJsonObject a = withoutExtensions(expected);
+        QJsonObject b = withoutExtensions(actual);
+        expect(a == b, check, a, b);
+    }
+    
+    // Only what Stand's text can express: the model and its slots.
+    static QJsonObject standView(const QJsonObject& yim) {
+        static const QList<int> standProps = {0, 1, 2, 6, 7};
+        QJsonObject view;
+        view["model"] = yim.value("model");
+        view["components"] = yim.value("components");
+        
+        QJsonObject props;
+        const QJsonObject yimProps = yim.value("props").toObject();
+        for (int slot : standProps) {
+            QString key = QString::number(slot);
+            if (yimProps.contains(key)) props[key] = yimProps[key];
+        }
+        view["props"] = props;
+        return view;
+    }
+    
+    void checkYimRoundTrips(const QJsonObject& yim) {
+        expectSame(yim, cheraxToYim(yimToCherax(yim)), "YimMenu -> Cherax -> YimMenu");
+        expectSame(yim, lexisToYim(yimToLexis(yim)), "YimMenu -> Lexis -> YimMenu");
+        expectSame(standView(yim), standView(parse(standToYim(yimToStand(yim)))),
+                   "YimMenu -> Stand -> YimMenu (Stand fields)");
+        
+        QJsonObject chained = cheraxToYim(yimToCherax(lexisToYim(yimToLexis(cheraxToYim(yimToCherax(yim))))));
+        expectSame(yim, chained, "YimMenu -> Cherax -> YimMenu -> Lexis -> YimMenu -> Cherax -> YimMenu");
+        
+        // A second sync of the same outfit must produce the same bytes.
+        QByteArray first = serialize(yimToCherax(yim));
+        QByteArray second = serialize(yimToCherax(cheraxToYim(yimToCherax(yim))));
+        expect(first == second, "YimMenu -> Cherax is idempotent across syncs");
+    }
+    
+    void checkCheraxRoundTrips(const QJsonObject& cherax) {
+        expectSame(cherax, yimToCherax(cheraxToYim(cherax)), "Cherax -> YimMenu -> Cherax");
         
-        QProgressDialog progress("Converting files...", "Cancel", 0, currentFiles.size(), this);
-        progress.setWindowModality(Qt::WindowModal);
-        progress.setMinimumDuration(0);
+        QJsonObject viaLexis = yimToCherax(lexisToYim(yimToLexis(cheraxToYim(cherax))));
+        expectSame(cherax, viaLexis, "Cherax -> YimMenu -> Lexis -> YimMenu -> Cherax");
+    }
+    
+    // The file-level entry points must agree with the per-format functions.
+    void checkDifferential(const QJsonObject& yim, const QJsonObject& cherax) {
+        QByteArray cheraxBytes = serialize(cherax);
+        QByteArray lexisBytes = serialize(yimToLexis(yim));
+        QByteArray standBytes = yimToStand(yim).toUtf8();
+        QByteArray yimBytes = serialize(yim);
+        
+        expect(detectFormatFromData(cheraxBytes, "a.json") == OutfitFormat::Cherax, "detect Cherax");
+        expect(detectFormatFromData(lexisBytes, "a.json") == OutfitFormat::Lexis, "detect Lexis");
+        if (standBytes.contains("Variation:")) {
+            expect(detectFormatFromData(standBytes, "a.txt") == OutfitFormat::Stand, "detect Stand");
+        }
+        if (!yim.value("components").toObject().isEmpty()) {
+            expect(detectFormatFromData(yimBytes, "a.json") == OutfitFormat::YimMenu, "detect YimMenu");
+        }
         
-        int successCount = 0;
-        int errorCount = 0;
-        QStringList errorFiles;
+        // The fast reader must decode exactly what the DOM path converts to.
+        checkDecoder(cheraxBytes, OutfitFormat::Cherax, outfitDataFromYim(cheraxToYim(cherax)));
+        checkDecoder(lexisBytes, OutfitFormat::Lexis, outfitDataFromYim(lexisToYim(yimToLexis(yim))));
+        if (!yim.value("components").toObject().isEmpty()) {
+            checkDecoder(yimBytes, OutfitFormat::YimMenu, outfitDataFromYim(yim));
+        }
         
-        for (int i = 0; i < currentFiles.size(); ++i) {
-            if (progress.wasCanceled()) break;
-            
-            progress.setValue(i);
-            progress.setLabelText(QString("Converting %1 of %2...\n%3")
-                .arg(i + 1).arg(currentFiles.size())
-                .arg(QFileInfo(currentFiles[i]).fileName()));
-            
-            OutfitFormat fmt = detectFormat(currentFiles[i]);
+        QJsonObject expected = cheraxToYim(cherax);
+        QJsonObject actual = parse(convertDataToYim(cheraxBytes, OutfitFormat::Cherax));
+        expect(expected == actual, "convertDataToYim(Cherax) matches cheraxToYim", expected, actual);
+        
+        expected = lexisToYim(yimToLexis(yim));
+        actual = parse(convertDataToYim(lexisBytes, OutfitFormat::Lexis));
+        expect(expected == actual, "convertDataToYim(Lexis) matches lexisToYim", expected, actual);
+        
+        // Direct writer against the DOM converters.
+        OutfitJsonWriter writer;
+        expected = parse(convertDataToYim(cheraxBytes, OutfitFormat::Cherax));
+        actual = QJsonDocument::fromJson(convertDataToYimUtf8(cheraxBytes, OutfitFormat::Cherax, writer)).object();
+        expect(expected == actual, "direct YimMenu writer matches cheraxToYim", expected, actual);
+        // Byte for byte as well: the GUI export and the CLI must write the same file.
+        expect(convertDataToYimUtf8(cheraxBytes, OutfitFormat::Cherax, writer) ==
+               convertDataToYim(cheraxBytes, OutfitFormat::Cherax).toUtf8(),
+               "direct YimMenu writer writes QJsonDocument's bytes for Cherax");
+        
+        expected = parse(convertDataToYim(lexisBytes, OutfitFormat::Lexis));
+        actual = QJsonDocument::fromJson(convertDataToYimUtf8(lexisBytes, OutfitFormat::Lexis, writer)).object();
+        expect(expected == actual, "direct YimMenu writer matches lexisToYim", expected, actual);
+        expect(convertDataToYimUtf8(lexisBytes, OutfitFormat::Lexis, writer) ==
+               convertDataToYim(lexisBytes, OutfitFormat::Lexis).toUtf8(),
+               "direct YimMenu writer writes QJsonDocument's bytes for Lexis");
+        
+        QByteArray carried = serialize(cheraxToYim(cherax));
+        QByteArray viaLexis = serialize(yimToLexis(QJsonDocument::fromJson(carried).object()));
+        expected = parse(convertDataToYim(viaLexis, OutfitFormat::Lexis));
+        actual = QJsonDocument::fromJson(convertDataToYimUtf8(viaLexis, OutfitFormat::Lexis, writer)).object();
+        expect(expected == actual, "direct YimMenu writer carries foreign extensions", expected, actual);
+        expect(convertDataToYimUtf8(viaLexis, OutfitFormat::Lexis, writer) ==
+               convertDataToYim(viaLexis, OutfitFormat::Lexis).toUtf8(),
+               "direct YimMenu writer writes QJsonDocument's bytes for foreign extensions");
+        
+        expected = parse(standToYim(QString::fromUtf8(standBytes)));
+        actual = parse(convertDataToYim(standBytes, OutfitFormat::Stand));
+        expect(expected == actual, "convertDataToYim(Stand) matches standToYim", expected, actual);
+        
+        // Direct target writers against the DOM converters, extensions included.
+        DecodedOutfit decoded;
+        expect(decodeOutfitJson(yimBytes, decoded, OutfitFormat::YimMenu) && writeCheraxJson(writer, decoded) &&
+               writeLexisJson(writer, decoded), "direct target writers cover plain YimMenu");
+        struct Source {
+            QByteArray bytes;
+            OutfitFormat format;
+            QJsonObject yim;
+        };
+        const Source sources[] = {
+            {yimBytes, OutfitFormat::YimMenu, yim},
+            {cheraxBytes, OutfitFormat::Cherax, cheraxToYim(cherax)},
+            {lexisBytes, OutfitFormat::Lexis, lexisToYim(yimToLexis(yim))}};
+        for (const auto& [bytes, format, source] : sources) {
+            ConversionScratch scratch;
+            QByteArray result;
+            convertOutfitBytes(bytes, format, OutfitFormat::Cherax, scratch, result);
+            expected = yimToCherax(source);
+            actual = QJsonDocument::fromJson(result).object();
+            expect(expected == actual, "convertOutfitBytes to Cherax matches yimToCherax", expected, actual);
+            expect(result == serialize(expected), "convertOutfitBytes to Cherax writes QJsonDocument's bytes");
             
-            if (fmt == OutfitFormat::Unknown) {
-                errorCount++;
-                errorFiles.append(QFileInfo(currentFiles[i]).fileName());
-                continue;
-            }
-            
-            QString yimJson = convertToYim(currentFiles[i], fmt);
-            
-            if (yimJson.isEmpty()) {
-                errorCount++;
-                errorFiles.append(QFileInfo(currentFiles[i]).fileName());
-                continue;
-            }
+            convertOutfitBytes(bytes, format, OutfitFormat::Lexis, scratch, result);
+            expected = yimToLexis(source);
+            actual = QJsonDocument::fromJson(result).object();
+            expect(expected == actual, "convertOutfitBytes to Lexis matches yimToLexis", expected, actual);
+            expect(result == serialize(expected), "convertOutfitBytes to Lexis writes QJsonDocument's bytes");
             
-            if (saveYimFile(yimJson, currentFiles[i], fmt)) {
-                successCount++;
-            } else {
-                errorCount++;
-                errorFiles.append(QFileInfo(currentFiles[i]).fileName());
+            convertOutfitBytes(bytes, format, OutfitFormat::Stand, scratch, result);
+            expect(result == yimToStand(source).toUtf8(), "convertOutfitBytes to Stand matches yimToStand");
+        }
+    }
+    
+    void checkDecoder(const QByteArray& bytes, OutfitFormat format, const OutfitData& expected) {
+        DecodedOutfit decoded;
+        bool ok = decodeOutfitJson(bytes, decoded);
+        expect(ok && decoded.format == format, "fast reader detects the format");
+        expect(ok && decoded.outfit == expected, "fast reader matches the DOM decode");
+    }
+    
+    quint32 seed;
+    QRandomGenerator rng;
+    int caseIndex = 0;
+    int checks = 0;
+    QStringList failures;
+};
+
+// Conversion Benchmark
+// Times the DOM conversion path against the fast reader/writer path over
+// inputs held in memory. Builds configured with OUTFIT_COUNT_ALLOCATIONS
+// also count heap allocations: malloc and its relatives on glibc, which
+// Qt's containers use as well, and operator new elsewhere. A realloc counts
+// only when it has to allocate, not when it grows or shrinks in place.
+#ifdef OUTFIT_COUNT_ALLOCATIONS
+static std::atomic<qint64> heapAllocations{0};
+
+#ifdef __GLIBC__
+extern "C" void* __libc_malloc(std::size_t size);
+extern "C" void* __libc_calloc(std::size_t count, std::size_t size);
+extern "C" void* __libc_realloc(void* p, std::size_t size);
+extern "C" void* __libc_memalign(std::size_t alignment, std::size_t size);
+
+extern "C" void* malloc(std::size_t size) noexcept {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(std::size_t count, std::size_t size) noexcept {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* p, std::size_t size) noexcept {
+    void* result = __libc_realloc(p, size);
+    if (result && result != p) heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return result;
+}
+
+extern "C" void* memalign(std::size_t alignment, std::size_t size) noexcept {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" void* aligned_alloc(std::size_t alignment, std::size_t size) noexcept {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" int posix_memalign(void** result, std::size_t alignment, std::size_t size) noexcept {
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) return EINVAL;
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = __libc_memalign(alignment, size);
+    if (!p) return ENOMEM;
+    *result = p;
+    return 0;
+}
+
+const char* const kHeapCounterName = "malloc";
+#else
+void* operator new(std::size_t size) {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+const char* const kHeapCounterName = "operator new";
+#endif
+
+qint64 heapAllocationCount() { return heapAllocations.load(std::memory_order_relaxed); }
+#else
+const char* const kHeapCounterName = nullptr;
+
+qint64 heapAllocationCount() { return 0; }
+#endif
+
+struct BenchInput {
+    QByteArray data;
+    OutfitFormat format = OutfitFormat::Unknown;
+};
+
+// Runs convert over every input once untimed, so caches, the writer and the
+// arenas reach their steady size, then rounds times for the numbers.
+void runBenchPass(QTextStream& out, const char* name, const QList<BenchInput>& inputs, int rounds,
+                  qint64 inputBytes, const std::function<qint64(const BenchInput&)>& convert,
+                  const std::function<qint64()>& arenaSpills = nullptr) {
+    for (const BenchInput& input : inputs) convert(input);
+    
+    qint64 heapBefore = heapAllocationCount();
+    qint64 spillsBefore = arenaSpills ? arenaSpills() : 0;
+    qint64 outputBytes = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int round = 0; round < rounds; ++round) {
+        for (const BenchInput& input : inputs) {
+            outputBytes += convert(input);
+        }
+    }
+    double seconds = qMax<qint64>(timer.nsecsElapsed(), 1) / 1e9;
+    double files = double(inputs.size()) * rounds;
+    
+    QString line = QString("%1: %2 files/s, %3 MB/s, %4 KB out")
+                       .arg(name, -5)
+                       .arg(files / seconds, 0, 'f', 0)
+                       .arg(inputBytes * rounds / seconds / (1024 * 1024), 0, 'f', 1)
+                       .arg(outputBytes / rounds / 1024);
+    if (kHeapCounterName) {
+        line += QString(", %1 heap allocations/file (%2)")
+                    .arg((heapAllocationCount() - heapBefore) / files, 0, 'f', 2).arg(kHeapCounterName);
+    }
+    if (arenaSpills) {
+        line += QString(", %1 arena spills").arg(arenaSpills() - spillsBefore);
+    }
+    out << line << Qt::endl;
+}
+
+// Command Line Interface
+// Any recognized --command runs headless on a QCoreApplication instead of
+// opening the main window.
+const QStringList kCliCommands = {"--help", "-h", "--query", "--watch", "--convert", "--self-test", "--bench",
+                                   "--validate-library", "--merge-shards",
+#ifdef OUTFIT_SQL_LIBRARY
+                                   "--import-library", "--export-library",
+#endif
+#ifdef OUTFIT_CONVERSION_SERVER
+                                   "--serve", "--server-stats", "--server-convert",
+#endif
+};
+
+bool isCommandLineInvocation(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        // --query=expr names the same command as --query expr.
+        QString arg = QString::fromLocal8Bit(argv[i]);
+        if (kCliCommands.contains(arg.section('=', 0, 0))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int runQueryCommand(const QCommandLineParser& parser, QTextStream& out, QTextStream& err) {
+    OutfitQuery query = OutfitQuery::parse(parser.value("query"));
+    if (!query.error.isEmpty()) {
+        err << "Error: " << query.error << Qt::endl;
+        return 2;
+    }
+    
+#ifdef OUTFIT_SQL_LIBRARY
+    if (parser.isSet("store")) {
+        QElapsedTimer timer;
+        timer.start();
+        
+        if (!QFile::exists(parser.value("store"))) {
+            err << "Error: library database not found: " << parser.value("store") << Qt::endl;
+            return 1;
+        }
+        LibraryStore store;
+        QString error;
+        if (!store.open(parser.value("store"), &error)) {
+            err << "Error: " << error << Qt::endl;
+            return 1;
+        }
+        int limit = parser.isSet("limit") ? parser.value("limit").toInt() : -1;
+        QStringList names = store.find(query, limit);
+        for (const QString& name : names) {
+            out << name << "\n";
+        }
+        out.flush();
+        err << QString("%1 outfits matched in %2 ms").arg(names.size()).arg(timer.elapsed()) << Qt::endl;
+        return 0;
+    }
+#endif
+    
+    QString libraryPath = parser.isSet("library") ? parser.value("library") : defaultLibraryPath();
+    if (!QDir(libraryPath).exists()) {
+        err << "Error: library not found: " << libraryPath << Qt::endl;
+        return 1;
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    
+    OutfitIndex index;
+    QString cachePath = OutfitIndex::cachePathFor(libraryPath);
+    index.load(cachePath);
+    int parsed = index.refreshFromDirectory(libraryPath);
+    if (index.isDirty()) index.save(cachePath);
+    qint64 indexMs = timer.restart();
+    
+    int limit = parser.isSet("limit") ? parser.value("limit").toInt() : -1;
+    QStringList names = index.query(query, limit);
+    qint64 queryMs = timer.elapsed();
+    
+    for (const QString& name : names) {
+        out << name << "\n";
+    }
+    out.flush();
+    
+    err << QString("%1 of %2 outfits matched in %3 ms (index refresh %4 ms, %5 files re-read)")
+               .arg(names.size()).arg(index.size()).arg(queryMs).arg(indexMs).arg(parsed)
+        << Qt::endl;
+    return 0;
+}
+
+#ifdef OUTFIT_SQL_LIBRARY
+// --import-library copies the --library folder into the --store database;
+// --export-library writes the database back out as outfit files.
+int runLibraryStoreCommand(const QCommandLineParser& parser, QTextStream& out, QTextStream& err) {
+    QString libraryPath = parser.isSet("library") ? parser.value("library") : defaultLibraryPath();
+    QString storePath = parser.isSet("store") ? parser.value("store") : LibraryStore::defaultPath();
+    
+    QElapsedTimer timer;
+    timer.start();
+    
+    LibraryStore store;
+    QString error;
+    if (!store.open(storePath, &error)) {
+        err << "Error: " << error << Qt::endl;
+        return 1;
+    }
+    
+    if (parser.isSet("import-library")) {
+        if (!QDir(libraryPath).exists()) {
+            err << "Error: library not found: " << libraryPath << Qt::endl;
+            return 1;
+        }
+        int imported = store.importDirectory(libraryPath, &error);
+        if (imported < 0) {
+            err << "Error: " << error << Qt::endl;
+            return 1;
+        }
+        if (!error.isEmpty()) err << "Warning: " << error << Qt::endl;
+        out << QString("Imported %1 outfits into %2 in %3 ms").arg(imported).arg(storePath).arg(timer.elapsed()) << Qt::endl;
+        return 0;
+    }
+    
+    int exported = store.exportDirectory(libraryPath);
+    if (exported < 0) {
+        err << "Error: could not write every outfit to " << libraryPath << Qt::endl;
+        return 1;
+    }
+    out << QString("Exported %1 outfits to %2 in %3 ms").arg(exported).arg(libraryPath).arg(timer.elapsed()) << Qt::endl;
+    return 0;
+}
+#endif
+
+int runWatchCommand(QCoreApplication& app, const QCommandLineParser& parser, QTextStream& out, QTextStream& err) {
+    ensureOutputDirectories();
+    
+    InboxWatcher watcher;
+    if (parser.isSet("layout")) {
+        QString error;
+        PathTemplate layout = PathTemplate::compile(parser.value("layout"), &error);
+        if (!layout.isValid()) {
+            err << "Error: " << error << Qt::endl;
+            return 2;
+        }
+        watcher.setPathTemplate(layout);
+    }
+    const QStringList folders = parser.values("watch");
+    for (const QString& folder : folders) {
+        if (!watcher.addDirectory(folder)) {
+            err << "Error: cannot watch " << folder << Qt::endl;
+            return 1;
+        }
+        err << "Watching " << QDir(folder).absolutePath() << Qt::endl;
+    }
+    
+    QObject::connect(&watcher, &InboxWatcher::fileConverted, [&out](const QString& inputPath, const QString& outputPath) {
+        out << QTime::currentTime().toString("hh:mm:ss") << " converted " << inputPath << " -> " << outputPath << Qt::endl;
+    });
+    QObject::connect(&watcher, &InboxWatcher::fileFailed, [&err](const QString& inputPath, const QString& reason) {
+        err << QTime::currentTime().toString("hh:mm:ss") << " failed " << inputPath << ": " << reason << Qt::endl;
+    });
+    
+    return app.exec();
+}
+
+void printBatchReport(const BatchReport& report, QTextStream& out, QTextStream& err, qint64 elapsedMs) {
+    for (const QString& name : report.failedFiles) {
+        out << "failed " << name << "\n";
+    }
+    for (const QString& line : report.invalidFiles) {
+        out << "invalid " << line << "\n";
+    }
+    out.flush();
+    
+    err << QString("%1 converted, %2 failed, %3 already done (of %4) in %5 ms")
+               .arg(report.succeeded).arg(report.failed).arg(report.resumed)
+               .arg(report.total).arg(elapsedMs)
+        << Qt::endl;
+}
+
+int runConvertCommand(const QCommandLineParser& parser, QTextStream& out, QTextStream& err) {
+    const QStringList arguments = parser.positionalArguments();
+    if (arguments.isEmpty()) {
+        err << "Error: no input files given" << Qt::endl;
+        return 2;
+    }
+    
+    ensureOutputDirectories();
+    
+    BatchOptions options;
+    options.outputDir = parser.isSet("output") ? parser.value("output") : outputRootPath() + "/YimMenu";
+    options.resume = !parser.isSet("no-resume");
+    if (parser.isSet("layout")) {
+        QString error;
+        if (!PathTemplate::compile(parser.value("layout"), &error).isValid()) {
+            err << "Error: " << error << Qt::endl;
+            return 2;
+        }
+        options.pathTemplate = parser.value("layout");
+    }
+    // Folders are walked lazily, so the job is keyed on the arguments themselves.
+    options.jobId = JobJournal::jobIdFor(arguments);
+    if (parser.isSet("max-memory")) {
+        options.maxMemoryBytes = parser.value("max-memory").toLongLong() * 1024 * 1024;
+        if (options.maxMemoryBytes <= 0) {
+            err << "Error: --max-memory expects a size in MB" << Qt::endl;
+            return 2;
+        }
+    }
+    if (parser.isSet("readers")) options.readerThreads = parser.value("readers").toInt();
+    if (parser.isSet("workers")) options.converterThreads = parser.value("workers").toInt();
+    
+    QString limitsError;
+    SlotLimits slotLimits = SlotLimits::load(SlotLimits::overridePath(), &limitsError);
+    if (!limitsError.isEmpty()) err << "Warning: " << limitsError << Qt::endl;
+    if (parser.isSet("validate") || parser.isSet("strict")) options.slotLimits = &slotLimits;
+    options.rejectInvalid = parser.isSet("strict");
+    
+    ShardSpec shard;
+    if (parser.isSet("shard")) {
+        QString error;
+        shard = ShardSpec::parse(parser.value("shard"), &error);
+        if (!shard.isValid()) {
+            err << "Error: " << error << Qt::endl;
+            return 2;
+        }
+    }
+    QString outputDir = options.outputDir;
+    if (shard.count > 1) applyShard(options, shard, arguments);
+    
+    QElapsedTimer timer;
+    timer.start();
+    
+    InputEnumerator inputs(arguments);
+    BatchReport report = runBatchConversion([&inputs, &shard](QString& path) {
+        while (inputs.next(path)) {
+            if (shard.contains(inputs.relativePath(path))) return true;
+        }
+        return false;
+    }, options,
+        [&err](int index, int, const QString&) {
+            if (index % 1000 == 0 && index > 0) {
+                err << index << " queued" << Qt::endl;
             }
+            return true;
+        });
+    
+    if (shard.count > 1 && !writeShardReport(outputDir, shard, report, timer.elapsed())) {
+        err << "Error: could not write the report of shard " << shard.name() << Qt::endl;
+        return 1;
+    }
+    
+    printBatchReport(report, out, err, timer.elapsed());
+    err << QString("Peak read-ahead: %1 KB").arg(report.peakBufferedBytes / 1024) << Qt::endl;
+    err << "Journal: " << report.journalPath << Qt::endl;
+    return report.failed > 0 ? 1 : 0;
+}
+
+void printMergeReport(const ShardMergeReport& merge, QTextStream& err) {
+    for (const QString& error : merge.errors) {
+        err << "Error: " << error << Qt::endl;
+    }
+    for (const QString& name : merge.pending) {
+        err << "Warning: shard " << name << " has no report yet and was not merged" << Qt::endl;
+    }
+    err << QString("Merged %1 shards: %2 outputs moved, %3 duplicates dropped, %4 renamed")
+               .arg(merge.shards).arg(merge.moved).arg(merge.duplicates).arg(merge.renamed)
+        << Qt::endl;
+}
+
+// --convert --shards N: reruns this binary once per shard with the same
+// arguments plus --shard i/N, waits for all of them and merges the results.
+int runShardedConvertCommand(const QCommandLineParser& parser, QTextStream& out, QTextStream& err) {
+    int count = parser.value("shards").toInt();
+    if (count < 1) {
+        err << "Error: --shards expects a positive count" << Qt::endl;
+        return 2;
+    }
+    
+    QStringList arguments;
+    const QStringList original = QCoreApplication::arguments().mid(1);
+    for (int i = 0; i < original.size(); ++i) {
+        if (original[i] == "--shards") {
+            ++i;
+            continue;
         }
-        
-        progress.setValue(currentFiles.size());
-        
-        QString message = QString("Conversion Complete!\n\n"
-                                 "✓ Successfully converted: %1\n"
-                                 "✗ Failed: %2\n\n"
-                                 "Files saved to:\n%3")
-                        .arg(successCount).arg(errorCount).arg(documentsPath);
-        
-        if (!errorFiles.isEmpty()) {
-            message += "\n\nFailed files:\n" + errorFiles.join("\n");
+        if (original[i].startsWith("--shards=")) continue;
+        arguments.append(original[i]);
+    }
+    // The shards share the cores instead of each taking all of them.
+    if (!parser.isSet("workers")) {
+        arguments << "--workers" << QString::number(qMax(1, QThread::idealThreadCount() / count));
+    }
+    
+    QString outputDir = parser.isSet("output") ? parser.value("output") : outputRootPath() + "/YimMenu";
+    
+    QElapsedTimer timer;
+    timer.start();
+    
+    std::vector<std::unique_ptr<QProcess>> workers;
+    for (int index = 0; index < count; ++index) {
+        auto worker = std::make_unique<QProcess>();
+        worker->setProgram(QCoreApplication::applicationFilePath());
+        worker->setArguments(QStringList(arguments) << "--shard" << QString("%1/%2").arg(index).arg(count));
+        // Failures come back through the shard reports, progress through stderr.
+        worker->setStandardOutputFile(QProcess::nullDevice());
+        worker->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+        worker->start();
+        workers.push_back(std::move(worker));
+    }
+    
+    int failedShards = 0;
+    for (int index = 0; index < count; ++index) {
+        QProcess& worker = *workers[index];
+        bool finished = worker.waitForStarted() && worker.waitForFinished(-1);
+        // Exit code 1 only means some inputs failed; those are in the report.
+        if (!finished || worker.exitStatus() != QProcess::NormalExit || worker.exitCode() > 1) {
+            err << "Error: shard " << ShardSpec{index, count}.name() << " did not finish" << Qt::endl;
+            ++failedShards;
         }
-        
-        QMessageBox::information(this, "Conversion Complete", message);
-        
-        statusLabel->setText(QString("✓ Converted %1 files to YimMenu format").arg(successCount));
-        statusLabel->setStyleSheet("color: #4CAF50; font-size: 13px; padding: 10px;");
     }
     
-    QString convertToYim(const QString& filePath, OutfitFormat fmt) {
-        // Check if manual mode is enabled
-        if (manualSelector->isManualMode()) {
-            QString sourceFormat = manualSelector->getSourceFormat();
-            QString targetFormat = manualSelector->getTargetFormat();
-            
-            // Convert source format string to OutfitFormat enum
-            if (sourceFormat == "Cherax") fmt = OutfitFormat::Cherax;
-            else if (sourceFormat == "YimMenu") fmt = OutfitFormat::YimMenu;
-            else if (sourceFormat == "Lexis") fmt = OutfitFormat::Lexis;
-            else if (sourceFormat == "Stand") fmt = OutfitFormat::Stand;
-        }
-        
-        QFile file(filePath);
+    ShardMergeReport merge = mergeShards(outputDir);
+    printBatchReport(merge.totals, out, err, timer.elapsed());
+    printMergeReport(merge, err);
+    return failedShards > 0 || !merge.errors.isEmpty() ? 2 : (merge.totals.failed > 0 ? 1 : 0);
+}
+
+int runMergeShardsCommand(const QCommandLineParser& parser, QTextStream& out, QTextStream& err) {
+    QString outputDir = parser.isSet("output") ? parser.value("output") : outputRootPath() + "/YimMenu";
+    if (!QDir(shardsRootPath(outputDir)).exists()) {
+        err << "Error: no shards found in " << outputDir << Qt::endl;
+        return 1;
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    ShardMergeReport merge = mergeShards(outputDir);
+    printBatchReport(merge.totals, out, err, timer.elapsed());
+    printMergeReport(merge, err);
+    return !merge.errors.isEmpty() ? 2 : (merge.totals.failed > 0 ? 1 : 0);
+}
+
+#ifdef OUTFIT_CONVERSION_SERVER
+int runServeCommand(QCoreApplication& app, const QCommandLineParser& parser, QTextStream& err) {
+    int threads = parser.isSet("workers") ? parser.value("workers").toInt() : 0;
+    ConversionServer server(threads);
+    QString error;
+    if (!server.listen(parser.value("serve"), &error)) {
+        err << "Error: could not listen on " << parser.value("serve") << ": " << error << Qt::endl;
+        return 1;
+    }
+    
+    err << "Listening on " << server.address() << Qt::endl;
+    return app.exec();
+}
+
+// Blocking client side of the --serve protocol, for the commands below.
+std::unique_ptr<QIODevice> connectToConversionServer(const QString& address) {
+    if (address.startsWith("tcp:")) {
+        auto tcp = std::make_unique<QTcpSocket>();
+        tcp->connectToHost(QHostAddress(QHostAddress::LocalHost), address.mid(4).toUShort());
+        if (!tcp->waitForConnected(5000)) return nullptr;
+        return tcp;
+    }
+    auto local = std::make_unique<QLocalSocket>();
+    local->connectToServer(address);
+    if (!local->waitForConnected(5000)) return nullptr;
+    return local;
+}
+
+// Takes the next whole response off socket into frame; pending keeps bytes
+// that arrived past it. False when the server stops answering.
+bool readServerFrame(QIODevice& socket, QByteArray& pending, QByteArray& frame) {
+    while (pending.size() < 4 ||
+           pending.size() < 4 + qsizetype(qFromLittleEndian<quint32>(pending.constData()))) {
+        if (!socket.waitForReadyRead(5000)) return false;
+        pending.append(socket.readAll());
+    }
+    qsizetype size = 4 + qFromLittleEndian<quint32>(pending.constData());
+    frame = pending.left(size);
+    pending.remove(0, size);
+    return frame.size() >= ConversionServer::kHeaderBytes;
+}
+
+// Asks a running --serve instance for its counters, which also checks that
+// it answers at all.
+int runServerStatsCommand(const QCommandLineParser& parser, QTextStream& out, QTextStream& err) {
+    QString address = parser.value("server-stats");
+    std::unique_ptr<QIODevice> socket = connectToConversionServer(address);
+    if (!socket) {
+        err << "Error: no conversion server at " << address << Qt::endl;
+        return 1;
+    }
+    
+    socket->write(ConversionServer::frame(ConversionServer::Stats, 0, 0, 1, QByteArray()));
+    QByteArray pending;
+    QByteArray response;
+    if (!readServerFrame(*socket, pending, response)) {
+        err << "Error: the conversion server did not answer" << Qt::endl;
+        return 1;
+    }
+    
+    QJsonDocument stats = QJsonDocument::fromJson(response.mid(ConversionServer::kHeaderBytes));
+    out << stats.toJson(QJsonDocument::Indented);
+    out.flush();
+    return 0;
+}
+
+// Sends the given files to a running --serve instance as pipelined convert
+// requests and writes the YimMenu results to --output, so the whole
+// protocol can be exercised (and scripted) from the command line.
+int runServerConvertCommand(const QCommandLineParser& parser, QTextStream& out, QTextStream& err) {
+    const QStringList files = parser.positionalArguments();
+    if (files.isEmpty()) {
+        err << "Error: no input files given" << Qt::endl;
+        return 2;
+    }
+    QString address = parser.value("server-convert");
+    std::unique_ptr<QIODevice> socket = connectToConversionServer(address);
+    if (!socket) {
+        err << "Error: no conversion server at " << address << Qt::endl;
+        return 1;
+    }
+    
+    QString outputDir = parser.isSet("output") ? parser.value("output") : outputRootPath() + "/YimMenu";
+    QDir().mkpath(outputDir);
+    
+    // Ids index into files; unreadable inputs are never sent.
+    int sent = 0;
+    int failed = 0;
+    for (int id = 0; id < files.size(); ++id) {
+        QFile file(files[id]);
         if (!file.open(QIODevice::ReadOnly)) {
-            return QString();
-        }
-        
-        QByteArray data = file.readAll();
-        file.close();
-        
-        QJsonObject yimObj;
-        
-        switch (fmt) {
-            case OutfitFormat::Cherax: {
-                QJsonDocument doc = QJsonDocument::fromJson(data);
-                yimObj = cheraxToYim(doc.object());
-                break;
-            }
-            case OutfitFormat::YimMenu: {
-                return QString::fromUtf8(data);
-            }
-            case OutfitFormat::Lexis: {
-                QJsonDocument doc = QJsonDocument::fromJson(data);
-                yimObj = lexisToYim(doc.object());
-                break;
-            }
-            case OutfitFormat::Stand: {
-                return standToYim(QString::fromUtf8(data));
-            }
-            default:
-                return QString();
+            err << files[id] << ": could not be read" << Qt::endl;
+            failed++;
+            continue;
         }
-        
-        QJsonDocument doc(yimObj);
-        return QString(doc.toJson(QJsonDocument::Indented));
+        socket->write(ConversionServer::frame(ConversionServer::Convert, quint8(OutfitFormat::Unknown),
+                                              quint8(OutfitFormat::YimMenu), quint32(id), file.readAll()));
+        sent++;
     }
     
-    bool saveYimFile(const QString& jsonContent, const QString& originalPath, OutfitFormat sourceFormat) {
-        QFileInfo info(originalPath);
-        QString baseName = info.baseName();
-        
-        QString yimPath = documentsPath + "/OutfitConverter/YimMenu";
-        
-        QDir dir;
-        if (!dir.exists(yimPath)) {
-            dir.mkpath(yimPath);
+    QByteArray pending;
+    QByteArray response;
+    for (int received = 0; received < sent; ++received) {
+        if (!readServerFrame(*socket, pending, response)) {
+            err << "Error: the conversion server did not answer" << Qt::endl;
+            return 1;
         }
-        
-        QString outputFile = yimPath + "/" + baseName + "_converted.json";
-        
-        int counter = 1;
-        while (QFile::exists(outputFile)) {
-            outputFile = yimPath + "/" + baseName + "_converted_" + QString::number(counter) + ".json";
-            counter++;
+        quint32 id = qFromLittleEndian<quint32>(response.constData() + 8);
+        quint8 status = quint8(response[5]);
+        if (id >= quint32(files.size())) {
+            err << "Error: the conversion server answered an unknown request" << Qt::endl;
+            return 1;
         }
         
-        QFile file(outputFile);
-        if (!file.open(QIODevice::WriteOnly)) {return false;
+        const QString& input = files[int(id)];
+        QString outputPath = outputDir + "/" + QFileInfo(input).completeBaseName() + ".json";
+        if (status != ConversionServer::Ok) {
+            err << input << ": " << (status == ConversionServer::Unrecognized ? "unrecognized format" : "conversion failed")
+                << Qt::endl;
+            failed++;
+        } else if (!OutputWriter::instance().write(outputPath, response.mid(ConversionServer::kHeaderBytes))) {
+            err << input << ": could not write " << outputPath << Qt::endl;
+            failed++;
+        } else {
+            out << input << " -> " << outputPath << "\n";
         }
-        
-        file.write(jsonContent.toUtf8());
-        file.close();
-        
-        return true;
     }
+    out.flush();
     
-    void setupOutputDirectories() {
-        documentsPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
-        
-        QDir dir;
-        QStringList folders = {"Cherax", "YimMenu", "Lexis", "Stand"};
-        
-        for (const QString& folder : folders) {
-            QString path = documentsPath + "/OutfitConverter/" + folder;
-            if (!dir.exists(path)) {
-                dir.mkpath(path);
-            }
-        }
+    err << QString("Converted %1 of %2 files").arg(files.size() - failed).arg(files.size()) << Qt::endl;
+    return failed > 0 ? 1 : 0;
+}
+#endif
+
+int runValidateCommand(const QCommandLineParser& parser, QTextStream& out, QTextStream& err) {
+    QString libraryPath = parser.isSet("library") ? parser.value("library") : defaultLibraryPath();
+    if (!QDir(libraryPath).exists()) {
+        err << "Error: library not found: " << libraryPath << Qt::endl;
+        return 1;
     }
     
-    QString getFormatName(OutfitFormat fmt) {
-        switch (fmt) {
-            case OutfitFormat::Cherax: return "Cherax";
-            case OutfitFormat::YimMenu: return "YimMenu";
-            case OutfitFormat::Lexis: return "Lexis";
-            case OutfitFormat::Stand: return "Stand";
-            default: return "Unknown";
-        }
+    QString limitsError;
+    SlotLimits slotLimits = SlotLimits::load(SlotLimits::overridePath(), &limitsError);
+    if (!limitsError.isEmpty()) err << "Warning: " << limitsError << Qt::endl;
+    
+    QElapsedTimer timer;
+    timer.start();
+    const QVector<LibraryValidation> invalid = validateLibrary(libraryPath, slotLimits);
+    for (const LibraryValidation& result : invalid) {
+        out << result.name << ": " << (result.unreadable ? QString("could not be read") : describeIssues(result.issues)) << "\n";
     }
+    out.flush();
     
-    QString getFormatIcon(OutfitFormat fmt) {
-        switch (fmt) {
-            case OutfitFormat::Cherax: return "🔷";
-            case OutfitFormat::YimMenu: return "🟣";
-            case OutfitFormat::Lexis: return "🔶";
-            case OutfitFormat::Stand: return "📝";
-            default: return "❓";
-        }
+    err << QString("%1 invalid outfits in %2 ms").arg(invalid.size()).arg(timer.elapsed()) << Qt::endl;
+    return invalid.isEmpty() ? 0 : 1;
+}
+
+int runSelfTestCommand(const QCommandLineParser& parser, QTextStream& err) {
+    int iterations = parser.isSet("iterations") ? parser.value("iterations").toInt() : 1000;
+    quint32 seed = parser.isSet("seed") ? parser.value("seed").toUInt()
+                                        : QRandomGenerator::global()->generate();
+    
+    ConverterSelfTest selfTest(seed);
+    return selfTest.run(iterations, err) > 0 ? 1 : 0;
+}
+
+int runBenchCommand(const QCommandLineParser& parser, QTextStream& out, QTextStream& err) {
+    const QStringList arguments = parser.positionalArguments();
+    if (arguments.isEmpty()) {
+        err << "Error: no input files given" << Qt::endl;
+        return 2;
     }
     
-    QString getFormatColor(OutfitFormat fmt) {
-        switch (fmt) {
-            case OutfitFormat::Cherax: return "#667eea";
-            case OutfitFormat::YimMenu: return "#764ba2";
-            case OutfitFormat::Lexis: return "#f093fb";
-            case OutfitFormat::Stand: return "#4facfe";
-            default: return "#ff6b6b";
-        }
+    int rounds = parser.isSet("rounds") ? parser.value("rounds").toInt() : 10;
+    if (rounds <= 0) {
+        err << "Error: --rounds expects a positive count" << Qt::endl;
+        return 2;
     }
     
-    QPushButton* createStyledButton(const QString& text, const QString& color) {
-        QPushButton* btn = new QPushButton(text, this);
-        btn->setMinimumHeight(50);
-        btn->setCursor(Qt::PointingHandCursor);
-        btn->setStyleSheet(QString(
-            "QPushButton {"
-            "  background: %1;"
-            "  color: white;"
-            "  border: none;"
-            "  border-radius: 8px;"
-            "  font-size: 15px;"
-            "  font-weight: bold;"
-            "  padding: 15px;"
-            "}"
-            "QPushButton:hover {"
-            "  background: qlineargradient(x1:0, y1:0, x2:1, y2:0, stop:0 %1, stop:1 %2);"
-            "}"
-            "QPushButton:pressed {"
-            "  background: #555;"
-            "}"
-            "QPushButton:disabled {"
-            "  background: #333;"
-            "  color: #666;"
-            "}"
-        ).arg(color).arg(color));
-        
-        return btn;
+    QList<BenchInput> inputs;
+    qint64 inputBytes = 0;
+    InputEnumerator enumerator(arguments);
+    QString path;
+    while (enumerator.next(path)) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) continue;
+        BenchInput input;
+        input.data = file.readAll();
+        input.format = detectFormatFromData(input.data, path);
+        if (input.format == OutfitFormat::Unknown) continue;
+        inputBytes += input.data.size();
+        inputs.append(input);
+    }
+    if (inputs.isEmpty()) {
+        err << "Error: no convertible outfits found" << Qt::endl;
+        return 1;
     }
     
-    void setupUI() {
-        QVBoxLayout* mainLayout = new QVBoxLayout(this);
-        mainLayout->setSpacing(20);
-        mainLayout->setContentsMargins(30, 30, 30, 30);
-        
-        dropZone = new DropZone(this);
-        connect(dropZone, &DropZone::filesDropped, this, &ConverterTab::handleFilesLoad);
-        mainLayout->addWidget(dropZone);
-        
-        QGroupBox* detectionBox = new QGroupBox("Auto-Detection", this);
-        detectionBox->setStyleSheet(
-            "QGroupBox { background: #2a2a2a; border: 2px solid #444; border-radius: 12px; "
-            "margin-top: 10px; padding-top: 20px; color: #fff; font-size: 14px; font-weight: bold; }"
-            "QGroupBox::title { subcontrol-origin: margin; left: 15px; padding: 0 5px; }"
-        );
-        
-        QVBoxLayout* detectionLayout = new QVBoxLayout(detectionBox);
-        detectedFormatLabel = new QLabel("No files loaded", this);
-        detectedFormatLabel->setAlignment(Qt::AlignCenter);
-        detectedFormatLabel->setStyleSheet("color: #888; font-size: 13px; font-weight: normal; padding: 5px;");
-        detectionLayout->addWidget(detectedFormatLabel);
-        mainLayout->addWidget(detectionBox);
-        
-        // Add manual format selector
-        manualSelector = new ManualFormatSelector(this);
-        connect(manualSelector, &ManualFormatSelector::modeChanged, this, &ConverterTab::onManualModeChanged);
-        mainLayout->addWidget(manualSelector);
-        
-        QGroupBox* modeBox = new QGroupBox("Conversion Mode", this);
-        modeBox->setStyleSheet(
-            "QGroupBox { background: #2a2a2a; border: 2px solid #444; border-radius: 12px; "
-            "margin-top: 10px; padding-top: 20px; color: #fff; font-size: 14px; font-weight: bold; }"
-            "QGroupBox::title { subcontrol-origin: margin; left: 15px; padding: 0 5px; }"
-            "QRadioButton { color: #fff; font-size: 13px; font-weight: normal; spacing: 8px; }"
-            "QRadioButton::indicator { width: 18px; height: 18px; }"
-            "QRadioButton::indicator::unchecked { border: 2px solid #666; border-radius: 9px; background: #1a1a1a; }"
-            "QRadioButton::indicator::checked { border: 2px solid #667eea; border-radius: 9px; background: qradialgradient(cx:0.5, cy:0.5, radius:0.5, fx:0.5, fy:0.5, stop:0 #667eea, stop:1 #667eea); }"
-        );
-        
-        QVBoxLayout* modeLayout = new QVBoxLayout(modeBox);
-        singleModeRadio = new QRadioButton("Single File Mode - Convert one file at a time", this);
-        batchModeRadio = new QRadioButton("Batch Mode - Convert multiple files at once", this);
-        
-        singleModeRadio->setChecked(true);
-        
-        buttonGroup = new QButtonGroup(this);
-        buttonGroup->addButton(singleModeRadio);
-        buttonGroup->addButton(batchModeRadio);
-        
-        connect(singleModeRadio, &QRadioButton::toggled, this, &ConverterTab::updateMode);
-        
-        modeLayout->addWidget(singleModeRadio);
-        modeLayout->addWidget(batchModeRadio);
-        mainLayout->addWidget(modeBox);
-        
-        convertBtn = createStyledButton("🔄 Convert to YimMenu", "#667eea");
-        connect(convertBtn, &QPushButton::clicked, this, &ConverterTab::performConversion);
-        convertBtn->setEnabled(false);
-        mainLayout->addWidget(convertBtn);
-        
-        statusLabel = new QLabel("Load file(s) to begin", this);
-        statusLabel->setAlignment(Qt::AlignCenter);
-        statusLabel->setStyleSheet("color: #888; font-size: 13px; padding: 10px;");
-        mainLayout->addWidget(statusLabel);
+    out << QString("%1 outfits, %2 KB, %3 rounds").arg(inputs.size()).arg(inputBytes / 1024).arg(rounds) << Qt::endl;
+    if (!kHeapCounterName) {
+        out << "Heap allocations not counted; configure with -DOUTFIT_COUNT_ALLOCATIONS=ON to count them." << Qt::endl;
     }
     
-private:
-    DropZone* dropZone;
-    QPushButton* convertBtn;
-    QLabel* statusLabel;
-    QLabel* detectedFormatLabel;
-    QRadioButton* singleModeRadio;
-    QRadioButton* batchModeRadio;
-    QButtonGroup* buttonGroup;
-    QStringList currentFiles;
-    QString documentsPath;
-    ManualFormatSelector* manualSelector;
-};
+    runBenchPass(out, "dom", inputs, rounds, inputBytes, [](const BenchInput& input) {
+        return qint64(convertDataToYim(input.data, input.format).toUtf8().size());
+    });
+    
+    OutfitJsonWriter writer;
+    ConversionArena arena;
+    runBenchPass(out, "fast", inputs, rounds, inputBytes, [&writer, &arena](const BenchInput& input) {
+        arena.reset();
+        return qint64(convertDataToYimUtf8(input.data, input.format, writer, arena.resource()).size());
+    }, [&arena]() { return arena.spills(); });
+    return 0;
+}
 
-class MainWindow : public QMainWindow {
-    Q_OBJECT
-public:
-    MainWindow(QWidget* parent = nullptr) : QMainWindow(parent) {
-        setWindowTitle("Outfit Converter Pro - Multi-Format Support");
-        setMinimumSize(1100, 900);
-        
-        QWidget* central = new QWidget(this);
-        setCentralWidget(central);
-        
-        QVBoxLayout* mainLayout = new QVBoxLayout(central);
-        mainLayout->setSpacing(10);
-        mainLayout->setContentsMargins(20, 20, 20, 20);
-        
-        QLabel* title = new QLabel("Outfit Converter Pro", this);
-        title->setAlignment(Qt::AlignCenter);
-        title->setStyleSheet("font-size: 28px; font-weight: bold; color: #fff; margin-bottom: 5px;");
-        mainLayout->addWidget(title);
-        
-        QLabel* subtitle = new QLabel("Convert, Edit & Manage - Cherax, YimMenu, Lexis & Stand", this);
-        subtitle->setAlignment(Qt::AlignCenter);
-        subtitle->setStyleSheet("font-size: 14px; color: #aaa; margin-bottom: 5px;");
-        mainLayout->addWidget(subtitle);
-        
-        QLabel* credits = new QLabel("Enhanced by @sizrox", this);
-        credits->setAlignment(Qt::AlignCenter);
-        credits->setStyleSheet("font-size: 11px; color: #667eea; margin-bottom: 15px; font-style: italic;");
-        mainLayout->addWidget(credits);
-        
-        QTabWidget* tabWidget = new QTabWidget(this);
-        tabWidget->setStyleSheet(
-            "QTabWidget::pane { border: 2px solid #444; border-radius: 8px; background: #1a1a1a; }"
-            "QTabBar::tab { background: #2a2a2a; color: #aaa; padding: 12px 24px; border: 2px solid #444; "
-            "border-bottom:none; margin-right: 2px; border-top-left-radius: 8px; border-top-right-radius: 8px; }"
-            "QTabBar::tab:selected { background: #667eea; color: white; font-weight: bold; }"
-            "QTabBar::tab:hover { background: #3a3a3a; }"
-        );
-        
-        tabWidget->addTab(new ConverterTab(this), "🔄 Converter");
-        tabWidget->addTab(new OutfitEditorTab(this), "✏️ Outfit Editor");
-        tabWidget->addTab(new VehicleConverterTab(this), "🚗 Vehicle Converter");
-        
-        mainLayout->addWidget(tabWidget);
-        
-        setStyleSheet("QMainWindow { background: qlineargradient(x1:0, y1:0, x2:0, y2:1, stop:0 #1a1a1a, stop:1 #0d0d0d); }");
+#ifdef _WIN32
+// The GUI build has no console of its own; reuse the caller's for the
+// streams it did not redirect. A stream the caller sent to a file or pipe
+// (> hits.txt, or ctest capturing output) keeps its handle.
+void attachParentConsole(bool withStdout) {
+    auto unset = [](DWORD which) {
+        HANDLE handle = GetStdHandle(which);
+        return handle == nullptr || handle == INVALID_HANDLE_VALUE;
+    };
+    bool reopenStdout = withStdout && unset(STD_OUTPUT_HANDLE);
+    bool reopenStderr = unset(STD_ERROR_HANDLE);
+    if ((!reopenStdout && !reopenStderr) || !AttachConsole(ATTACH_PARENT_PROCESS)) return;
+    if (reopenStdout) freopen("CONOUT$", "w", stdout);
+    if (reopenStderr) freopen("CONOUT$", "w", stderr);
+}
+#endif
+
+int runCommandLine(QCoreApplication& app) {
+#ifdef _WIN32
+    attachParentConsole(true);
+#endif
+    
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Outfit Converter Pro - command line mode");
+    parser.addHelpOption();
+    parser.addOption(QCommandLineOption("query",
+        "Search the outfit library, e.g. \"top=178/3 hat=* model=female\".", "expression"));
+    parser.addOption(QCommandLineOption("library",
+        "YimMenu outfit library directory (default: Documents/OutfitConverter/YimMenu).", "dir"));
+    parser.addOption(QCommandLineOption("limit", "Maximum number of results to print.", "count"));
+    parser.addOption(QCommandLineOption("watch",
+        "Watch a folder and convert new or changed outfits to YimMenu (repeatable).", "dir"));
+    parser.addOption(QCommandLineOption("convert",
+        "Convert the given files or folders to YimMenu, resuming an earlier run of the same batch."));
+    parser.addOption(QCommandLineOption("output",
+        "Output directory for --convert (default: Documents/OutfitConverter/YimMenu).", "dir"));
+    parser.addOption(QCommandLineOption("layout",
+        "Output path template for --convert and --watch, e.g. \"{model}/{name}.json\" "
+        "(variables: {name} {src_dir} {format} {target} {ext} {model} {hash} {shard}).", "template"));
+    parser.addOption(QCommandLineOption("no-resume",
+        "Ignore the journal of an earlier run and convert everything again."));
+    parser.addOption(QCommandLineOption("max-memory",
+        "Memory budget for --convert buffers in MB (default 128).", "mb"));
+    parser.addOption(QCommandLineOption("readers", "Reader threads for --convert (default 2).", "count"));
+    parser.addOption(QCommandLineOption("validate",
+        "Check converted outfits against the game's slot limits and list the ones outside them."));
+    parser.addOption(QCommandLineOption("strict", "Like --validate, but do not write outfits outside the limits."));
+    parser.addOption(QCommandLineOption("validate-library",
+        "Check every outfit in the --library folder against the game's slot limits."));
+    parser.addOption(QCommandLineOption("workers",
+        "Converter threads for --convert (default: one per core).", "count"));
+    parser.addOption(QCommandLineOption("shards",
+        "Split --convert across this many worker processes and merge their outputs.", "count"));
+    parser.addOption(QCommandLineOption("shard",
+        "Convert only shard i of N (0-based, e.g. 2/4) into the --output staging area, "
+        "for spreading one batch over several machines.", "i/N"));
+    parser.addOption(QCommandLineOption("merge-shards",
+        "Move the finished shards' outputs into --output, dropping duplicates, and sum their reports."));
+    parser.addPositionalArgument("files", "Input files or folders for --convert and --bench.", "[files...]");
+    parser.addOption(QCommandLineOption("self-test",
+        "Run randomized round-trip and differential checks over every converter."));
+    parser.addOption(QCommandLineOption("iterations", "Random outfits for --self-test (default 1000).", "count"));
+    parser.addOption(QCommandLineOption("seed", "Seed for --self-test, to replay a failure.", "seed"));
+    parser.addOption(QCommandLineOption("bench",
+        "Time the DOM and fast conversion paths over the given files or folders without writing."));
+    parser.addOption(QCommandLineOption("rounds", "Passes over the inputs for --bench (default 10).", "count"));
+#ifdef OUTFIT_SQL_LIBRARY
+    parser.addOption(QCommandLineOption("store",
+        "Library database for --query, --import-library and --export-library "
+        "(default: Documents/OutfitConverter/library.sqlite).", "file"));
+    parser.addOption(QCommandLineOption("import-library", "Copy the --library folder into the --store database."));
+    parser.addOption(QCommandLineOption("export-library", "Write the --store database out to the --library folder."));
+#endif
+#ifdef OUTFIT_CONVERSION_SERVER
+    parser.addOption(QCommandLineOption("serve",
+        "Run a conversion server on a local socket name, or on \"tcp:<port>\" on localhost; "
+        "--workers sets its threads.", "address"));
+    parser.addOption(QCommandLineOption("server-stats", "Print the counters of a running --serve instance.", "address"));
+    parser.addOption(QCommandLineOption("server-convert",
+        "Convert the given files to YimMenu through a running --serve instance, into --output.", "address"));
+#endif
+    parser.addOption(QCommandLineOption("durable",
+        "fsync every output (and batch the directory fsyncs) before reporting success."));
+    parser.process(app);
+    
+    OutputWriter::instance().setDurable(parser.isSet("durable"));
+    
+    if (parser.isSet("query")) {
+        return runQueryCommand(parser, out, err);
     }
-};
+    
+#ifdef OUTFIT_SQL_LIBRARY
+    if (parser.isSet("import-library") || parser.isSet("export-library")) {
+        return runLibraryStoreCommand(parser, out, err);
+    }
+#endif
+    
+    if (parser.isSet("watch")) {
+        return runWatchCommand(app, parser, out, err);
+    }
+    
+#ifdef OUTFIT_CONVERSION_SERVER
+    if (parser.isSet("serve")) {
+        return runServeCommand(app, parser, err);
+    }
+    
+    if (parser.isSet("server-stats")) {
+        return runServerStatsCommand(parser, out, err);
+    }
+    
+    if (parser.isSet("server-convert")) {
+        return runServerConvertCommand(parser, out, err);
+    }
+#endif
+    
+    if (parser.isSet("convert") && parser.isSet("shards")) {
+        return runShardedConvertCommand(parser, out, err);
+    }
+    
+    if (parser.isSet("convert")) {
+        return runConvertCommand(parser, out, err);
+    }
+    
+    if (parser.isSet("merge-shards")) {
+        return runMergeShardsCommand(parser, out, err);
+    }
+    
+    if (parser.isSet("validate-library")) {
+        return runValidateCommand(parser, out, err);
+    }
+    
+    if (parser.isSet("self-test")) {
+        return runSelfTestCommand(parser, err);
+    }
+    
+    if (parser.isSet("bench")) {
+        return runBenchCommand(parser, out, err);
+    }
+    
+    out << parser.helpText();
+    return 0;
+}
 
 int main(int argc, char* argv[]) {
+    if (isCommandLineInvocation(argc, argv)) {
+        QCoreApplication app(argc, argv);
+        app.setApplicationName("Outfit Converter Pro");
+        app.setApplicationVersion("3.0");
+        app.setOrganizationName("sizrox");
+        return runCommandLine(app);
+    }
+    
+    StartupTrace& trace = StartupTrace::instance();
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--trace-startup") == 0) trace.enable();
+    }
+    if (qEnvironmentVariableIntValue("OUTFIT_TRACE_STARTUP") > 0) trace.enable();
+#ifdef _WIN32
+    if (trace.isEnabled()) attachParentConsole(false);
+#endif
+    trace.mark("main");
+    
     QApplication app(argc, argv);
     
     app.setApplicationName("Outfit Converter Pro");
     app.setApplicationVersion("3.0");
     app.setOrganizationName("sizrox");
+    app.setStyleSheet(kAppStyleSheet);
+    trace.mark("application created");
     
     MainWindow window;
+    trace.mark("main window constructed");
     window.show();
+    trace.mark("main window shown");
+    QTimer::singleShot(0, &window, [&trace]() { trace.mark("event loop running (interactive)"); });
     
     return app.exec();
 }
 
 #include "main.moc"
+#endif
@@ -0,0 +1,81 @@
+// Outfit Converter Pro - C API
+// Buffer-to-buffer access to the outfit converters for other programs, built
+// as the OutfitConverterCore shared library (cmake -DOUTFIT_CORE_LIBRARY=ON).
+// The library needs QtCore only: no QApplication, and no initialization call.
+// Every function is safe to call from several threads at once.
+// examples/convert_outfit.c is a minimal C program using it.
+#ifndef OUTFIT_CONVERTER_H
+#define OUTFIT_CONVERTER_H
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#if defined(OUTFIT_CORE_LIBRARY)
+#define OUTFIT_API __declspec(dllexport)
+#else
+#define OUTFIT_API __declspec(dllimport)
+#endif
+#else
+#define OUTFIT_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bumped whenever a declaration below changes incompatibly.
+#define OUTFIT_API_VERSION 1
+
+// Values are fixed; new formats are only ever appended.
+typedef enum outfit_format {
+    OUTFIT_FORMAT_UNKNOWN = 0,
+    OUTFIT_FORMAT_CHERAX = 1,
+    OUTFIT_FORMAT_YIMMENU = 2,
+    OUTFIT_FORMAT_LEXIS = 3,
+    OUTFIT_FORMAT_STAND = 4
+} outfit_format;
+
+typedef enum outfit_status {
+    OUTFIT_OK = 0,
+    OUTFIT_ERROR_ARGUMENT = 1,          // null pointer or invalid format value
+    OUTFIT_ERROR_UNRECOGNIZED = 2,      // input is not an outfit in any known format
+    OUTFIT_ERROR_CONVERSION = 3,        // input could not be converted to the target
+    OUTFIT_ERROR_BUFFER_TOO_SMALL = 4   // *output_size holds the size needed
+} outfit_status;
+
+// OUTFIT_API_VERSION of the library actually loaded.
+OUTFIT_API int outfit_api_version(void);
+
+// Format of an outfit held in memory, or OUTFIT_FORMAT_UNKNOWN.
+OUTFIT_API outfit_format outfit_detect_format(const char* data, size_t size);
+
+// Converts input (UTF-8, from = OUTFIT_FORMAT_UNKNOWN to detect) to the
+// target format in the caller's output buffer. *output_size receives the
+// converted size, also on OUTFIT_ERROR_BUFFER_TOO_SMALL, so output may be
+// null with capacity 0 to ask for the size first. Output is not terminated.
+// Input already in the target format is checked and copied unchanged.
+OUTFIT_API outfit_status outfit_convert(const char* input, size_t input_size, outfit_format from,
+                                        outfit_format to, char* output, size_t output_capacity,
+                                        size_t* output_size);
+
+// One entry of outfit_convert_batch(): the caller fills the first five
+// fields, the library the last two.
+typedef struct outfit_batch_item {
+    const char* input;
+    size_t input_size;
+    outfit_format from;
+    char* output;
+    size_t output_capacity;
+    size_t output_size;
+    outfit_status status;
+} outfit_batch_item;
+
+// Converts every item to the target format on up to threads threads
+// (0 = one per core). Returns how many items converted with OUTFIT_OK.
+OUTFIT_API size_t outfit_convert_batch(outfit_batch_item* items, size_t count, outfit_format to, int threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OUTFIT_CONVERTER_H